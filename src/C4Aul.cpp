@@ -188,6 +188,7 @@ void C4AulScript::Default()
 	IncludesResolved = false;
 
 	// defaults
+	Def = nullptr;
 	idDef = C4ID_None;
 	Strict = C4AulScriptStrict::NONSTRICT;
 	Preparsing = Resolving = false;
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <C4AulBytecodeCache.h>
 #include <C4AulScriptStrict.h>
 #include <C4ValueList.h>
 #include <C4ValueMap.h>
@@ -31,6 +32,7 @@
 #include <C4Script.h>
 #include <C4StringTable.h>
 
+#include <chrono>
 #include <cstdint>
 #include <list>
 #include <vector>
@@ -268,7 +270,7 @@ struct C4AulScriptContext : public C4AulContext
 	bool TemporaryScript;
 	C4ValueList NumVars;
 	C4AulBCC *CPos;
-	time_t tTime; // initialized only by profiler if active
+	std::chrono::steady_clock::time_point tTime; // initialized only by profiler if active
 
 	size_t ParCnt() const { return Vars - Pars; }
 	void dump(std::string Dump = "");
@@ -281,6 +283,7 @@ class C4AulFunc
 	friend class C4AulScriptEngine;
 	friend class C4AulFuncMap;
 	friend class C4AulParseState;
+	friend class C4AulBytecodeCache;
 
 public:
 	C4AulFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true);
@@ -347,7 +350,7 @@ public:
 
 	C4AulScriptFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true) : C4AulFunc(pOwner, pName, bAtEnd),
 		idImage(C4ID_None), iImagePhase(0), Condition(nullptr), ControlMethod(C4AUL_ControlMethod_All), OwnerOverloaded(nullptr),
-		bReturnRef(false), tProfileTime(0)
+		bReturnRef(false), tProfileTime(0), ProfilerLabel(0), ProfilerRun(0)
 	{
 		for (int i = 0; i < C4AUL_MAX_Par; i++) ParType[i] = C4V_Any;
 	}
@@ -364,7 +367,8 @@ public:
 
 	std::string GetFullName(); // get a fully classified name (C4ID::Name) for debug output
 
-	time_t tProfileTime; // internally set by profiler
+	std::chrono::steady_clock::duration tProfileTime; // internally set by profiler
+	std::uint32_t ProfilerLabel, ProfilerRun; // internally set by call profiler
 
 	bool HasStrictNil() const noexcept;
 
@@ -411,7 +415,7 @@ private:
 	struct Entry
 	{
 		C4AulScriptFunc *pFunc;
-		time_t tProfileTime;
+		std::chrono::steady_clock::duration tProfileTime;
 
 		bool operator<(const Entry &e2) const { return tProfileTime < e2.tProfileTime; }
 	};
@@ -423,7 +427,7 @@ private:
 public:
 	C4AulProfiler(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)} {}
 
-	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime);
+	void CollectEntry(C4AulScriptFunc *pFunc, std::chrono::steady_clock::duration tProfileTime);
 	void Show();
 
 	static void Abort();
@@ -483,7 +487,7 @@ protected:
 	bool IncludesResolved;
 	void AppendTo(C4AulScript &Scr, bool bHighPrio); // append to given script
 	void UnLink(); // reset to unlinked state
-	virtual void AfterLink(); // called after linking is completed; presearch common funcs here & search same-named funcs
+	virtual void AfterLink(); // called after linking is completed; presearch common funcs here
 	virtual bool ReloadScript(const char *szPath); // reload given script
 
 	C4AulScript *FindFirstNonStrictScript(); // find first script that is not #strict
@@ -524,6 +528,7 @@ public:
 	friend class C4AulScriptFunc;
 	friend class C4AulScriptEngine;
 	friend class C4AulParseState;
+	friend class C4AulBytecodeCache;
 };
 
 // holds all C4AulScripts
@@ -543,6 +548,8 @@ public:
 
 	C4StringTable Strings;
 
+	C4AulBytecodeCache BytecodeCache; // byte code of scripts parsed earlier
+
 	// global constants (such as "static const C4D_Structure = 2;")
 	// cannot share var lists, because it's so closely tied to the data lists
 	// constants are used by the Parser only, anyway, so it's not
@@ -581,6 +588,7 @@ public:
 
 	bool DenumerateVariablePointers();
 	void UnLink(); // called when a script is being reloaded (clears string table)
+	void LinkSameNameFuncs(); // build the rings of same-named funcs in the whole script tree
 	// Compile scenario script data (without strings and constants)
 	void CompileFunc(StdCompiler *pComp);
 
@@ -0,0 +1,467 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* On-disk cache for the byte code of parsed scripts */
+
+#include <C4Include.h>
+#include <C4AulBytecodeCache.h>
+
+#include <C4Aul.h>
+#include <C4Config.h>
+#include <C4Def.h>
+#include <C4Version.h>
+
+#include <StdCompiler.h>
+#include <StdFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <format>
+
+void C4AulBytecodeCache::Chunk::CompileFunc(StdCompiler *const pComp)
+{
+	pComp->Value(mkIntPackAdapt(Type)); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(X); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkIntPackAdapt(SPos));
+}
+
+void C4AulBytecodeCache::FuncRef::CompileFunc(StdCompiler *const pComp)
+{
+	pComp->Value(mkIntPackAdapt(Script)); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkIntPackAdapt(Func));
+}
+
+void C4AulBytecodeCache::StringRef::CompileFunc(StdCompiler *const pComp)
+{
+	pComp->Value(Data); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(Hold);
+}
+
+void C4AulBytecodeCache::Function::CompileFunc(StdCompiler *const pComp)
+{
+	pComp->Value(Name); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkIntPackAdapt(CodePos)); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkSTLContainerAdapt(VarNames));
+}
+
+void C4AulBytecodeCache::Entry::CompileFunc(StdCompiler *const pComp)
+{
+	pComp->Value(Version); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkArrayAdaptS(Hash.data(), Hash.size())); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkSTLContainerAdapt(Functions)); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkSTLContainerAdapt(Code)); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkSTLContainerAdapt(FuncRefs)); pComp->Separator(StdCompiler::SEP_SEP);
+	pComp->Value(mkSTLContainerAdapt(Strings));
+}
+
+namespace
+{
+	class Hasher
+	{
+		StdSha1 sha1;
+
+	public:
+		void Value(const int64_t iValue) { sha1.Update(&iValue, sizeof(iValue)); }
+		void String(const char *const szString, const size_t iLength)
+		{
+			Value(static_cast<int64_t>(iLength));
+			sha1.Update(szString, iLength);
+		}
+		void String(const char *const szString) { String(szString, std::strlen(szString)); }
+		void Names(const C4ValueMapNames &rNames)
+		{
+			Value(rNames.iSize);
+			for (int32_t i = 0; i < rNames.iSize; ++i) String(rNames.pNames[i]);
+		}
+		void GetHash(C4AulBytecodeCache::Key &rKey) { sha1.GetHash(rKey.data()); }
+	};
+}
+
+void C4AulBytecodeCache::Begin(C4AulScriptEngine &rEngine)
+{
+	End();
+	if (!Config.Developer.ScriptBytecodeCache) return;
+	// number all scripts and functions in tree order
+	for (C4AulScript *pPos = &rEngine; pPos; )
+	{
+		const auto iScript = static_cast<int32_t>(Scripts.size());
+		ScriptIndices.emplace(pPos, iScript);
+		Scripts.push_back(pPos);
+		std::vector<C4AulFunc *> &funcs{ScriptFuncs.emplace_back()};
+		for (C4AulFunc *f = pPos->Func0; f; f = f->Next)
+		{
+			FuncIndices.emplace(f, FuncRef{iScript, static_cast<int32_t>(funcs.size())});
+			funcs.push_back(f);
+		}
+		// has children? go down in hierarchy
+		if (pPos->Child0)
+			pPos = pPos->Child0;
+		else
+		{
+			// last child? go up in hierarchy
+			while (!pPos->Next && pPos->Owner)
+				pPos = pPos->Owner;
+			// next node
+			pPos = pPos->Next;
+		}
+	}
+	// hash everything the parser may look up in other scripts
+	Hasher hash;
+	hash.Value(FormatVersion);
+	hash.Value(C4XVER1); hash.Value(C4XVER2); hash.Value(C4XVER3); hash.Value(C4XVER4); hash.Value(C4XVERBUILD);
+	hash.String(C4VERSIONEXTRA);
+	hash.Value(sizeof(std::intptr_t));
+	const auto hashFunc = [this, &hash](const C4AulFunc *const pFunc)
+	{
+		const auto it = FuncIndices.find(pFunc);
+		hash.Value(it != FuncIndices.end() ? it->second.Script : -1);
+		hash.Value(it != FuncIndices.end() ? it->second.Func : -1);
+	};
+	for (size_t i = 0; i < Scripts.size(); ++i)
+	{
+		C4AulScript *const pScript{Scripts[i]};
+		hash.Value(pScript->Def ? pScript->Def->id : C4ID_None);
+		hash.Value(std::to_underlying(pScript->State));
+		hash.Value(std::to_underlying(pScript->Strict));
+		hash.Names(pScript->LocalNamed);
+		hash.Value(ScriptFuncs[i].size());
+		for (C4AulFunc *const pFunc : ScriptFuncs[i])
+		{
+			hash.String(pFunc->Name);
+			hash.Value(pFunc->GetParCount());
+			if (const C4V_Type *const pTypes{pFunc->GetParType()})
+				for (int32_t iPar = 0; iPar < C4AUL_MAX_Par; ++iPar) hash.Value(pTypes[iPar]);
+			else
+				hash.Value(-1);
+			hash.Value(pFunc->GetRetType());
+			hash.Value(pFunc->GetPublic());
+			hashFunc(pFunc->LinkedTo);
+			if (C4AulScriptFunc *const pSFunc{pFunc->SFunc()})
+			{
+				hash.Value(pSFunc->Access);
+				hash.Value(pSFunc->bNewFormat);
+				hash.Value(pSFunc->bReturnRef);
+				const auto it = ScriptIndices.find(pSFunc->pOrgScript);
+				hash.Value(it != ScriptIndices.end() ? it->second : -1);
+			}
+		}
+	}
+	hash.Names(rEngine.GlobalNamedNames);
+	hash.Names(rEngine.GlobalConstNames);
+	for (int32_t i = 0; i < rEngine.GlobalConstNames.iSize; ++i)
+	{
+		const C4Value *const pValue{rEngine.GlobalConsts.GetItem(i)};
+		hash.Value(pValue ? pValue->GetType() : C4V_Any);
+		if (pValue) hash.String(pValue->GetDataString().c_str());
+	}
+	hash.GetHash(Environment);
+	fActive = true;
+}
+
+void C4AulBytecodeCache::End()
+{
+	fActive = false;
+	Scripts.clear();
+	ScriptFuncs.clear();
+	ScriptIndices.clear();
+	FuncIndices.clear();
+}
+
+void C4AulBytecodeCache::GetParsedFuncs(C4AulScript &rScript, std::vector<C4AulScriptFunc *> &rFuncs)
+{
+	// same functions as parsed by C4AulScript::Parse
+	rFuncs.clear();
+	for (C4AulFunc *f = rScript.Func0; f; f = f->Next)
+	{
+		C4AulScriptFunc *Fn;
+		if (!(Fn = f->SFunc()))
+		{
+			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+			if (Fn) if (Fn->Owner != rScript.Engine) Fn = nullptr;
+		}
+		if (Fn) rFuncs.push_back(Fn);
+	}
+}
+
+bool C4AulBytecodeCache::GetKey(C4AulScript &rScript, const std::vector<C4AulScriptFunc *> &rFuncs, Key &rKey)
+{
+	const auto it = ScriptIndices.find(&rScript);
+	if (it == ScriptIndices.end()) return false;
+	Hasher hash;
+	hash.String(reinterpret_cast<const char *>(Environment.data()), Environment.size());
+	hash.Value(it->second);
+	// sources of the script and of all functions parsed into it
+	std::vector<const C4AulScript *> sources{&rScript};
+	for (C4AulScriptFunc *const Fn : rFuncs)
+	{
+		if (!Fn->pOrgScript) return false;
+		if (std::find(sources.begin(), sources.end(), Fn->pOrgScript) == sources.end())
+			sources.push_back(Fn->pOrgScript);
+	}
+	for (const C4AulScript *const pSource : sources)
+	{
+		const auto source = ScriptIndices.find(pSource);
+		if (source == ScriptIndices.end()) return false;
+		hash.Value(source->second);
+		hash.String(pSource->Script.getData() ? pSource->Script.getData() : "", pSource->Script.getLength());
+	}
+	hash.GetHash(rKey);
+	return true;
+}
+
+std::string C4AulBytecodeCache::GetPath(const Key &rKey)
+{
+	std::string path{Config.AtUserPath("ScriptCache" DirSep)};
+	for (const uint8_t byte : rKey) path += std::format("{:02x}", byte);
+	return path;
+}
+
+bool C4AulBytecodeCache::Restore(C4AulScript &rScript)
+{
+	if (!fActive) return false;
+	std::vector<C4AulScriptFunc *> funcs;
+	GetParsedFuncs(rScript, funcs);
+	Key key;
+	if (!GetKey(rScript, funcs, key)) return false;
+	// load entry
+	const std::string path{GetPath(key)};
+	StdBuf buf;
+	if (!FileExists(path.c_str()) || !buf.LoadFromFile(path.c_str())) return false;
+	Entry entry;
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(entry, buf);
+	}
+	catch (const StdCompiler::Exception &)
+	{
+		EraseFile(path.c_str());
+		return false;
+	}
+	// check that it fits the functions to be parsed
+	const auto iCodeSize = static_cast<int32_t>(entry.Code.size());
+	bool fValid{entry.Version == FormatVersion && entry.Hash == key && entry.Functions.size() == funcs.size() && iCodeSize > 0};
+	for (size_t i = 0; fValid && i < funcs.size(); ++i)
+	{
+		const Function &function{entry.Functions[i]};
+		const C4ValueMapNames &varNames{funcs[i]->VarNamed};
+		// variables have been declared by preparsing already
+		fValid = function.Name == funcs[i]->Name
+			&& std::equal(function.VarNames.begin(), function.VarNames.end(), varNames.pNames, varNames.pNames + varNames.iSize)
+			&& Inside<int32_t>(function.CodePos, i ? entry.Functions[i - 1].CodePos + 1 : 0, iCodeSize - 1);
+	}
+	for (const FuncRef &ref : entry.FuncRefs)
+		fValid = fValid && Inside<int32_t>(ref.Script, 0, static_cast<int32_t>(Scripts.size()) - 1)
+			&& Inside<int32_t>(ref.Func, 0, static_cast<int32_t>(ScriptFuncs[ref.Script].size()) - 1);
+	size_t iFunc{0};
+	int32_t iSourceLen{-1};
+	for (int32_t i = 0; fValid && i < iCodeSize; ++i)
+	{
+		const Chunk &chunk{entry.Code[i]};
+		while (iFunc < funcs.size() && entry.Functions[iFunc].CodePos == i)
+			iSourceLen = funcs[iFunc++]->pOrgScript->Script.getLength();
+		fValid = Inside<int32_t>(chunk.SPos, -1, iSourceLen);
+		switch (chunk.Type)
+		{
+		case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+			fValid = fValid && Inside<int64_t>(chunk.X, -1, static_cast<int64_t>(entry.FuncRefs.size()) - 1);
+			break;
+		case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+			fValid = fValid && Inside<int64_t>(chunk.X, -1, static_cast<int64_t>(entry.Strings.size()) - 1);
+			break;
+		default:
+			break;
+		}
+	}
+	if (!fValid)
+	{
+		EraseFile(path.c_str());
+		return false;
+	}
+	// link overloads as C4AulScript::ParseFn does
+	for (C4AulScriptFunc *const Fn : funcs)
+	{
+		if (Fn->OwnerOverloaded = Fn->Owner->GetOverloadedFunc(Fn))
+			if (Fn->Owner == Fn->OwnerOverloaded->Owner)
+				Fn->OwnerOverloaded->OverloadedBy = Fn;
+		Fn->NextSNFunc = nullptr;
+	}
+	// register strings
+	std::vector<C4String *> strings;
+	strings.reserve(entry.Strings.size());
+	for (const StringRef &ref : entry.Strings)
+	{
+		C4String *pString;
+		if (!(pString = rScript.Engine->Strings.FindString(ref.Data.c_str())))
+			pString = rScript.Engine->Strings.RegString(ref.Data.c_str());
+		if (ref.Hold) pString->Hold = true;
+		strings.push_back(pString);
+	}
+	// build byte code (the previous code has been deleted by Parse)
+	rScript.Code = new C4AulBCC[iCodeSize];
+	rScript.CodeSize = rScript.CodeBufSize = iCodeSize;
+	rScript.CPos = rScript.Code + iCodeSize;
+	const char *pSource{nullptr};
+	iFunc = 0;
+	for (int32_t i = 0; i < iCodeSize; ++i)
+	{
+		const Chunk &chunk{entry.Code[i]};
+		while (iFunc < funcs.size() && entry.Functions[iFunc].CodePos == i)
+			pSource = funcs[iFunc++]->pOrgScript->Script.getData();
+		C4AulBCC &bcc{rScript.Code[i]};
+		bcc.bccType = static_cast<C4AulBCCType>(chunk.Type);
+		bcc.bccX = static_cast<std::intptr_t>(chunk.X);
+		bcc.SPos = chunk.SPos >= 0 ? pSource + chunk.SPos : nullptr;
+		switch (bcc.bccType)
+		{
+		case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+			bcc.bccX = chunk.X < 0 ? 0 : reinterpret_cast<std::intptr_t>(ScriptFuncs[entry.FuncRefs[chunk.X].Script][entry.FuncRefs[chunk.X].Func]);
+			break;
+		case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+			bcc.bccX = chunk.X < 0 ? 0 : reinterpret_cast<std::intptr_t>(strings[chunk.X]);
+			break;
+		default:
+			break;
+		}
+	}
+	for (size_t i = 0; i < funcs.size(); ++i)
+		funcs[i]->Code = rScript.Code + entry.Functions[i].CodePos;
+	Keys[&rScript] = key;
+	// mark as recently used
+	std::error_code error;
+	std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+	return true;
+}
+
+void C4AulBytecodeCache::Store(C4AulScript &rScript)
+{
+	if (!fActive) return;
+	std::vector<C4AulScriptFunc *> funcs;
+	GetParsedFuncs(rScript, funcs);
+	Entry entry;
+	if (!GetKey(rScript, funcs, entry.Hash)) return;
+	// functions
+	for (C4AulScriptFunc *const Fn : funcs)
+	{
+		Function &function{entry.Functions.emplace_back()};
+		function.Name = Fn->Name;
+		function.CodePos = static_cast<int32_t>(Fn->Code - rScript.Code);
+		for (int32_t i = 0; i < Fn->VarNamed.iSize; ++i)
+			function.VarNames.emplace_back(Fn->VarNamed.pNames[i]);
+	}
+	// byte code with pointers replaced by indices
+	std::unordered_map<const C4AulFunc *, int64_t> funcRefs;
+	std::unordered_map<const C4String *, int64_t> stringRefs;
+	entry.Code.reserve(rScript.CodeSize);
+	const char *pSource{nullptr};
+	size_t iSourceLen{0};
+	size_t iFunc{0};
+	for (int32_t i = 0; i < rScript.CodeSize; ++i)
+	{
+		while (iFunc < funcs.size() && entry.Functions[iFunc].CodePos == i)
+		{
+			pSource = funcs[iFunc]->pOrgScript->Script.getData();
+			iSourceLen = funcs[iFunc++]->pOrgScript->Script.getLength();
+		}
+		const C4AulBCC &bcc{rScript.Code[i]};
+		Chunk &chunk{entry.Code.emplace_back(Chunk{bcc.bccType, bcc.bccX, -1})};
+		if (bcc.SPos)
+		{
+			// position outside of the function's sources cannot be restored
+			if (!pSource || bcc.SPos < pSource || bcc.SPos > pSource + iSourceLen) return;
+			chunk.SPos = static_cast<int32_t>(bcc.SPos - pSource);
+		}
+		switch (bcc.bccType)
+		{
+		case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+			if (const auto *const pFunc = reinterpret_cast<const C4AulFunc *>(bcc.bccX))
+			{
+				const auto it = FuncIndices.find(pFunc);
+				if (it == FuncIndices.end()) return;
+				const auto [ref, fNew] = funcRefs.emplace(pFunc, static_cast<int64_t>(entry.FuncRefs.size()));
+				if (fNew) entry.FuncRefs.push_back(it->second);
+				chunk.X = ref->second;
+			}
+			else
+				chunk.X = -1;
+			break;
+		case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+			if (const auto *const pString = reinterpret_cast<const C4String *>(bcc.bccX))
+			{
+				const auto [ref, fNew] = stringRefs.emplace(pString, static_cast<int64_t>(entry.Strings.size()));
+				if (fNew) entry.Strings.push_back(StringRef{pString->Data.getData(), pString->Hold});
+				chunk.X = ref->second;
+			}
+			else
+				chunk.X = -1;
+			break;
+		default:
+			break;
+		}
+	}
+	// write
+	const std::string path{GetPath(entry.Hash)};
+	if (!DirectoryExists(Config.AtUserPath("ScriptCache")))
+		MakeDirectory(Config.AtUserPath("ScriptCache"), nullptr);
+	try
+	{
+		if (!DecompileToBuf<StdCompilerBinWrite>(entry).SaveToFile(path.c_str())) return;
+	}
+	catch (const StdCompiler::Exception &)
+	{
+		return;
+	}
+	Keys[&rScript] = entry.Hash;
+}
+
+void C4AulBytecodeCache::Invalidate(const C4AulScript &rScript)
+{
+	const auto it = Keys.find(&rScript);
+	if (it == Keys.end()) return;
+	EraseFile(GetPath(it->second).c_str());
+	Keys.erase(it);
+}
+
+void C4AulBytecodeCache::Trim()
+{
+	if (!Config.Developer.ScriptBytecodeCache) return;
+	if (!DirectoryExists(Config.AtUserPath("ScriptCache"))) return;
+	const std::string directory{Config.AtUserPath("ScriptCache" DirSep)};
+	// erase the entries used longest ago until the rest fits
+	// entries of changed sources or other engine versions are never used again and go first
+	struct File
+	{
+		std::string Path;
+		time_t Time;
+		size_t Size;
+	};
+	std::vector<File> files;
+	size_t iTotal{0};
+	for (DirectoryIterator it{directory.c_str()}; *it; ++it)
+	{
+		const size_t iSize{FileSize(*it)};
+		files.push_back({*it, FileTime(*it), iSize});
+		iTotal += iSize;
+	}
+	const size_t iLimit{static_cast<size_t>(std::max(Config.Developer.ScriptBytecodeCacheSize, 0)) * 1024 * 1024};
+	if (iTotal <= iLimit) return;
+	std::ranges::sort(files, {}, &File::Time);
+	for (const File &file : files)
+	{
+		if (iTotal <= iLimit) break;
+		if (EraseFile(file.Path.c_str())) iTotal -= file.Size;
+	}
+}
@@ -0,0 +1,113 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* On-disk cache for the byte code of parsed scripts */
+
+#pragma once
+
+#include "StdSha1.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class C4AulFunc;
+class C4AulScript;
+class C4AulScriptEngine;
+class C4AulScriptFunc;
+class StdCompiler;
+
+// Byte code of parsed scripts is kept in the user path, so scripts whose sources did not change
+// are not parsed again on the next link. Cached code is keyed by the SHA1 of the script's sources,
+// the sources of all included and appended functions and everything parsing looks up in other
+// scripts (function signatures, global names and constants) as well as the engine version.
+class C4AulBytecodeCache
+{
+public:
+	using Key = std::array<uint8_t, StdSha1::DigestLength>;
+
+	static constexpr int32_t FormatVersion = 1; // increase whenever the byte code changes
+
+private:
+	// byte code chunk; pointers are stored as indices into FuncRefs or Strings
+	struct Chunk
+	{
+		int32_t Type;
+		int64_t X;
+		int32_t SPos; // offset in the sources of the function's original script; -1 for none
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	// function by position in the script tree
+	struct FuncRef
+	{
+		int32_t Script, Func;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct StringRef
+	{
+		std::string Data;
+		bool Hold;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Function
+	{
+		std::string Name;
+		int32_t CodePos;
+		std::vector<std::string> VarNames;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Entry
+	{
+		int32_t Version{FormatVersion};
+		Key Hash{};
+		std::vector<Function> Functions;
+		std::vector<Chunk> Code;
+		std::vector<FuncRef> FuncRefs;
+		std::vector<StringRef> Strings;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	bool fActive{false}; // set between Begin and End if enabled
+	Key Environment{}; // hash of everything parsing depends on outside of a script's own sources
+	std::vector<C4AulScript *> Scripts; // all scripts in tree order
+	std::vector<std::vector<C4AulFunc *>> ScriptFuncs; // functions of every script in list order
+	std::unordered_map<const C4AulScript *, int32_t> ScriptIndices;
+	std::unordered_map<const C4AulFunc *, FuncRef> FuncIndices;
+	std::unordered_map<const C4AulScript *, Key> Keys; // key of the byte code last used by each script
+
+public:
+	void Begin(C4AulScriptEngine &rEngine); // called before all scripts are parsed
+	void End(); // called after all scripts are parsed
+	bool Restore(C4AulScript &rScript); // load byte code of unchanged sources; return whether successful
+	void Store(C4AulScript &rScript); // save byte code of a script that has just been parsed without errors or warnings
+	void Invalidate(const C4AulScript &rScript); // drop byte code cached for the previous sources of a script
+	void Trim(); // erase the least recently used entries above the size limit
+
+private:
+	void GetParsedFuncs(C4AulScript &rScript, std::vector<C4AulScriptFunc *> &rFuncs);
+	bool GetKey(C4AulScript &rScript, const std::vector<C4AulScriptFunc *> &rFuncs, Key &rKey);
+	static std::string GetPath(const Key &rKey);
+};
@@ -0,0 +1,160 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4AulCallProfiler.h>
+
+#include <C4Aul.h>
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4Trace.h>
+
+#include <StdFile.h>
+
+#include <algorithm>
+#include <format>
+#include <map>
+
+C4AulCallProfiler AulCallProfiler;
+
+void C4AulCallProfiler::Start(const std::size_t capacity)
+{
+	Clear();
+	Events.resize(std::max<std::size_t>(capacity, 1));
+	// label 0 is shared by all temporary scripts
+	Labels.push_back({"Direct exec", "Direct exec"});
+	StartTime = Clock::now();
+	fRecording = true;
+}
+
+void C4AulCallProfiler::Stop()
+{
+	fRecording = false;
+}
+
+void C4AulCallProfiler::Clear()
+{
+	fRecording = false;
+	// labels assigned to functions become invalid
+	++Run;
+	Events.clear();
+	Events.shrink_to_fit();
+	NextEvent = 0;
+	fWrapped = false;
+	Labels.clear();
+}
+
+std::uint32_t C4AulCallProfiler::GetLabel(C4AulScriptFunc *const pFunc)
+{
+	if (pFunc->ProfilerRun != Run)
+	{
+		pFunc->ProfilerRun = Run;
+		pFunc->ProfilerLabel = static_cast<std::uint32_t>(Labels.size());
+
+		std::string category;
+		if (!pFunc->Owner) category = "(unknown)";
+		else if (pFunc->Owner->Def) category = C4IdText(pFunc->Owner->Def->id);
+		else if (pFunc->Owner == &Game.ScriptEngine) category = "global";
+		else category = "game";
+
+		Labels.push_back({pFunc->GetFullName(), std::move(category)});
+	}
+	return pFunc->ProfilerLabel;
+}
+
+template<typename Func>
+void C4AulCallProfiler::ForEachCall(Func &&func) const
+{
+	std::vector<Frame> stack;
+	std::int64_t lastTime{0};
+
+	const auto leave = [&](const std::int64_t time)
+	{
+		func(stack, time);
+		const std::int64_t duration{time - stack.back().Start};
+		stack.pop_back();
+		if (!stack.empty()) stack.back().Children += duration;
+	};
+
+	// oldest events first
+	const std::size_t count{fWrapped ? Events.size() : NextEvent};
+	for (std::size_t i{0}; i < count; ++i)
+	{
+		const Event &event{Events[fWrapped ? (NextEvent + i) % Events.size() : i]};
+		lastTime = event.Time;
+		if (event.Label != LeaveLabel)
+		{
+			stack.push_back({event.Label, event.Time});
+		}
+		// calls entered before the recording started or before the ring buffer wrapped are unknown
+		else if (!stack.empty())
+		{
+			leave(event.Time);
+		}
+	}
+
+	// calls still running when the recording stopped
+	while (!stack.empty())
+	{
+		leave(lastTime);
+	}
+}
+
+std::string C4AulCallProfiler::GetCollapsedStacks() const
+{
+	// self time per call path
+	std::map<std::string, std::int64_t> paths;
+	ForEachCall([this, &paths](const std::vector<Frame> &stack, const std::int64_t end)
+	{
+		std::string path;
+		for (const Frame &frame : stack)
+		{
+			if (!path.empty()) path += ';';
+			path += Labels[frame.Label].Name;
+		}
+		paths[path] += end - stack.back().Start - stack.back().Children;
+	});
+
+	std::string result;
+	for (const auto &[path, time] : paths)
+	{
+		result += std::format("{} {}\n", path, time);
+	}
+	return result;
+}
+
+std::string C4AulCallProfiler::GetChromeTrace() const
+{
+	std::string result{"{\"displayTimeUnit\":\"ns\",\"traceEvents\":["};
+	bool first{true};
+	ForEachCall([this, &result, &first](const std::vector<Frame> &stack, const std::int64_t end)
+	{
+		const Frame &frame{stack.back()};
+		const FuncLabel &label{Labels[frame.Label]};
+		if (!first) result += ',';
+		first = false;
+		// timestamps are in microseconds
+		result += std::format("\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+			C4Trace::EscapeJson(label.Name), C4Trace::EscapeJson(label.Category), frame.Start / 1000.0, (end - frame.Start) / 1000.0);
+	});
+	result += "\n]}\n";
+	return result;
+}
+
+bool C4AulCallProfiler::Save(const char *const szFilename) const
+{
+	const std::string output{SEqualNoCase(GetExtension(szFilename), "json") ? GetChromeTrace() : GetCollapsedStacks()};
+	return StdStrBuf{output.c_str(), output.size(), false}.SaveToFile(szFilename);
+}
@@ -0,0 +1,109 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Records script calls with their call paths for flame graphs and Chrome traces */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class C4AulScriptFunc;
+
+// Entering and leaving script functions is recorded into a ring buffer with nanosecond timestamps,
+// so the most recent calls of a run are kept no matter how long it takes.
+// Functions are labeled with their definition (CLNK::Timer, CLNK::FxBurnTimer, ...), so
+// the costs of single definitions and callbacks can be read from the call tree.
+// A recording can be saved as collapsed stacks for flame graph tools or as a Chrome trace (about:tracing, Perfetto).
+class C4AulCallProfiler
+{
+public:
+	static constexpr std::size_t DefaultCapacity{1 << 20}; // number of events kept per run
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::uint32_t LeaveLabel{UINT32_MAX};
+
+	struct Event
+	{
+		std::int64_t Time; // nanoseconds since the start of the run
+		std::uint32_t Label; // index into Labels, LeaveLabel for leaving a function
+	};
+
+	struct FuncLabel
+	{
+		std::string Name;
+		std::string Category; // owning definition or script
+	};
+
+	// function call while going through the recording
+	struct Frame
+	{
+		std::uint32_t Label;
+		std::int64_t Start;
+		std::int64_t Children{0}; // time spent in called functions
+	};
+
+	bool fRecording{false};
+	std::uint32_t Run{0};
+	Clock::time_point StartTime;
+	std::vector<Event> Events;
+	std::size_t NextEvent{0};
+	bool fWrapped{false};
+	std::vector<FuncLabel> Labels;
+
+public:
+	bool IsRecording() const { return fRecording; }
+
+	void Start(std::size_t capacity = DefaultCapacity); // discards the previous recording
+	void Stop();
+	void Clear();
+
+	void Enter(C4AulScriptFunc *pFunc, bool fTemporaryScript)
+	{
+		Record(fTemporaryScript ? 0 : GetLabel(pFunc));
+	}
+
+	void Leave()
+	{
+		Record(LeaveLabel);
+	}
+
+	// save the recording; files ending with .json get a Chrome trace, others collapsed stacks
+	bool Save(const char *szFilename) const;
+
+private:
+	void Record(const std::uint32_t label)
+	{
+		Events[NextEvent] = {std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - StartTime).count(), label};
+		if (++NextEvent == Events.size())
+		{
+			NextEvent = 0;
+			fWrapped = true;
+		}
+	}
+
+	std::uint32_t GetLabel(C4AulScriptFunc *pFunc);
+	std::string GetCollapsedStacks() const;
+	std::string GetChromeTrace() const;
+
+	template<typename Func> void ForEachCall(Func &&func) const; // calls func(stack, end) for every finished call, the call being on top of stack
+};
+
+extern C4AulCallProfiler AulCallProfiler;
@@ -20,6 +20,7 @@
 #include <C4Include.h>
 #include <C4Aul.h>
 
+#include <C4AulCallProfiler.h>
 #include <C4Object.h>
 #include <C4Config.h>
 #include <C4Game.h>
@@ -123,7 +124,8 @@ private:
 	std::shared_ptr<spdlog::logger> traceLogger;
 	int iTraceStart;
 	bool fProfiling;
-	time_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
+	std::chrono::steady_clock::time_point tDirectExecStart; // profiler time for DirectExec
+	std::chrono::steady_clock::duration tDirectExecTotal;
 	C4AulScript *pProfiledScript;
 
 public:
@@ -134,8 +136,8 @@ public:
 	void StartProfiling(C4AulScript *pScript); // resets profling times and starts recording the times
 	void StopProfiling(); // stop the profiler and displays results
 	void AbortProfiling() { fProfiling = false; }
-	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = timeGetTime(); }
-	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += timeGetTime() - tDirectExecStart; }
+	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = std::chrono::steady_clock::now(); }
+	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += std::chrono::steady_clock::now() - tDirectExecStart; }
 
 private:
 	void PushContext(const C4AulScriptContext &rContext)
@@ -151,7 +153,8 @@ private:
 			pCurCtx->dump(std::move(buf));
 		}
 		// Profiler: Safe time to measure difference afterwards
-		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		if (fProfiling) pCurCtx->tTime = std::chrono::steady_clock::now();
+		if (AulCallProfiler.IsRecording()) AulCallProfiler.Enter(pCurCtx->Func, pCurCtx->TemporaryScript);
 	}
 
 	void PopContext()
@@ -161,10 +164,10 @@ private:
 		// Profiler adding up times
 		if (fProfiling)
 		{
-			time_t dt = timeGetTime() - pCurCtx->tTime;
-			if (dt && pCurCtx->Func)
-				pCurCtx->Func->tProfileTime += dt;
+			if (pCurCtx->Func)
+				pCurCtx->Func->tProfileTime += std::chrono::steady_clock::now() - pCurCtx->tTime;
 		}
+		if (AulCallProfiler.IsRecording()) AulCallProfiler.Leave();
 		// Trace done?
 		if (iTraceStart >= 0)
 		{
@@ -625,12 +628,11 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 						CheckOpPar(pPar2, C4V_Array, operatorName, " right side");
 						const auto lhsSize = pPar1->_getArray()->GetSize();
 						const auto rhsSize = pPar2->_getArray()->GetSize();
-						pPar1->SetArrayLength(lhsSize + rhsSize, pCurCtx);
-						auto &lhs = *pPar1->_getArray();
-						auto &rhs = *pPar2->_getArray();
-
-						for (auto i = 0; i < rhsSize; ++i)
-							lhs[lhsSize + i] = rhs[i];
+						if (lhsSize + rhsSize > C4ValueList::MaxSize)
+							throw C4AulExecError(pCurCtx->Obj, "out of memory");
+						// copy if necessary
+						pPar1->SetArrayLength(lhsSize, pCurCtx);
+						pPar1->_getArray()->Append(pPar2->_getArray()->GetItems());
 
 						PopValue();
 						break;
@@ -866,11 +868,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_ARRAY:
 			{
 				// Create array
-				C4ValueArray *pArray = new C4ValueArray(pCPos->bccX);
+				C4ValueArray *pArray = new C4ValueArray();
 
 				// Pop values from stack
-				for (int i = 0; i < pCPos->bccX; i++)
-					pArray->GetItem(i) = pCurVal[i - pCPos->bccX + 1];
+				pArray->Append({pCurVal - pCPos->bccX + 1, static_cast<std::size_t>(pCPos->bccX)});
 
 				// Push array
 				if (pCPos->bccX > 0)
@@ -1544,9 +1545,9 @@ void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
 	fProfiling = true;
 	// resets profling times and starts recording the times
 	this->pProfiledScript = pProfiledScript;
-	time_t tNow = timeGetTime();
+	const auto tNow = std::chrono::steady_clock::now();
 	tDirectExecStart = tNow; // in case profiling is started from DirectExec
-	tDirectExecTotal = 0;
+	tDirectExecTotal = {};
 	pProfiledScript->ResetProfilerTimes();
 	for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
 		pCtx->tTime = tNow;
@@ -1579,10 +1580,10 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
-void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
+void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, std::chrono::steady_clock::duration tProfileTime)
 {
 	// zero entries are not collected to have a cleaner list
-	if (!tProfileTime) return;
+	if (tProfileTime == tProfileTime.zero()) return;
 	// add entry to list
 	Entry e;
 	e.pFunc = pFunc;
@@ -1601,7 +1602,7 @@ void C4AulProfiler::Show()
 	for (EntryList::iterator i = Times.begin(); i != Times.end(); ++i)
 	{
 		Entry &e = (*i);
-		logger->info("{:05}ms\t{}", e.tProfileTime, e.pFunc ? (e.pFunc->GetFullName().c_str()) : "Direct exec");
+		logger->info("{:9.3f}ms\t{}", std::chrono::duration<double, std::milli>{e.tProfileTime}.count(), e.pFunc ? (e.pFunc->GetFullName().c_str()) : "Direct exec");
 	}
 	logger->info("==============================");
 	// done!
@@ -1712,7 +1713,7 @@ void C4AulScript::ResetProfilerTimes()
 	C4AulScriptFunc *pSFunc;
 	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
 		if (pSFunc = pFn->SFunc())
-			pSFunc->tProfileTime = 0;
+			pSFunc->tProfileTime = {};
 	// reset sub-scripts
 	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
 		pScript->ResetProfilerTimes();
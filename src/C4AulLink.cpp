@@ -24,6 +24,10 @@
 #include <C4Game.h>
 #include <C4Log.h>
 
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 // ResolveAppends and ResolveIncludes must be called both
 // for each script. ResolveAppends has to be called first!
 bool C4AulScript::ResolveAppends(C4DefList *rDefs)
@@ -204,46 +208,60 @@ void C4AulScriptFunc::UnLink()
 
 void C4AulScript::AfterLink()
 {
-	// for all funcs: search functions that have the same name in
-	// the whole script tree (for great fast direct object call)
-	for (C4AulFunc *Func = Func0; Func; Func = Func->Next)
-		// same-name ring not yet build for this function name?
-		if (!Func->NextSNFunc && !Func->OverloadedBy)
+	// call for childs
+	for (C4AulScript *s = Child0; s; s = s->Next) s->AfterLink();
+}
+
+void C4AulScriptEngine::LinkSameNameFuncs()
+{
+	// search functions that have the same name in the whole script tree
+	// (for great fast direct object call)
+	// Every ring is started by the first unlinked function of its name in tree order
+	// and contains the function of every script behind it in reverse tree order.
+	// Visiting each script once and looking up the rings by name keeps this linear.
+	std::unordered_map<std::string_view, std::vector<C4AulFunc *>> rings;
+	std::unordered_map<std::string_view, C4AulFunc *> scriptFuncs;
+	C4AulScript *pPos = this;
+	while (pPos)
+	{
+		// functions of this script by name; the lookup table holds a script's functions
+		// in reverse order, so the last one is the one GetFunc finds
+		scriptFuncs.clear();
+		for (C4AulFunc *Func = pPos->Func0; Func; Func = Func->Next)
+			scriptFuncs[Func->Name] = Func;
+		// link into rings started by scripts in front of this one
+		for (auto [name, pFn] : scriptFuncs)
 		{
-			// init
-			Func->NextSNFunc = Func;
-			// search complete tree for functions with same name
-			// (expect all scripts "behind" this point to be already checked
-			//  - so after-link calls for childs must be done after this).
-			C4AulScript *pPos = this;
-			while (pPos)
+			const auto it = rings.find(name);
+			if (it == rings.end()) continue;
+			// resolve overloads
+			while (pFn->OverloadedBy) pFn = pFn->OverloadedBy;
+			// link
+			for (C4AulFunc *const Func : it->second)
 			{
-				// has children? go down in hierarchy
-				if (pPos->Child0)
-					pPos = pPos->Child0;
-				else
-				{
-					// last child? go up in hierarchy
-					while (!pPos->Next && pPos->Owner)
-						pPos = pPos->Owner;
-					// next node
-					pPos = pPos->Next;
-				}
-				if (!pPos) break;
-				// has function with same name?
-				C4AulFunc *pFn = pPos->GetFunc(Func->Name);
-				if (pFn)
-				{
-					// resolve overloads
-					while (pFn->OverloadedBy) pFn = pFn->OverloadedBy;
-					// link
-					pFn->NextSNFunc = Func->NextSNFunc;
-					Func->NextSNFunc = pFn;
-				}
+				pFn->NextSNFunc = Func->NextSNFunc;
+				Func->NextSNFunc = pFn;
 			}
 		}
-	// call for childs
-	for (C4AulScript *s = Child0; s; s = s->Next) s->AfterLink();
+		// start rings for function names not linked yet
+		for (C4AulFunc *Func = pPos->Func0; Func; Func = Func->Next)
+			if (!Func->NextSNFunc && !Func->OverloadedBy)
+			{
+				Func->NextSNFunc = Func;
+				rings[Func->Name].push_back(Func);
+			}
+		// has children? go down in hierarchy
+		if (pPos->Child0)
+			pPos = pPos->Child0;
+		else
+		{
+			// last child? go up in hierarchy
+			while (!pPos->Next && pPos->Owner)
+				pPos = pPos->Owner;
+			// next node
+			pPos = pPos->Next;
+		}
+	}
 }
 
 bool C4AulScript::ReloadScript(const char *szPath)
@@ -269,11 +287,17 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		ParseDescs();
 
 		// parse the scripts to byte code
+		BytecodeCache.Begin(*this);
 		Parse();
+		BytecodeCache.End();
+		BytecodeCache.Trim();
 
 		// engine is always parsed (for global funcs)
 		State = ASS_PARSED;
 
+		// link same-named funcs
+		LinkSameNameFuncs();
+
 		// get common funcs
 		AfterLink();
 
@@ -3531,6 +3531,15 @@ bool C4AulScript::Parse()
 	// reset code and script pos
 	CPos = Code;
 
+	// reuse byte code of unchanged sources
+	if (Engine->BytecodeCache.Restore(*this))
+	{
+		Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
+		State = ASS_PARSED;
+		return true;
+	}
+	const int iWarnCnt{Engine->warnCnt}, iErrCnt{Engine->errCnt};
+
 	// parse script funcs
 	C4AulFunc *f;
 	for (f = Func0; f; f = f->Next)
@@ -3600,6 +3609,10 @@ bool C4AulScript::Parse()
 	// save line count
 	Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
 
+	// keep byte code for the next link if parsing went fine
+	if (Engine->warnCnt == iWarnCnt && Engine->errCnt == iErrCnt)
+		Engine->BytecodeCache.Store(*this);
+
 	// dump bytecode
 #if DEBUG_BYTECODE_DUMP
 	for (f = Func0; f; f = f->Next)
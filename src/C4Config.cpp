@@ -135,6 +135,12 @@ void C4ConfigDeveloper::ConsoleScriptStrictnessWrapper::CompileFunc(StdCompiler
 void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
+	pComp->Value(mkNamingAdapt(ScriptBytecodeCache, "ScriptBytecodeCache", false));
+	pComp->Value(mkNamingAdapt(ScriptBytecodeCacheSize, "ScriptBytecodeCacheSize", 32));
+	pComp->Value(mkNamingAdapt(TraceCapture, "TraceCapture", false));
+	pComp->Value(mkNamingAdapt(ObjectSleep, "ObjectSleep", false));
+	pComp->Value(mkNamingAdapt(VerifyObjectSleep, "VerifyObjectSleep", false));
+	pComp->Value(mkNamingAdapt(VerifyMatRuns, "VerifyMatRuns", false));
 	pComp->Value(mkNamingAdapt(ConsoleScriptStrictness, "ConsoleScriptStrictness", ConsoleScriptStrictnessWrapper{ConsoleScriptStrictnessWrapper::MaxStrictSentinel}));
 }
 
@@ -173,6 +179,9 @@ void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(NoAlphaAdd,           "NoAlphaAdd",           false));
 	pComp->Value(mkNamingAdapt(PointFiltering,       "PointFiltering",       false));
 	pComp->Value(mkNamingAdapt(NoBoxFades,           "NoBoxFades",           false));
+	pComp->Value(mkNamingAdapt(BatchBlits,           "BatchBlits",           false));
+	pComp->Value(mkNamingAdapt(StaticLayer,          "StaticLayer",          false));
+	pComp->Value(mkNamingAdapt(StreamLandscape,      "StreamLandscape",      false));
 	pComp->Value(mkNamingAdapt(NoAcceleration,       "NoAcceleration",       false));
 	pComp->Value(mkNamingAdapt(TexIndent,            "TexIndent",            0));
 	pComp->Value(mkNamingAdapt(BlitOffset,           "BlitOffset",           0));
@@ -189,6 +198,7 @@ void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Shader,               "Shader",               false, false, true));
 	pComp->Value(mkNamingAdapt(AutoFrameSkip,        "AutoFrameSkip",        true,  false, true));
 	pComp->Value(mkNamingAdapt(CacheTexturesInRAM,   "CacheTexturesInRAM",   100));
+	pComp->Value(mkNamingAdapt(DecodedImageCacheSize, "DecodedImageCacheSize", 256));
 
 	StdEnumEntry<DisplayMode> DisplayModes[] =
 	{
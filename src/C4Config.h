@@ -114,6 +114,12 @@ public:
 
 public:
 	bool AutoFileReload;
+	bool ScriptBytecodeCache; // keep byte code of parsed scripts in the user path
+	int32_t ScriptBytecodeCacheSize; // size limit of the byte code kept in the user path in MB
+	bool TraceCapture; // capture trace zones during rounds and save them as Trace.json in the user path
+	bool ObjectSleep; // skip executions of resting objects that would not change anything
+	bool VerifyObjectSleep; // execute sleeping objects anyway and warn if they change
+	bool VerifyMatRuns; // check the material runs used for EffectiveMatCount against vertical scans and warn if they differ
 	ConsoleScriptStrictnessWrapper ConsoleScriptStrictness;
 
 	void CompileFunc(StdCompiler *pComp);
@@ -147,6 +153,9 @@ public:
 	bool NoAlphaAdd; // always modulate alpha values instead of assing them (->no custom modulated alpha)
 	bool PointFiltering; // don't use linear filtering, because some crappy graphic cards can't handle it...
 	bool NoBoxFades; // map all DrawBoxFade-calls to DrawBoxDw
+	bool BatchBlits; // record blits into a draw list and submit them in batches
+	bool StaticLayer; // cache unchanged static objects in offscreen layers
+	bool StreamLandscape; // keep landscape textures in RAM and upload changed parts once per frame
 	uint32_t AllowedBlitModes; // bit mask for allowed blitting modes
 	bool NoAcceleration; // whether direct rendering is used (X11)
 	bool Shader; // whether to use pixelshaders
@@ -163,6 +172,7 @@ public:
 	int32_t MaxRefreshDelay; // minimum time after which graphics should be refreshed (ms)
 	bool AutoFrameSkip; // if true, gfx frames are skipped when they would slow down the game
 	int32_t CacheTexturesInRAM; // -1 for disabled; otherwise after CacheTexturesInRAM times of Locking, Unlock(true) keeps the texture in RAM
+	int32_t DecodedImageCacheSize; // size limit of decoded images kept in the user path in MB; 0 for disabled
 	DisplayMode UseDisplayMode;
 #ifdef _WIN32
 	bool Maximized;
@@ -0,0 +1,160 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* On-disk cache for decoded images */
+
+#include <C4Include.h>
+#include <C4DecodedImageCache.h>
+
+#include <C4Config.h>
+#include <C4Log.h>
+#include <C4Trace.h>
+
+#include <CStdFile.h>
+#include <StdBitmap.h>
+#include <StdFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <thread>
+#include <vector>
+
+C4DecodedImageCache DecodedImageCache;
+
+namespace
+{
+	size_t GetPixelSize(const uint32_t iWidth, const uint32_t iHeight, const bool fUseAlpha)
+	{
+		return static_cast<size_t>(iWidth) * iHeight * (fUseAlpha ? 4 : 3);
+	}
+}
+
+const std::string &C4DecodedImageCache::GetDirectory()
+{
+	if (Config.Graphics.DecodedImageCacheSize <= 0)
+	{
+		Directory.clear();
+		return Directory;
+	}
+	if (Directory.empty())
+	{
+		if (!DirectoryExists(Config.AtUserPath("ImageCache")))
+			MakeDirectory(Config.AtUserPath("ImageCache"), nullptr);
+		Directory = Config.AtUserPath("ImageCache" DirSep);
+	}
+	return Directory;
+}
+
+C4DecodedImageCache::Key C4DecodedImageCache::GetKey(const void *const pData, const size_t iSize)
+{
+	StdSha1 sha1;
+	sha1.Update(&FormatVersion, sizeof(FormatVersion));
+	sha1.Update(pData, iSize);
+	Key key;
+	sha1.GetHash(key.data());
+	return key;
+}
+
+std::string C4DecodedImageCache::GetPath(const std::string &rDirectory, const Key &rKey)
+{
+	std::string path{rDirectory};
+	for (const uint8_t byte : rKey) path += std::format("{:02x}", byte);
+	return path;
+}
+
+std::unique_ptr<StdBitmap> C4DecodedImageCache::Load(const std::string &rDirectory, const Key &rKey, const uint32_t iWidth, const uint32_t iHeight, const bool fUseAlpha)
+{
+	C4TRACE_ZONE("C4DecodedImageCache::Load");
+	const std::string path{GetPath(rDirectory, rKey)};
+	CStdFile file;
+	Header header;
+	if (!FileExists(path.c_str()) || !file.Open(path.c_str()) || !file.Read(&header, sizeof(header)))
+	{
+		++Misses;
+		return nullptr;
+	}
+	// the entry must be what the decoder would produce
+	std::unique_ptr<StdBitmap> bitmap;
+	if (!std::memcmp(header.Magic, "C4DI", sizeof(header.Magic)) && header.Version == FormatVersion
+		&& header.Width == iWidth && header.Height == iHeight && header.UseAlpha == static_cast<uint32_t>(fUseAlpha))
+	{
+		bitmap = std::make_unique<StdBitmap>(iWidth, iHeight, fUseAlpha);
+		if (!file.Read(bitmap->GetBytes(), GetPixelSize(iWidth, iHeight, fUseAlpha))) bitmap.reset();
+	}
+	file.Close();
+	if (!bitmap)
+	{
+		EraseFile(path.c_str());
+		++Misses;
+		return nullptr;
+	}
+	// mark as recently used
+	std::error_code error;
+	std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+	++Hits;
+	return bitmap;
+}
+
+void C4DecodedImageCache::Store(const std::string &rDirectory, const Key &rKey, const StdBitmap &rBitmap, const uint32_t iWidth, const uint32_t iHeight, const bool fUseAlpha)
+{
+	C4TRACE_ZONE("C4DecodedImageCache::Store");
+	const std::string path{GetPath(rDirectory, rKey)};
+	// write to a file of this thread first, so partial entries are never loaded
+	const std::string tempPath{std::format("{}.{}.tmp", path, std::hash<std::thread::id>{}(std::this_thread::get_id()))};
+	const Header header{{'C', '4', 'D', 'I'}, FormatVersion, iWidth, iHeight, fUseAlpha};
+	CStdFile file;
+	const bool fWritten{file.Create(tempPath.c_str())
+		&& file.Write(&header, sizeof(header))
+		&& file.Write(rBitmap.GetBytes(), GetPixelSize(iWidth, iHeight, fUseAlpha))};
+	if (!file.Close() || !fWritten || !RenameFile(tempPath.c_str(), path.c_str()))
+		EraseFile(tempPath.c_str());
+}
+
+void C4DecodedImageCache::Trim()
+{
+	if (Hits || Misses)
+	{
+		LogNTr(spdlog::level::debug, "Decoded image cache: {} hits, {} misses", Hits.load(), Misses.load());
+		Hits = Misses = 0;
+	}
+	if (Directory.empty()) return;
+	// erase the entries used longest ago until the rest fits
+	struct Entry
+	{
+		std::string Path;
+		time_t Time;
+		size_t Size;
+	};
+	std::vector<Entry> entries;
+	size_t iTotal{0};
+	for (DirectoryIterator it{Directory.c_str()}; *it; ++it)
+	{
+		const size_t iSize{FileSize(*it)};
+		entries.push_back({*it, FileTime(*it), iSize});
+		iTotal += iSize;
+	}
+	const size_t iLimit{static_cast<size_t>(std::max(Config.Graphics.DecodedImageCacheSize, 0)) * 1024 * 1024};
+	if (iTotal <= iLimit) return;
+	std::ranges::sort(entries, {}, &Entry::Time);
+	for (const Entry &entry : entries)
+	{
+		if (iTotal <= iLimit) break;
+		if (EraseFile(entry.Path.c_str())) iTotal -= entry.Size;
+	}
+}
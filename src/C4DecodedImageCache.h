@@ -0,0 +1,67 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* On-disk cache for decoded images */
+
+#pragma once
+
+#include "StdSha1.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class StdBitmap;
+
+// Decoded PNG and JPEG images are kept in the user path, so unchanged images are not decoded again
+// on the next start. Entries are keyed by the SHA1 of the encoded file and store the raw pixels,
+// which can be read straight into the bitmap. Load and Store may be called from decoding threads;
+// everything else runs on the main thread.
+class C4DecodedImageCache
+{
+public:
+	using Key = std::array<uint8_t, StdSha1::DigestLength>;
+
+	static constexpr uint32_t FormatVersion = 1; // increase whenever the decoded pixels change
+
+private:
+	struct Header
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t Width, Height;
+		uint32_t UseAlpha;
+	};
+
+	std::string Directory;
+	std::atomic<int32_t> Hits{0}, Misses{0};
+
+public:
+	const std::string &GetDirectory(); // empty if the cache is disabled
+
+	static Key GetKey(const void *pData, size_t iSize);
+	std::unique_ptr<StdBitmap> Load(const std::string &rDirectory, const Key &rKey, uint32_t iWidth, uint32_t iHeight, bool fUseAlpha);
+	static void Store(const std::string &rDirectory, const Key &rKey, const StdBitmap &rBitmap, uint32_t iWidth, uint32_t iHeight, bool fUseAlpha);
+
+	void Trim(); // erase the least recently used entries above the size limit and log the hit rate
+
+private:
+	static std::string GetPath(const std::string &rDirectory, const Key &rKey);
+};
+
+extern C4DecodedImageCache DecodedImageCache;
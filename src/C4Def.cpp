@@ -478,6 +478,7 @@ void C4Def::Default()
 	Filename[0] = 0;
 	Creation = 0;
 	Count = 0;
+	FirstInstance = LastInstance = nullptr;
 	TimerCall = nullptr;
 	MainFace.Set(nullptr, 0, 0, 0, 0);
 	Script.Default();
@@ -1209,6 +1210,18 @@ int32_t C4DefList::CheckRequireDef()
 	return rcount;
 }
 
+int32_t C4DefList::CheckGraphicsDecoded()
+{
+	const auto oldSize = Defs.size();
+	std::erase_if(Defs, [](const auto &def)
+	{
+		if (!def->Graphics.HasDecodeFailed()) return false;
+		DebugLog(spdlog::level::err, "Error loading graphics of {} ({})", def->Filename, C4IdText(def->id));
+		return true;
+	});
+	return static_cast<int32_t>(oldSize - Defs.size());
+}
+
 int32_t C4DefList::ColorizeByMaterial(C4MaterialMap &rMats, uint8_t bGBM)
 {
 	return std::count_if(Defs.begin(), Defs.end(), [bGBM, &rMats](const auto &def)
@@ -1247,6 +1260,60 @@ bool C4DefList::Reload(C4Def *pDef, uint32_t dwLoadWhat, const char *szLanguage,
 	return true;
 }
 
+void C4Def::AddInstance(C4Object *pObj)
+{
+	++Count;
+	LinkInstance(pObj);
+}
+
+void C4Def::RemoveInstance(C4Object *pObj)
+{
+	--Count;
+	UnlinkInstance(pObj);
+}
+
+bool C4Def::UnlinkInstance(C4Object *pObj)
+{
+	if (pObj->PrevInstance)
+		pObj->PrevInstance->NextInstance = pObj->NextInstance;
+	else if (FirstInstance == pObj)
+		FirstInstance = pObj->NextInstance;
+	else
+		return false; // not linked
+	if (pObj->NextInstance)
+		pObj->NextInstance->PrevInstance = pObj->PrevInstance;
+	else
+		LastInstance = pObj->PrevInstance;
+	pObj->PrevInstance = pObj->NextInstance = nullptr;
+	return true;
+}
+
+void C4Def::SortInstance(C4Object *pObj)
+{
+	if (UnlinkInstance(pObj)) LinkInstance(pObj);
+}
+
+void C4Def::AppendInstance(C4Object *pObj)
+{
+	if (!UnlinkInstance(pObj)) return;
+	if (pObj->PrevInstance = LastInstance) LastInstance->NextInstance = pObj; else FirstInstance = pObj;
+	LastInstance = pObj;
+}
+
+void C4Def::LinkInstance(C4Object *pObj)
+{
+	// objects outside the main list (ListOrder 0) are kept in front; all others are sorted by ListOrder
+	C4Object *pPrev = nullptr;
+	if (pObj->ListOrder)
+		for (pPrev = LastInstance; pPrev && pPrev->ListOrder > pObj->ListOrder; pPrev = pPrev->PrevInstance);
+	pObj->PrevInstance = pPrev;
+	if (pObj->NextInstance = pPrev ? pPrev->NextInstance : FirstInstance)
+		pObj->NextInstance->PrevInstance = pObj;
+	else
+		LastInstance = pObj;
+	if (pPrev) pPrev->NextInstance = pObj; else FirstInstance = pObj;
+}
+
 bool C4Def::LoadPortraits(C4Group &hGroup)
 {
 	// reset any previous portraits
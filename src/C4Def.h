@@ -27,6 +27,7 @@
 #include <C4ComponentHost.h>
 #include <C4ScriptHost.h>
 #include <C4DefGraphics.h>
+#include <C4DefExecProfiler.h>
 #include "C4LangStringTable.h"
 
 #include "C4DelegatedIterable.h"
@@ -317,6 +318,7 @@ public:
 	char Filename[_MAX_FNAME + 1];
 	int32_t Creation;
 	int32_t Count; // number of instantiations
+	C4Object *FirstInstance, *LastInstance; // NoSave // instantiations counted in Count in main list order; see C4Object::NextInstance
 	C4AulScriptFunc *TimerCall;
 	C4ComponentHost Desc;
 	C4DefScriptHost Script;
@@ -333,6 +335,7 @@ public:
 	int32_t PortraitCount;
 	C4PortraitGraphics *Portraits; // Portraits (linked list of C4AdditionalDefGraphics)
 	float Scale;
+	C4DefExecProfiler::Stats ExecStats; // NoSave // times of the instances' executions while DefExecProfiler is recording
 
 protected:
 	// copy of the physical info used in FairCrew-mode
@@ -353,6 +356,14 @@ public:
 	void ClearFairCrewPhysicals(); // remove cached fair crew physicals, will be created fresh on demand
 	void Synchronize();
 	const char *GetDesc() { return Desc.GetData(); }
+	void AddInstance(C4Object *pObj); // count instantiation and link it into the instance list
+	void RemoveInstance(C4Object *pObj); // uncount instantiation and unlink it from the instance list
+	bool UnlinkInstance(C4Object *pObj); // unlink from the instance list without changing Count; return whether it was linked
+	void SortInstance(C4Object *pObj); // move linked instantiation to its place after C4Object::ListOrder has changed
+	void AppendInstance(C4Object *pObj); // move linked instantiation behind all others; used when renumbering the main list
+
+private:
+	void LinkInstance(C4Object *pObj);
 
 protected:
 	bool LoadPortraits(C4Group &hGroup);
@@ -402,6 +413,7 @@ public:
 	int32_t ColorizeByMaterial(C4MaterialMap &rMats, uint8_t bGBM);
 	int32_t CheckEngineVersion(int32_t ver1, int32_t ver2, int32_t ver3, int32_t ver4, int32_t ver5);
 	int32_t CheckRequireDef();
+	int32_t CheckGraphicsDecoded(); // remove definitions whose graphics could not be decoded by a C4SurfaceDecodeBatch
 	void Draw(C4ID id, C4Facet &cgo, bool fSelected, int32_t iColor);
 	void Remove(C4Def *def);
 	bool Remove(C4ID id);
@@ -0,0 +1,96 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4DefExecProfiler.h>
+
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4Log.h>
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+C4DefExecProfiler DefExecProfiler;
+
+std::int64_t C4DefExecProfiler::Stats::GetTotal() const
+{
+	return std::accumulate(Time.begin(), Time.end(), std::int64_t{0});
+}
+
+C4DefExecProfiler::Timer::Timer(C4Def *const pDef)
+	: pStats{DefExecProfiler.IsRecording() ? &pDef->ExecStats : nullptr}
+{
+	if (pStats)
+	{
+		++pStats->Executions;
+		tLast = Clock::now();
+	}
+}
+
+void C4DefExecProfiler::Start()
+{
+	for (std::size_t i{0}; const auto def = Game.Defs.GetDef(i); ++i)
+	{
+		def->ExecStats = {};
+	}
+	StartFrame = Game.FrameCounter;
+	fRecording = true;
+}
+
+void C4DefExecProfiler::Stop()
+{
+	fRecording = false;
+}
+
+void C4DefExecProfiler::LogTop(const std::size_t count) const
+{
+	// sort by total time
+	std::vector<std::pair<std::int64_t, C4Def *>> defs;
+	std::int64_t total{0};
+	for (std::size_t i{0}; const auto def = Game.Defs.GetDef(i); ++i)
+	{
+		if (const std::int64_t defTotal{def->ExecStats.GetTotal()}; defTotal > 0)
+		{
+			defs.emplace_back(defTotal, def);
+			total += defTotal;
+		}
+	}
+	std::ranges::sort(defs, std::ranges::greater{}, &std::pair<std::int64_t, C4Def *>::first);
+
+	const auto toMs = [](const std::int64_t time) { return static_cast<double>(time) / 1e6; };
+	const std::int32_t frames{std::max(Game.FrameCounter - StartFrame, 1)};
+
+	const auto logger = CreateLogger("C4DefExecProfiler", {.GuiLogLevel = spdlog::level::info, .ShowLoggerNameInGui = false});
+	logger->info("Object execution by definition ({} frames, {:.3f}ms per frame):", frames, toMs(total) / frames);
+	logger->info("==============================");
+	for (const auto &[defTotal, def] : defs | std::views::take(count))
+	{
+		std::string phases;
+		for (std::size_t phase{0}; phase < PHASE_Count; ++phase)
+		{
+			if (def->ExecStats.Time[phase] > 0)
+			{
+				phases += std::format("{}{} {:.3f}ms", phases.empty() ? "" : ", ", PhaseNames[phase], toMs(def->ExecStats.Time[phase]));
+			}
+		}
+		logger->info("{:9.3f}ms {:5.1f}%\t{} ({} executions): {}", toMs(defTotal), 100.0 * defTotal / total, C4IdText(def->id), def->ExecStats.Executions, phases);
+	}
+	logger->info("==============================");
+}
@@ -0,0 +1,97 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Accounts the time objects spend in C4Object::Execute to their definitions */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+class C4Def;
+
+// While recording, C4Object::Execute adds the time spent in each of its phases to the
+// fixed-size table of the object's definition, so lagging rounds can be traced back to definitions.
+// When not recording, every phase costs a single check of a null pointer.
+class C4DefExecProfiler
+{
+public:
+	enum Phase
+	{
+		PHASE_OCF = 0,
+		PHASE_Command,
+		PHASE_Action,
+		PHASE_Movement,
+		PHASE_Particles,
+		PHASE_Effects,
+		PHASE_Timer,
+		PHASE_Other, // life, base, menu
+		PHASE_Count
+	};
+
+	static constexpr std::array<const char *, PHASE_Count> PhaseNames{"UpdateOCF", "ExecuteCommand", "ExecAction", "ExecMovement", "Particles", "Effects", "TimerCall", "Other"};
+
+	// times of one definition
+	struct Stats
+	{
+		std::array<std::int64_t, PHASE_Count> Time{}; // nanoseconds
+		std::int64_t Executions{0};
+
+		std::int64_t GetTotal() const;
+	};
+
+	// measures one C4Object::Execute
+	class Timer
+	{
+	public:
+		explicit Timer(C4Def *pDef);
+
+		// adds the time since the end of the previous phase to phase
+		void EndPhase(const Phase phase)
+		{
+			if (pStats)
+			{
+				const auto tNow = Clock::now();
+				pStats->Time[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(tNow - tLast).count();
+				tLast = tNow;
+			}
+		}
+
+	private:
+		Stats *pStats;
+		std::chrono::steady_clock::time_point tLast;
+	};
+
+	static constexpr std::size_t DefaultTopCount{10};
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	bool fRecording{false};
+	std::int32_t StartFrame{0};
+
+public:
+	bool IsRecording() const { return fRecording; }
+
+	void Start(); // resets the times of all definitions
+	void Stop();
+
+	// logs the definitions with the highest total times
+	void LogTop(std::size_t count) const;
+};
+
+extern C4DefExecProfiler DefExecProfiler;
@@ -204,6 +204,14 @@ bool C4DefGraphics::LoadAllGraphics(C4Group &hGroup, bool fColorByOwner)
 	return true;
 }
 
+bool C4DefGraphics::HasDecodeFailed()
+{
+	for (C4DefGraphics *pGfx = this; pGfx; pGfx = pGfx->pNext)
+		if ((pGfx->Bitmap && pGfx->Bitmap->HasDecodeFailed()) || (pGfx->BitmapClr && pGfx->BitmapClr->HasDecodeFailed()))
+			return true;
+	return false;
+}
+
 bool C4DefGraphics::ColorizeByMaterial(int32_t iMat, C4MaterialMap &rMats, uint8_t bGBM)
 {
 	C4Surface *sfcBitmap = GetBitmap(); // first bitmap only
@@ -53,6 +53,7 @@ public:
 
 	bool LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner); // load specified graphics from group
 	bool LoadAllGraphics(C4Group &hGroup, bool fColorByOwner); // load graphics from group
+	bool HasDecodeFailed(); // whether any of the batched images of these or the additional graphics could not be decoded
 	bool ColorizeByMaterial(int32_t iMat, C4MaterialMap &rMats, uint8_t bGBM); // colorize all graphics by material
 	C4DefGraphics *Get(const char *szGrpName); // get graphics by name
 	void Clear(); // clear fields; delete additional graphics
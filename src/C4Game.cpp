@@ -19,6 +19,10 @@
 
 #include <C4Include.h>
 #include <C4Game.h>
+#include <C4AulCallProfiler.h>
+#include <C4DecodedImageCache.h>
+#include <C4DefExecProfiler.h>
+#include <C4Trace.h>
 #include <C4Version.h>
 #include <C4Network2Reference.h>
 #include <C4FileMonitor.h>
@@ -35,7 +39,6 @@
 #include <C4Startup.h>
 #include <C4Viewport.h>
 #include <C4Command.h>
-#include <C4Stat.h>
 #include <C4PlayerInfo.h>
 #include <C4LoaderScreen.h>
 #include <C4Network2Dialogs.h>
@@ -85,6 +88,8 @@ bool C4Game::InitDefs()
 	for ([[maybe_unused]] const auto &def : Parameters.GameRes.iterRes(NRT_Definitions))
 		++iDefResCount;
 	int i = 0;
+	// decode definition graphics in the background while the next definitions are read
+	C4SurfaceDecodeBatch decodeBatch;
 	// Load specified defs
 	for (const auto &def : Parameters.GameRes.iterRes(NRT_Definitions))
 	{
@@ -99,6 +104,10 @@ bool C4Game::InitDefs()
 
 	// Load for scenario file - ignore sys group here, because it has been loaded already
 	iDefs += Defs.Load(ScenarioFile, C4D_Load_RX, Config.General.LanguageEx, &*Application.SoundSystem, true, true, 35, 40, false);
+	decodeBatch.Finish();
+	DecodedImageCache.Trim();
+	// graphics that failed to decode in the batch fail their definitions like a failed load
+	iDefs -= Defs.CheckGraphicsDecoded();
 
 	// Absolutely no defs: we don't like that
 	if (!iDefs) { LogFatal(C4ResStrTableKey::IDS_PRC_NODEFS); return false; }
@@ -355,6 +364,8 @@ bool C4Game::Init()
 	fQuitWithError = false;
 	C4GameLobby::UserAbort = false;
 
+	if (Config.Developer.TraceCapture) C4Trace::Start();
+
 	// Store a start time that identifies this game on this host
 	StartTime = static_cast<int32_t>(time(nullptr));
 
@@ -547,6 +558,9 @@ void C4Game::Clear()
 		PreloadThread.join();
 	}
 
+	// finish savegames still being written
+	C4GameSave::WaitForBackgroundSaves();
+
 	FileMonitor.reset();
 
 	if (Application.MusicSystem)
@@ -558,7 +572,12 @@ void C4Game::Clear()
 	IsRunning = false;
 	PointersDenumerated = false;
 
-	C4ST_SHOWSTAT
+	// save the trace zones captured during the round
+	if (Config.Developer.TraceCapture && C4Trace::IsCapturing())
+	{
+		C4Trace::Stop();
+		C4Trace::Save(Config.AtUserPath("Trace.json"));
+	}
 
 	// Evaluation
 	if (GameOver)
@@ -569,6 +588,8 @@ void C4Game::Clear()
 	// stop statistics
 	delete pNetworkStatistics; pNetworkStatistics = nullptr;
 	C4AulProfiler::Abort();
+	AulCallProfiler.Stop();
+	DefExecProfiler.Stop();
 
 	// exit gui
 	delete pGUI; pGUI = nullptr;
@@ -591,6 +612,8 @@ void C4Game::Clear()
 	DeleteObjects(true);
 	Defs.Clear();
 	Landscape.Clear();
+	// the navigation graph refers to the cleared landscape
+	PathFinder.InvalidateLandscape();
 	PXS.Clear();
 	delete pGlobalEffects; pGlobalEffects = nullptr;
 	Particles.Clear();
@@ -744,42 +767,30 @@ bool C4Game::GameOverCheck()
 int32_t iLastControlSize = 0;
 extern int32_t iPacketDelay;
 
-C4ST_NEW(ControlRcvStat,  "C4Game::Execute ReceiveControl")
-C4ST_NEW(ControlStat,     "C4Game::Execute ExecuteControl")
-C4ST_NEW(ExecObjectsStat, "C4Game::Execute ExecObjects")
-C4ST_NEW(GEStats,         "C4Game::Execute pGlobalEffects->Execute")
-C4ST_NEW(PXSStat,         "C4Game::Execute PXS.Execute")
-C4ST_NEW(PartStat,        "C4Game::Execute Particles.Execute")
-C4ST_NEW(MassMoverStat,   "C4Game::Execute MassMover.Execute")
-C4ST_NEW(WeatherStat,     "C4Game::Execute Weather.Execute")
-C4ST_NEW(PlayersStat,     "C4Game::Execute Players.Execute")
-C4ST_NEW(LandscapeStat,   "C4Game::Execute Landscape.Execute")
-C4ST_NEW(MusicSystemStat, "C4Game::Execute MusicSystem.Execute")
-C4ST_NEW(MessagesStat,    "C4Game::Execute Messages.Execute")
-C4ST_NEW(ScriptStat,      "C4Game::Execute Script.Execute")
-
-#define EXEC_S(Expressions, Stat) \
-	{ C4ST_START(Stat) Expressions C4ST_STOP(Stat) }
+#define EXEC_S(Expressions, ZoneName) \
+	{ C4TRACE_ZONE(ZoneName); Expressions }
 
 #ifdef DEBUGREC
-#define EXEC_S_DR(Expressions, Stat, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, Stat) }
+#define EXEC_S_DR(Expressions, ZoneName, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, ZoneName) }
 #define EXEC_DR(Expressions, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); Expressions }
 #else
-#define EXEC_S_DR(Expressions, Stat, DebugRecName) EXEC_S(Expressions, Stat)
+#define EXEC_S_DR(Expressions, ZoneName, DebugRecName) EXEC_S(Expressions, ZoneName)
 #define EXEC_DR(Expressions, DebugRecName) Expressions
 #endif
 
 bool C4Game::Execute() // Returns true if the game is over
 {
+	C4TRACE_ZONE("C4Game::Execute");
+
 	// Let's go
 	GameGo = true;
 
 	// Network
-	Network.Execute();
+	EXEC_S(Network.Execute();, "C4Game::Execute Network.Execute")
 
 	// Prepare control
 	bool fControl;
-	EXEC_S(fControl = Control.Prepare();, ControlStat)
+	EXEC_S(fControl = Control.Prepare();, "C4Game::Execute Control.Prepare")
 	if (!fControl) return false; // not ready yet: wait
 
 	// Halt
@@ -790,7 +801,7 @@ bool C4Game::Execute() // Returns true if the game is over
 #endif
 
 	// Execute the control
-	Control.Execute();
+	EXEC_S(Control.Execute();, "C4Game::Execute Control.Execute")
 	if (!IsRunning) return false;
 
 	// Ticks
@@ -803,19 +814,19 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Game
 
-	EXEC_S(ExecObjects();, ExecObjectsStat)
+	EXEC_S(ExecObjects();, "C4Game::Execute ExecObjects")
 	if (pGlobalEffects)
-		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, "GEEx\0");
-	EXEC_S_DR(PXS.Execute();,                      PXSStat,         "PXSEx")
-	EXEC_S_DR(Particles.GlobalParticles.Exec();,   PartStat,        "ParEx")
-	EXEC_S_DR(MassMover.Execute();,                MassMoverStat,   "MMvEx")
-	EXEC_S_DR(Weather.Execute();,                  WeatherStat,     "WtrEx")
-	EXEC_S_DR(Landscape.Execute();,                LandscapeStat,   "LdsEx")
-	EXEC_S_DR(Players.Execute();,                  PlayersStat,     "PlrEx")
+		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, "C4Game::Execute pGlobalEffects->Execute", "GEEx\0");
+	EXEC_S_DR(PXS.Execute();,                      "C4Game::Execute PXS.Execute",         "PXSEx")
+	EXEC_S_DR(Particles.GlobalParticles.Exec();,   "C4Game::Execute Particles.Execute",   "ParEx")
+	EXEC_S_DR(MassMover.Execute();,                "C4Game::Execute MassMover.Execute",   "MMvEx")
+	EXEC_S_DR(Weather.Execute();,                  "C4Game::Execute Weather.Execute",     "WtrEx")
+	EXEC_S_DR(Landscape.Execute();,                "C4Game::Execute Landscape.Execute",   "LdsEx")
+	EXEC_S_DR(Players.Execute();,                  "C4Game::Execute Players.Execute",     "PlrEx")
 	// FIXME: C4Application::Execute should do this, but what about the stats?
-	EXEC_S_DR(Application.MusicSystem->Execute();, MusicSystemStat, "Music")
-	EXEC_S_DR(Messages.Execute();,                 MessagesStat,    "MsgEx")
-	EXEC_S_DR(Script.Execute();,                   ScriptStat,      "Scrpt")
+	EXEC_S_DR(Application.MusicSystem->Execute();, "C4Game::Execute MusicSystem.Execute", "Music")
+	EXEC_S_DR(Messages.Execute();,                 "C4Game::Execute Messages.Execute",    "MsgEx")
+	EXEC_S_DR(Script.Execute();,                   "C4Game::Execute Script.Execute",      "Scrpt")
 
 	EXEC_DR(MouseControl.Execute();, "Input")
 
@@ -831,13 +842,6 @@ bool C4Game::Execute() // Returns true if the game is over
 		if (!GameOverDlgShown) ShowGameOverDlg();
 	}
 
-	// show stat each 1000 ticks
-	if (!(FrameCounter % 1000))
-	{
-		C4ST_SHOWPARTSTAT
-		C4ST_RESETPART
-	}
-
 #ifdef DEBUGREC
 	AddDbgRec(RCT_Block, "eGame", 6);
 
@@ -1319,7 +1323,7 @@ C4Object *C4Game::FindObject(C4ID id,
 	int32_t iClosest = 0, iDistance, iFartherThan = -1;
 	C4Object *cObj;
 	C4ObjectLink *cLnk;
-	C4Def *pDef;
+	C4Def *pDef = nullptr;
 	C4Object *pFindNextCpy = pFindNext;
 
 	// check the easy cases first
@@ -1338,8 +1342,8 @@ C4Object *C4Game::FindObject(C4ID id,
 
 	bool bFindActIdle = SEqual(szAction, "Idle") || SEqual(szAction, "ActIdle");
 
-	// Scan all objects
-	for (cLnk = Objects.First; cLnk && (cObj = cLnk->Obj); cLnk = cLnk->Next)
+	// Check object; return whether it is the result
+	const auto check = [&](C4Object *cObj) -> bool
 	{
 		// Not skipping to find next
 		if (!pFindNext)
@@ -1363,14 +1367,14 @@ C4Object *C4Game::FindObject(C4ID id,
 										{
 											// Full range
 											if ((iX == 0) && (iY == 0) && (iWdt == 0) && (iHgt == 0))
-												return cObj;
+												return true;
 											// Point
 											if ((iWdt == 0) && (iHgt == 0))
 											{
 												if (Inside<int32_t>(iX - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1))
 													if (Inside<int32_t>(iY - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1))
-														return cObj;
-												continue;
+														return true;
+												return false;
 											}
 											// Closest
 											if ((iWdt == -1) && (iHgt == -1))
@@ -1378,7 +1382,7 @@ C4Object *C4Game::FindObject(C4ID id,
 												iDistance = (cObj->x - iX) * (cObj->x - iX) + (cObj->y - iY) * (cObj->y - iY);
 												// same distance?
 												if ((iDistance == iFartherThan) && !pFindNextCpy)
-													return cObj;
+													return true;
 												// nearer than/first closest?
 												if (!pClosest || (iDistance < iClosest))
 													if (iDistance > iFartherThan)
@@ -1388,12 +1392,29 @@ C4Object *C4Game::FindObject(C4ID id,
 											}
 											// Range
 											else if (Inside<int32_t>(cObj->x - iX, 0, iWdt - 1) && Inside<int32_t>(cObj->y - iY, 0, iHgt - 1))
-												return cObj;
+												return true;
 										}
 
 		// Find next mark reached
 		if (cObj == pFindNextCpy) pFindNext = pFindNextCpy = nullptr;
-	}
+		return false;
+	};
+
+	// Scan indexed objects only
+	C4Object *pFound = nullptr;
+	if (Objects.ForEachCandidate(pDef, pActionTarget, [&](C4Object *cObj)
+	{
+		// Find next mark passed (it need not be a candidate itself)
+		if (pFindNextCpy && pFindNextCpy->ListOrder && (cObj->ListOrder > pFindNextCpy->ListOrder)) pFindNext = pFindNextCpy = nullptr;
+		if (!check(cObj)) return false;
+		pFound = cObj;
+		return true;
+	}))
+		return pFound ? pFound : pClosest;
+
+	// Scan all objects
+	for (cLnk = Objects.First; cLnk && (cObj = cLnk->Obj); cLnk = cLnk->Next)
+		if (check(cObj)) return cObj;
 
 	return pClosest;
 }
@@ -1481,7 +1502,7 @@ int32_t C4Game::ObjectCount(C4ID id,
 	C4Object *pContainer,
 	int32_t iOwner)
 {
-	int32_t iResult = 0; C4Def *pDef;
+	int32_t iResult = 0; C4Def *pDef = nullptr;
 	// check the easy cases first
 	if (id != C4ID_None)
 	{
@@ -1493,7 +1514,9 @@ int32_t C4Game::ObjectCount(C4ID id,
 	}
 	C4Object *cObj; C4ObjectLink *clnk;
 	bool bFindActIdle = SEqual(szAction, "Idle") || SEqual(szAction, "ActIdle");
-	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
+	// Check object; return whether it is counted
+	const auto check = [&](C4Object *cObj) -> bool
+	{
 		// Status
 		if (cObj->Status)
 			// ID
@@ -1514,25 +1537,30 @@ int32_t C4Game::ObjectCount(C4ID id,
 									{
 										// Full range
 										if ((x == 0) && (y == 0) && (wdt == 0) && (hgt == 0))
-										{
-											iResult++; continue;
-										}
+											return true;
 										// Point
 										if ((wdt == 0) && (hgt == 0))
 										{
-											if (Inside<int32_t>(x - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1))
-												if (Inside<int32_t>(y - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1))
-												{
-													iResult++; continue;
-												}
-											continue;
+											return Inside<int32_t>(x - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1)
+												&& Inside<int32_t>(y - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1);
 										}
 										// Range
-										if (Inside<int32_t>(cObj->x - x, 0, wdt - 1) && Inside<int32_t>(cObj->y - y, 0, hgt - 1))
-										{
-											iResult++; continue;
-										}
+										return Inside<int32_t>(cObj->x - x, 0, wdt - 1) && Inside<int32_t>(cObj->y - y, 0, hgt - 1);
 									}
+		return false;
+	};
+
+	// Scan indexed objects only
+	if (Objects.ForEachCandidate(pDef, pActionTarget, [&](C4Object *cObj)
+	{
+		if (check(cObj)) iResult++;
+		return false;
+	}))
+		return iResult;
+
+	// Scan all objects
+	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
+		if (check(cObj)) iResult++;
 
 	return iResult;
 }
@@ -1564,8 +1592,10 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 	for (auto it = Objects.BeginLast(); it != std::default_sentinel; ++it)
 	{
 		if ((*it)->Status)
-			// Execute object
-			(*it)->Execute();
+		{
+			// Execute object unless it is sleeping
+			if (!(*it)->SkipSleepingExecute()) (*it)->Execute();
+		}
 		else
 			// Status reset: process removal delay
 			if ((*it)->RemovalDelay > 0) (*it)->RemovalDelay--;
@@ -1660,6 +1690,7 @@ bool C4Game::EnumerateMaterials()
 
 	// Get hardcoded system material indices
 	MVehic = Material.Get("Vehicle"); MCVehic = Mat2PixColDefault(MVehic);
+	Landscape.UpdateGuard();
 	MTunnel = Material.Get("Tunnel");
 	MWater = Material.Get("Water");
 	MSnow = Material.Get("Snow");
@@ -2247,16 +2278,20 @@ bool C4Game::QuickSave(const char *strFilename, const char *strTitle, bool fForc
 	GraphicsSystem.MessageBoard.EnsureLastMessage();
 
 	// Save to target scenario file
-	C4GameSave *pGameSave;
-	pGameSave = new C4GameSaveSavegame();
-	if (!pGameSave->Save(savePath.c_str()))
+	C4GameSaveSavegame gameSave;
+	if (!gameSave.Save(savePath.c_str()))
 	{
-		Log(C4ResStrTableKey::IDS_GAME_FAILSAVEGAME); delete pGameSave; return false;
+		Log(C4ResStrTableKey::IDS_GAME_FAILSAVEGAME); return false;
 	}
-	delete pGameSave;
 
-	// Success
-	Log(C4ResStrTableKey::IDS_CNS_GAMESAVED);
+	// Compress and write the file while the game continues
+	gameSave.CloseInBackground([](const bool fSuccess)
+	{
+		if (fSuccess)
+			Log(C4ResStrTableKey::IDS_CNS_GAMESAVED);
+		else
+			Log(C4ResStrTableKey::IDS_GAME_FAILSAVEGAME);
+	});
 	return true;
 }
 
@@ -2644,6 +2679,7 @@ bool C4Game::InitGameSecondPart(C4Group &hGroup, C4ScenarioSection *section, boo
 
 	// Pathfinder
 	if (!section) PathFinder.Init(&LandscapeFree, &TransferZones);
+	PathFinder.EnableGraph(C4S.Game.NavigationGraph);
 	SetInitProgress(90);
 
 	// PXS
@@ -3742,11 +3778,13 @@ C4Object *C4Game::FindFriendlyBase(int32_t iPlayer, int32_t iIndex)
 
 C4Object *C4Game::FindObjectByCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int32_t iTy, C4Object *pTarget2, C4Object *pFindNext)
 {
-	C4Object *cObj; C4ObjectLink *clnk;
-	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
+	// Only objects with commands are scanned
+	std::vector<C4Object *> commanders;
+	Objects.GetCommanders(commanders);
+	for (C4Object *cObj : commanders)
 	{
 		// find next
-		if (pFindNext) { if (cObj == pFindNext) pFindNext = nullptr; continue; }
+		if (pFindNext) { if (!pFindNext->ListOrder || (cObj->ListOrder <= pFindNext->ListOrder)) continue; pFindNext = nullptr; }
 		// Status
 		if (cObj->Status)
 			// Check commands
@@ -4085,6 +4123,9 @@ bool C4Game::LoadScenarioSection(const char *szSection, uint32_t dwFlags)
 		return false;
 	}
 
+	// savegames written in background may still read the section temp files
+	C4GameSave::WaitForBackgroundSaves();
+
 	// save current section state
 	if (pLoadSect != pCurrentScenarioSection && dwFlags & (C4S_SAVE_LANDSCAPE | C4S_SAVE_OBJECTS))
 	{
@@ -28,6 +28,8 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+
 C4GameObjects::C4GameObjects()
 {
 	Default();
@@ -43,6 +45,9 @@ void C4GameObjects::Default()
 	ResortProc = nullptr;
 	Sectors.Clear();
 	LastUsedMarker = 0;
+	fListOrderDirty = true;
+	ActionTargetIndex.clear();
+	Commanders.clear();
 }
 
 void C4GameObjects::Init(int32_t iWidth, int32_t iHeight)
@@ -80,6 +85,8 @@ bool C4GameObjects::Remove(C4Object *pObj)
 	Game.BackObjects.Remove(pObj);
 	// remove from forelist
 	Game.ForeObjects.Remove(pObj);
+	// remove from static layer
+	StaticLayer.ClearPointers(pObj);
 	// manipulate main list
 	return C4ObjectList::Remove(pObj);
 }
@@ -330,6 +337,7 @@ void C4GameObjects::Clear(bool fClearInactive)
 		InactiveObjects.Clear();
 	ResortProc = nullptr;
 	LastUsedMarker = 0;
+	StaticLayer.Clear();
 }
 
 /* C4ObjResort */
@@ -503,6 +511,7 @@ void C4ObjResort::Sort(C4ObjectLink *pFirst, C4ObjectLink *pLast)
 				// so there's something to be reordered: swap the links
 				// FIXME: Inform C4ObjectList about this reorder
 				C4Object *pObj = pCurr->Obj; pCurr->Obj = pCurr2->Obj; pCurr2->Obj = pObj;
+				Game.Objects.fListOrderDirty = true;
 				// and readd to sector lists
 				pCurr->Obj->Unsorted = pCurr2->Obj->Unsorted = true;
 				// grow list section to scan next
@@ -645,6 +654,8 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 			else
 				InactiveObjects.First = cLnk;
 			InactiveObjects.Last = cLnk; cLnk->Next = nullptr;
+			cLnk->Obj->ListOrder = 0;
+			cLnk->Obj->Def->SortInstance(cLnk->Obj);
 			Mass -= pObj->Mass;
 		}
 	}
@@ -740,6 +751,8 @@ void C4GameObjects::UpdatePosResort(C4Object *pObj)
 	// Object order for this object was changed. Readd object to sectors
 	Sectors.Remove(pObj);
 	Sectors.Add(pObj, this);
+	// and renumber list order for object indices
+	fListOrderDirty = true;
 }
 
 bool C4GameObjects::OrderObjectBefore(C4Object *pObj1, C4Object *pObj2)
@@ -848,6 +861,7 @@ void C4GameObjects::FixObjectOrder()
 		pLnk0 = pLnk1stUnsorted;
 	}
 	// objects fixed!
+	fListOrderDirty = true;
 }
 
 void C4GameObjects::ResortUnsorted()
@@ -917,3 +931,153 @@ uint32_t C4GameObjects::GetNextMarker()
 	}
 	return marker;
 }
+
+void C4GameObjects::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
+{
+	C4NotifyingObjectList::InsertLinkBefore(pLink, pBefore);
+	AssignListOrder(pLink);
+}
+
+void C4GameObjects::InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter)
+{
+	C4NotifyingObjectList::InsertLink(pLink, pAfter);
+	AssignListOrder(pLink);
+}
+
+void C4GameObjects::RemoveLink(C4ObjectLink *pLnk)
+{
+	C4NotifyingObjectList::RemoveLink(pLnk);
+	pLnk->Obj->ListOrder = 0;
+	if (pLnk->Obj->Def) pLnk->Obj->Def->SortInstance(pLnk->Obj);
+}
+
+void C4GameObjects::AssignListOrder(C4ObjectLink *pLnk)
+{
+	// any nonzero value will do if everything is renumbered anyway
+	pLnk->Obj->ListOrder = 1;
+	if (fListOrderDirty) return;
+	// fit between neighbours
+	const uint64_t iPrev = pLnk->Prev ? pLnk->Prev->Obj->ListOrder : 0;
+	uint64_t iOrder = 0;
+	if (!pLnk->Next)
+	{
+		if (iPrev <= UINT64_MAX - ListOrderSpacing) iOrder = iPrev + ListOrderSpacing;
+	}
+	else
+	{
+		const uint64_t iNext = pLnk->Next->Obj->ListOrder;
+		if (iNext > iPrev + 1) iOrder = iPrev + (iNext - iPrev) / 2;
+	}
+	// no room left
+	if (!iOrder) { fListOrderDirty = true; return; }
+	pLnk->Obj->ListOrder = iOrder;
+	// keep instance list in order
+	if (pLnk->Obj->Def) pLnk->Obj->Def->SortInstance(pLnk->Obj);
+}
+
+void C4GameObjects::UpdateListOrder()
+{
+	if (!fListOrderDirty) return;
+	uint64_t iOrder = 0;
+	for (C4ObjectLink *pLnk = First; pLnk; pLnk = pLnk->Next)
+	{
+		pLnk->Obj->ListOrder = (iOrder += ListOrderSpacing);
+		// rebuild instance lists in the new order
+		if (pLnk->Obj->Def) pLnk->Obj->Def->AppendInstance(pLnk->Obj);
+	}
+	fListOrderDirty = false;
+}
+
+void C4GameObjects::SortByListOrder(std::vector<C4Object *> &rObjects)
+{
+	std::sort(rObjects.begin(), rObjects.end(), [](C4Object *pObj1, C4Object *pObj2) { return pObj1->ListOrder < pObj2->ListOrder; });
+	rObjects.erase(std::unique(rObjects.begin(), rObjects.end()), rObjects.end());
+}
+
+void C4GameObjects::UpdateActionTargets(C4Object *pObj)
+{
+	const std::array<C4Object *, 2> targets{pObj->Action.Target, pObj->Action.Target2};
+	for (size_t i = 0; i < targets.size(); ++i)
+	{
+		C4Object *&rIndexed = pObj->IndexedActionTargets[i];
+		if (rIndexed == targets[i]) continue;
+		if (rIndexed) RemoveActionReferrer(rIndexed, pObj);
+		if (rIndexed = targets[i]) ActionTargetIndex[rIndexed].push_back(pObj);
+	}
+}
+
+void C4GameObjects::RemoveActionReferrer(C4Object *pTarget, C4Object *pObj)
+{
+	const auto it = ActionTargetIndex.find(pTarget);
+	if (it == ActionTargetIndex.end()) return;
+	std::vector<C4Object *> &rReferrers = it->second;
+	if (const auto itObj = std::find(rReferrers.begin(), rReferrers.end(), pObj); itObj != rReferrers.end())
+	{
+		*itObj = rReferrers.back();
+		rReferrers.pop_back();
+	}
+	if (rReferrers.empty()) ActionTargetIndex.erase(it);
+}
+
+void C4GameObjects::UpdateCommands(C4Object *pObj)
+{
+	if (pObj->Command)
+		Commanders.insert(pObj);
+	else
+		Commanders.erase(pObj);
+}
+
+void C4GameObjects::ClearIndices(C4Object *pObj)
+{
+	// object as action referrer
+	for (C4Object *&rIndexed : pObj->IndexedActionTargets)
+		if (rIndexed)
+		{
+			RemoveActionReferrer(rIndexed, pObj);
+			rIndexed = nullptr;
+		}
+	// object as action target
+	if (const auto it = ActionTargetIndex.find(pObj); it != ActionTargetIndex.end())
+	{
+		for (C4Object *pReferrer : it->second)
+			for (C4Object *&rIndexed : pReferrer->IndexedActionTargets)
+				if (rIndexed == pObj) rIndexed = nullptr;
+		ActionTargetIndex.erase(it);
+	}
+	Commanders.erase(pObj);
+}
+
+bool C4GameObjects::ForEachCandidate(C4Def *pDef, C4Object *pActionTarget, const std::function<bool(C4Object *)> &fnCheck)
+{
+	if (!pDef && !pActionTarget) return false;
+	UpdateListOrder();
+	// use the smaller index
+	if (pActionTarget)
+	{
+		const auto it = ActionTargetIndex.find(pActionTarget);
+		if (it == ActionTargetIndex.end()) return true;
+		if (!pDef || it->second.size() <= static_cast<size_t>(pDef->Count))
+		{
+			std::vector<C4Object *> objects;
+			for (C4Object *pObj : it->second)
+				if (pObj->ListOrder) objects.push_back(pObj);
+			SortByListOrder(objects);
+			for (C4Object *pObj : objects)
+				if (fnCheck(pObj)) break;
+			return true;
+		}
+	}
+	// instance lists are kept in list order
+	for (C4Object *pObj = pDef->FirstInstance; pObj; pObj = pObj->NextInstance)
+		if (pObj->ListOrder && fnCheck(pObj)) break;
+	return true;
+}
+
+void C4GameObjects::GetCommanders(std::vector<C4Object *> &rObjects)
+{
+	rObjects.clear();
+	UpdateListOrder();
+	for (C4Object *pObj : Commanders)
+		if (pObj->ListOrder) rObjects.push_back(pObj);
+	SortByListOrder(rObjects);
+}
@@ -22,6 +22,13 @@
 #include <C4ObjectList.h>
 #include <C4FindObject.h>
 #include <C4Sector.h>
+#include <C4StaticLayer.h>
+
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 class C4ObjResort;
 
@@ -36,12 +43,20 @@ public:
 	void Clear(bool fClearInactive = true); // clear objects
 
 private:
+	static constexpr uint64_t ListOrderSpacing = uint64_t{1} << 32; // distance of C4Object::ListOrder values after renumbering
+
 	uint32_t LastUsedMarker; // last used value for C4Object::Marker
+	bool fListOrderDirty; // set if C4Object::ListOrder must be renumbered before use
+
+	// object indices for FindObject and friends; object pointers are removed by ClearIndices before deletion
+	std::unordered_map<C4Object *, std::vector<C4Object *>> ActionTargetIndex; // action target -> objects with it as Action.Target or Action.Target2
+	std::unordered_set<C4Object *> Commanders; // objects with any commands
 
 public:
 	C4LSectors Sectors; // section object lists
 	C4ObjectList InactiveObjects; // inactive objects (Status=2)
 	C4ObjResort *ResortProc; // current sheduled user resorts
+	C4StaticLayer StaticLayer; // offscreen cache for drawing static objects
 
 	bool Add(C4Object *nObj); // add object
 	bool Remove(C4Object *pObj); // clear pointers to object
@@ -81,6 +96,27 @@ public:
 
 	bool ValidateOwners();
 	bool AssignInfo();
+
+	void UpdateActionTargets(C4Object *pObj); // update index after Action.Target or Action.Target2 of pObj have been changed
+	void UpdateCommands(C4Object *pObj); // update index after commands of pObj have been added or cleared
+	void ClearIndices(C4Object *pObj); // remove object to be deleted from all indices
+	// call fnCheck for main list objects of pDef and/or with action target pActionTarget in list order until it returns true; they may not match these criteria
+	// return false if there is no index for the given criteria
+	bool ForEachCandidate(C4Def *pDef, C4Object *pActionTarget, const std::function<bool(C4Object *)> &fnCheck);
+	void GetCommanders(std::vector<C4Object *> &rObjects); // get main list objects that may have commands in list order
+	void UpdateListOrder(); // renumber C4Object::ListOrder if necessary
+
+protected:
+	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore) override;
+	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter) override;
+	virtual void RemoveLink(C4ObjectLink *pLnk) override;
+
+private:
+	void AssignListOrder(C4ObjectLink *pLnk); // assign ListOrder to newly linked object
+	void RemoveActionReferrer(C4Object *pTarget, C4Object *pObj);
+	void SortByListOrder(std::vector<C4Object *> &rObjects);
+
+	friend class C4ObjResort;
 };
 
 class C4AulFunc;
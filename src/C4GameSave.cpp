@@ -19,6 +19,7 @@
 
 #include <C4GameSave.h>
 
+#include <C4Application.h>
 #include <C4Components.h>
 #include <C4Game.h>
 #include "C4Version.h"
@@ -27,12 +28,91 @@
 #include <C4Log.h>
 #include <C4Player.h>
 #include <C4RTF.h>
+#include <C4ThreadPool.h>
+#include <C4Trace.h>
 
+#include <CStdFile.h>
+
+#include <algorithm>
 #include <format>
+#include <latch>
 #include <utility>
 
+// *** C4GameSaveJobs
+
+struct C4GameSaveJobs::Job
+{
+	std::string EntryName;
+	std::string Filename;
+	std::function<bool(const char *)> Write;
+	bool Success{false};
+	std::latch Done{1};
+};
+
+C4GameSaveJobs::~C4GameSaveJobs()
+{
+	for (const auto &job : Jobs)
+	{
+		job->Done.wait();
+		EraseItem(job->Filename.c_str());
+	}
+}
+
+void C4GameSaveJobs::Add(const char *const szEntryName, const char *const szTempName, std::function<bool(const char *)> write)
+{
+	auto job = std::make_shared<Job>();
+	job->EntryName = szEntryName;
+	// reserve the temp file right away, so later jobs with the same name get another one
+	char szFilename[_MAX_PATH + 1];
+	SCopy(Config.AtTempPath(szTempName), szFilename, _MAX_PATH);
+	MakeTempFilename(szFilename);
+	CStdFile hFile;
+	if (hFile.Create(szFilename)) hFile.Close();
+	job->Filename = szFilename;
+	job->Write = std::move(write);
+	Jobs.emplace_back(job);
+
+	C4ThreadPool::Global->SubmitCallback([job]
+	{
+		C4TRACE_ZONE("C4GameSaveJobs::Job");
+		job->Success = job->Write(job->Filename.c_str());
+		job->Write = nullptr;
+		job->Done.count_down();
+	});
+}
+
+bool C4GameSaveJobs::Finish(C4Group &hGroup)
+{
+	bool fSuccess = true;
+	for (const auto &job : Jobs)
+	{
+		job->Done.wait();
+		if (!job->Success || !hGroup.Move(job->Filename.c_str(), job->EntryName.c_str()))
+		{
+			EraseItem(job->Filename.c_str());
+			fSuccess = false;
+		}
+	}
+	Jobs.clear();
+	return fSuccess;
+}
+
 // *** C4GameSave main class
 
+namespace
+{
+	struct BackgroundSave
+	{
+		std::unique_ptr<C4Group> Group;
+		C4GameSaveJobs Jobs;
+		std::string SortOrder;
+		bool Success{false};
+		std::latch Done{1};
+	};
+
+	std::vector<std::shared_ptr<BackgroundSave>> BackgroundSaves; // main thread only
+}
+
 bool C4GameSave::SaveCreateGroup(const char *szFilename, C4Group &hUseGroup)
 {
 	// erase any previous item (2do: work in C4Groups?)
@@ -146,7 +226,7 @@ bool C4GameSave::SaveLandscape()
 		Game.Objects.RemoveSolidMasks();
 		bool fSuccess;
 		if (Game.Landscape.Mode == C4LSC_Exact)
-			fSuccess = !!Game.Landscape.Save(*pSaveGroup);
+			fSuccess = !!Game.Landscape.Save(*pSaveGroup, &Jobs);
 		else
 			fSuccess = !!Game.Landscape.SaveDiff(*pSaveGroup, !IsSynced());
 		Game.Objects.PutSolidMasks();
@@ -450,6 +530,8 @@ bool C4GameSave::Save(const char *szFilename)
 {
 	// close any previous
 	Close();
+	// the target might still be written in background
+	WaitForBackgroundSaves();
 	// create group
 	C4Group *pLSaveGroup = new C4Group();
 	if (!SaveCreateGroup(szFilename, *pLSaveGroup))
@@ -506,13 +588,15 @@ bool C4GameSave::Close()
 	// any group open?
 	if (pSaveGroup)
 	{
+		// add components still being encoded
+		if (!Jobs.Finish(*pSaveGroup)) fSuccess = false;
 		// sort group
 		const char *szSortOrder = GetSortOrder();
 		if (szSortOrder) pSaveGroup->Sort(szSortOrder);
 		// close if owned group
 		if (fOwnGroup)
 		{
-			fSuccess = !!pSaveGroup->Close();
+			fSuccess = pSaveGroup->Close() && fSuccess;
 			delete pSaveGroup;
 			fOwnGroup = false;
 		}
@@ -521,6 +605,49 @@ bool C4GameSave::Close()
 	return fSuccess;
 }
 
+void C4GameSave::CloseInBackground(std::function<void(bool)> fnDone)
+{
+	// groups not owned by the save are still used by the caller
+	if (!pSaveGroup || !fOwnGroup)
+	{
+		fnDone(Close());
+		return;
+	}
+	auto save = std::make_shared<BackgroundSave>();
+	save->Group.reset(pSaveGroup);
+	save->Jobs = std::move(Jobs);
+	if (const char *const szSortOrder = GetSortOrder()) save->SortOrder = szSortOrder;
+	pSaveGroup = nullptr; fOwnGroup = false;
+	BackgroundSaves.emplace_back(save);
+
+	C4ThreadPool::Global->SubmitCallback([save, fnDone{std::move(fnDone)}]() mutable
+	{
+		{
+			C4TRACE_ZONE("C4GameSave::CloseInBackground");
+			save->Success = save->Jobs.Finish(*save->Group);
+			if (!save->SortOrder.empty()) save->Group->Sort(save->SortOrder.c_str());
+			save->Success = save->Group->Close() && save->Success;
+			save->Group.reset();
+		}
+		Application.InteractiveThread.ExecuteInMainThread([save, fnDone{std::move(fnDone)}]
+		{
+			std::erase(BackgroundSaves, save);
+			fnDone(save->Success);
+		});
+		// last access of this thread: WaitForBackgroundSaves may return and the application may shut down after this
+		save->Done.count_down();
+	});
+}
+
+void C4GameSave::WaitForBackgroundSaves()
+{
+	for (const auto &save : BackgroundSaves)
+	{
+		save->Done.wait();
+	}
+	BackgroundSaves.clear();
+}
+
 // *** C4GameSaveSavegame
 
 bool C4GameSaveSavegame::OnSaving()
@@ -31,6 +31,31 @@
 #include <C4Group.h>
 #include <C4Components.h>
 
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Components encoded on the thread pool while the rest of the game is being saved.
+// Every job writes a temp file, which is moved into the save group when the jobs are finished.
+class C4GameSaveJobs
+{
+public:
+	struct Job;
+
+	C4GameSaveJobs() = default;
+	C4GameSaveJobs(C4GameSaveJobs &&) = default;
+	C4GameSaveJobs &operator=(C4GameSaveJobs &&) = default;
+	~C4GameSaveJobs(); // waits for unfinished jobs and erases their files
+
+	// start writing entry szEntryName to a temp file named after szTempName; write must not access game data
+	void Add(const char *szEntryName, const char *szTempName, std::function<bool(const char *szFilename)> write);
+	bool Finish(C4Group &hGroup); // wait for all jobs and move their files into hGroup
+
+private:
+	std::vector<std::shared_ptr<Job>> Jobs;
+};
+
 class C4GameSave
 {
 private:
@@ -39,6 +64,7 @@ private:
 protected:
 	C4Group *pSaveGroup; // group file written to
 	bool fOwnGroup; // whether group file is owned
+	C4GameSaveJobs Jobs; // components still being encoded into pSaveGroup
 
 	// if set, the game is saved at initial (pre-frame0) state
 	// (lobby-dynamics, initial records and network references)
@@ -110,6 +136,10 @@ public:
 	bool Save(C4Group &hToGroup, bool fKeepGroup); // save game directly to target group
 	bool SaveDesc(C4Group &hToGroup); // save scenario desc to file
 	bool Close(); // close scenario group
+	// finish encoding, sort and close the owned group on the thread pool while the game continues
+	// fnDone is called in the main thread afterwards
+	void CloseInBackground(std::function<void(bool fSuccess)> fnDone);
+	static void WaitForBackgroundSaves(); // block until all groups closed in background are written
 
 	C4Group *GetGroup() { return pSaveGroup; } // get scenario saving group; only open between calls to Save() and Close()
 };
@@ -30,6 +30,7 @@
 #include <C4Player.h>
 #include <C4Object.h>
 #include <C4SoundSystem.h>
+#include <C4Trace.h>
 
 #include <StdBitmap.h>
 #include <StdPNG.h>
@@ -116,6 +117,8 @@ void C4GraphicsSystem::FinishDrawing()
 
 void C4GraphicsSystem::Execute()
 {
+	C4TRACE_ZONE("C4GraphicsSystem::Execute");
+
 	// activity check
 	if (!StartDrawing()) return;
 
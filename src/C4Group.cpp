@@ -22,6 +22,7 @@
 
 #include <C4Components.h>
 #include <C4InputValidation.h>
+#include <C4Trace.h>
 #include "StdConfig.h"
 
 #ifdef C4ENGINE
@@ -664,6 +665,8 @@ void C4Group::SetStdOutput(bool fStatus)
 
 bool C4Group::Open(const char *szGroupName, bool fCreate)
 {
+	C4TRACE_ZONE("C4Group::Open");
+
 	if (!szGroupName) return Error("Open: Null filename");
 	if (!szGroupName[0]) return Error("Open: Empty filename");
 
@@ -963,6 +966,8 @@ bool C4Group::Close()
 
 bool C4Group::Save(bool fReOpen)
 {
+	C4TRACE_ZONE("C4Group::Save");
+
 	int cscore;
 	C4GroupEntryCore *save_core;
 	C4GroupEntry *centry;
@@ -2212,6 +2217,8 @@ uint32_t C4Group::EntryTime(const char *szFilename)
 
 bool C4Group::LoadEntry(const char *szEntryName, char **lpbpBuf, size_t *ipSize, int iAppendZeros)
 {
+	C4TRACE_ZONE("C4Group::LoadEntry");
+
 	size_t size;
 
 	// Access entry, allocate buffer, read data
@@ -2234,6 +2241,8 @@ bool C4Group::LoadEntry(const char *szEntryName, char **lpbpBuf, size_t *ipSize,
 
 bool C4Group::LoadEntry(const char *szEntryName, StdBuf &Buf)
 {
+	C4TRACE_ZONE("C4Group::LoadEntry");
+
 	size_t size;
 	// Access entry, allocate buffer, read data
 	if (!AccessEntry(szEntryName, &size)) return Error("LoadEntry: Not found");
@@ -2251,6 +2260,8 @@ bool C4Group::LoadEntry(const char *szEntryName, StdBuf &Buf)
 
 bool C4Group::LoadEntryString(const char *szEntryName, StdStrBuf &Buf)
 {
+	C4TRACE_ZONE("C4Group::LoadEntryString");
+
 	size_t size;
 	// Access entry, allocate buffer, read data
 	if (!AccessEntry(szEntryName, &size)) return Error("LoadEntry: Not found");
@@ -33,16 +33,20 @@
 #endif
 #include <C4Material.h>
 #include <C4Game.h>
+#include <C4GameSave.h>
 #include <C4Application.h>
 #include <C4Wrappers.h>
 
 #include <StdBitmap.h>
 #include <StdPNG.h>
 
+#include <bit>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 int32_t MVehic = MNone, MTunnel = MNone, MWater = MNone, MSnow = MNone, MEarth = MNone, MGranite = MNone;
 uint8_t MCVehic = 0;
@@ -71,6 +75,7 @@ void C4Landscape::ScenarioInit()
 	BottomOpen = Game.C4S.Landscape.BottomOpen;
 	// Side open scan
 	if (Game.C4S.Landscape.AutoScanSideOpen) ScanSideOpen();
+	UpdateGuard();
 }
 
 void C4Landscape::Execute()
@@ -235,6 +240,39 @@ void C4Landscape::ScanSideOpen()
 	LeftOpen = cy;
 	for (cy = 0; (cy < Height) && !GetPix(Width - 1, cy); cy++);
 	RightOpen = cy;
+	UpdateGuard();
+}
+
+uint8_t C4Landscape::GetBorderPix(int32_t x, int32_t y)
+{
+	// Border checks
+	if (x < 0) return y < LeftOpen ? 0 : MCVehic;
+	if (x >= Width) return y < RightOpen ? 0 : MCVehic;
+	if (y < 0) return TopOpen ? 0 : MCVehic;
+	if (y >= Height) return BottomOpen ? 0 : MCVehic;
+	return Surface8->_GetPix(x, y);
+}
+
+void C4Landscape::UpdateGuard()
+{
+	GuardWidth = 0;
+	if (!Surface8) return;
+	if (Surface8->Guard != C4LS_GuardWidth && !Surface8->SetGuard(C4LS_GuardWidth)) return;
+	// fill the border with what GetPix returns outside the landscape
+	const auto fillRow = [this](int32_t x1, int32_t x2, int32_t y)
+	{
+		for (int32_t x = x1; x < x2; ++x)
+			Surface8->Bits[y * Surface8->Pitch + x] = GetBorderPix(x, y);
+	};
+	for (int32_t y = -C4LS_GuardWidth; y < Height + C4LS_GuardWidth; ++y)
+		if (y < 0 || y >= Height)
+			fillRow(-C4LS_GuardWidth, Width + C4LS_GuardWidth, y);
+		else
+		{
+			fillRow(-C4LS_GuardWidth, 0, y);
+			fillRow(Width, Width + C4LS_GuardWidth, y);
+		}
+	GuardWidth = C4LS_GuardWidth;
 }
 
 void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
@@ -246,6 +284,7 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	delete Surface32;        Surface32        = nullptr;
 	delete AnimationSurface; AnimationSurface = nullptr;
 	delete Surface8;         Surface8         = nullptr;
+	GuardWidth = 0;
 	delete Map;              Map              = nullptr;
 	// clear initial landscape
 	delete[] pInitial;       pInitial         = nullptr;
@@ -255,6 +294,10 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	// clear pixel count
 	delete[] PixCnt;         PixCnt           = nullptr;
 	PixCntPitch = 0;
+	delete[] PixCntTile;     PixCntTile       = nullptr;
+	PixCntTilePitch = 0;
+	delete[] MatRunBreaks;   MatRunBreaks     = nullptr;
+	MatRunBreaksPitch = 0;
 }
 
 void C4Landscape::Draw(C4FacetEx &cgo, int32_t iPlayer)
@@ -710,12 +753,19 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	AddDbgRec(RCT_Ls, Surface8->Bits, Surface8->Pitch * Surface8->Hgt);
 #endif
 
+	// Add the border for bounds checked pixel reads
+	UpdateGuard();
+
 	// Create pixel count array
 	// We will use 15x17 blocks so the pixel count can't get over 255.
 	int32_t PixCntWidth = (Width + 16) / 17;
 	PixCntPitch = (Height + 14) / 15;
-	PixCnt = new uint8_t[PixCntWidth * PixCntPitch];
+	PixCnt = new uint8_t[PixCntWidth * PixCntPitch]{};
+	// The tiles count the non-empty blocks, so large empty areas can be skipped at once.
+	PixCntTilePitch = (PixCntPitch + C4LS_PixCntTileSize - 1) / C4LS_PixCntTileSize;
+	PixCntTile = new uint8_t[(PixCntWidth + C4LS_PixCntTileSize - 1) / C4LS_PixCntTileSize * PixCntTilePitch]{};
 	UpdatePixCnt(C4Rect(0, 0, Width, Height));
+	InitMatRuns();
 	ClearMatCount();
 	UpdateMatCnt(C4Rect(0, 0, Width, Height), true);
 
@@ -729,6 +779,16 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	// enforce first color to be transparent
 	Surface8->EnforceC0Transparency();
 
+	// further changes are uploaded once per frame
+	if (Config.Graphics.StreamLandscape)
+	{
+		Surface32->SetStreamed(true);
+		if (AnimationSurface) AnimationSurface->SetStreamed(true);
+	}
+
+	// drop any navigation graph of the previous landscape
+	Game.PathFinder.InvalidateLandscape();
+
 	// after map/landscape creation, the seed must be fixed again, so there's no difference between clients creating
 	// and not creating the map
 	Game.FixRandom(Game.Parameters.RandomSeed);
@@ -752,15 +812,41 @@ bool C4Landscape::SetPix(int32_t x, int32_t y, uint8_t npix)
 	if (npix == _GetPix(x, y))
 		return true;
 	// note for relight
-	C4Rect CheckRect(x - 2 * C4LS_MaxLightDistX, y - 2 * C4LS_MaxLightDistY, 4 * C4LS_MaxLightDistX + 1, 4 * C4LS_MaxLightDistY + 1);
+	if (ChangeBatchDepth)
+		ChangeBatchRelight.Add(C4Rect(x, y, 1, 1));
+	else
+		QueueRelight(C4Rect(x, y, 1, 1));
+	// set pixel
+	return _SetPix(x, y, npix);
+}
+
+void C4Landscape::QueueRelight(const C4Rect &Rect)
+{
+	C4Rect CheckRect(Rect.x - 2 * C4LS_MaxLightDistX, Rect.y - 2 * C4LS_MaxLightDistY, Rect.Wdt + 4 * C4LS_MaxLightDistX, Rect.Hgt + 4 * C4LS_MaxLightDistY);
 	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
 		if (!Relights[i].Wdt || Relights[i].Overlap(CheckRect) || i + 1 >= C4LS_MaxRelights)
 		{
-			Relights[i].Add(C4Rect(x, y, 1, 1));
+			Relights[i].Add(Rect);
 			break;
 		}
-	// set pixel
-	return _SetPix(x, y, npix);
+}
+
+void C4Landscape::EndChangeBatch()
+{
+	assert(ChangeBatchDepth > 0);
+	if (--ChangeBatchDepth) return;
+	// relighting only updates the surfaces, so it doesn't matter for the game that it is queued late
+	if (ChangeBatchRelight.Wdt)
+	{
+		QueueRelight(ChangeBatchRelight);
+		ChangeBatchRelight.Default();
+	}
+	// invalidating the sectors of the bounding rectangle may rebuild unchanged sectors, which yields the same graph
+	if (ChangeBatchNavigation.Wdt)
+	{
+		Game.PathFinder.InvalidateLandscape(ChangeBatchNavigation);
+		ChangeBatchNavigation.Default();
+	}
 }
 
 bool C4Landscape::SetPixDw(int32_t x, int32_t y, uint32_t dwPix)
@@ -789,11 +875,13 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	// count pixels
 	if (Pix2Dens[npix])
 	{
-		if (!Pix2Dens[opix]) PixCnt[(y / 15) + (x / 17) * PixCntPitch]++;
+		if (!Pix2Dens[opix] && !PixCnt[(y / 15) + (x / 17) * PixCntPitch]++)
+			PixCntTile[(y / 15 / C4LS_PixCntTileSize) + (x / 17 / C4LS_PixCntTileSize) * PixCntTilePitch]++;
 	}
 	else
 	{
-		if (Pix2Dens[opix]) PixCnt[(y / 15) + (x / 17) * PixCntPitch]--;
+		if (Pix2Dens[opix] && !--PixCnt[(y / 15) + (x / 17) * PixCntPitch])
+			PixCntTile[(y / 15 / C4LS_PixCntTileSize) + (x / 17 / C4LS_PixCntTileSize) * PixCntTilePitch]--;
 	}
 
 	// count material
@@ -809,8 +897,8 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 			{
 				// Check for material above & below
 				int iMinHeight = Game.Material.Map[nmat].MinHeightCount,
-					iBelow = GetMatHeight(x, y + 1, +1, nmat, iMinHeight),
-					iAbove = GetMatHeight(x, y - 1, -1, nmat, iMinHeight);
+					iBelow = GetEffectiveMatHeight(x, y + 1, +1, nmat, iMinHeight),
+					iAbove = GetEffectiveMatHeight(x, y - 1, -1, nmat, iMinHeight);
 				// Will be above treshold?
 				if (iBelow + iAbove + 1 >= iMinHeight)
 				{
@@ -826,8 +914,8 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 			{
 				// Check for material above & below
 				int iMinHeight = Game.Material.Map[omat].MinHeightCount,
-					iBelow = GetMatHeight(x, y + 1, +1, omat, iMinHeight),
-					iAbove = GetMatHeight(x, y - 1, -1, omat, iMinHeight);
+					iBelow = GetEffectiveMatHeight(x, y + 1, +1, omat, iMinHeight),
+					iAbove = GetEffectiveMatHeight(x, y - 1, -1, omat, iMinHeight);
 				// Not already below threshold?
 				if (iBelow + iAbove + 1 >= iMinHeight)
 				{
@@ -844,6 +932,13 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 
 	// set 8bpp-surface only!
 	Surface8->SetPix(x, y, npix);
+	// material runs
+	if (MatRunBreaks && Pix2Mat[opix] != Pix2Mat[npix]) UpdateMatRunBreaks(x, y);
+	// navigation graph
+	if (ChangeBatchDepth)
+		ChangeBatchNavigation.Add(C4Rect(x, y, 1, 1));
+	else
+		Game.PathFinder.InvalidateLandscape(x, y);
 	// success
 	return true;
 }
@@ -859,10 +954,8 @@ bool C4Landscape::_SetPixIfMask(int32_t x, int32_t y, uint8_t npix, uint8_t nMas
 
 bool C4Landscape::CheckInstability(int32_t tx, int32_t ty)
 {
-	int32_t mat = GetMat(tx, ty);
-	if (MatValid(mat))
-		if (Game.Material.Map[mat].Instable)
-			return Game.MassMover.Create(tx, ty);
+	if (Pix2Free[GetPix(tx, ty)] & C4LS_PixInstable)
+		return Game.MassMover.Create(tx, ty);
 	return false;
 }
 
@@ -914,6 +1007,27 @@ bool C4Landscape::_PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2)
 	return !PixCnt[x * PixCntPitch + y];
 }
 
+bool C4Landscape::_AreaFree(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+	if (x1 > x2) std::swap(x1, x2);
+	if (y1 > y2) std::swap(y1, y2);
+	// outside the landscape, the border pixels would have to be checked
+	if (!PixCnt || x1 < 0 || y1 < 0 || x2 >= Width || y2 >= Height) return false;
+	x1 /= 17; y1 /= 15; x2 /= 17; y2 /= 15;
+	for (int32_t tx = x1 / C4LS_PixCntTileSize; tx <= x2 / C4LS_PixCntTileSize; ++tx)
+		for (int32_t ty = y1 / C4LS_PixCntTileSize; ty <= y2 / C4LS_PixCntTileSize; ++ty)
+		{
+			// empty tile?
+			if (!PixCntTile[tx * PixCntTilePitch + ty]) continue;
+			// check the blocks of the tile inside the rectangle
+			for (int32_t x = std::max(x1, tx * C4LS_PixCntTileSize); x <= std::min(x2, tx * C4LS_PixCntTileSize + C4LS_PixCntTileSize - 1); ++x)
+				for (int32_t y = std::max(y1, ty * C4LS_PixCntTileSize); y <= std::min(y2, ty * C4LS_PixCntTileSize + C4LS_PixCntTileSize - 1); ++y)
+					if (PixCnt[x * PixCntPitch + y])
+						return false;
+		}
+	return true;
+}
+
 int32_t C4Landscape::GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax)
 {
 	if (iYDir > 0)
@@ -933,44 +1047,157 @@ int32_t C4Landscape::GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t i
 	return iMax;
 }
 
+void C4Landscape::InitMatRuns()
+{
+	delete[] MatRunBreaks; MatRunBreaks = nullptr;
+	MatRunBreaksPitch = 0;
+	// only needed for effective material counting
+	bool fNeeded = false;
+	for (int32_t iMat = 0; iMat < Game.Material.Num; iMat++)
+		if (Game.Material.Map[iMat].MinHeightCount)
+			fNeeded = true;
+	if (!fNeeded) return;
+	MatRunBreaksPitch = Height / 64 + 1;
+	MatRunBreaks = new uint64_t[Width * MatRunBreaksPitch]{};
+	UpdateMatRuns(C4Rect(0, 0, Width, Height));
+}
+
+void C4Landscape::UpdateMatRuns(C4Rect Rect)
+{
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	if (!Rect.Wdt || !Rect.Hgt) return;
+	// the break below the last row depends on the rect as well
+	const int32_t y1 = Rect.y, y2 = std::min(Rect.y + Rect.Hgt + 1, Height);
+	for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
+	{
+		uint64_t *const pColumn = MatRunBreaks + x * MatRunBreaksPitch;
+		int32_t iLastMat = y1 ? _GetMat(x, y1 - 1) : MNone;
+		for (int32_t y = y1; y < y2; y++)
+		{
+			const int32_t iMat = _GetMat(x, y);
+			const uint64_t dwBit = uint64_t{1} << (y & 63);
+			if (!y || iMat != iLastMat)
+				pColumn[y >> 6] |= dwBit;
+			else
+				pColumn[y >> 6] &= ~dwBit;
+			iLastMat = iMat;
+		}
+		pColumn[Height >> 6] |= uint64_t{1} << (Height & 63);
+	}
+}
+
+void C4Landscape::UpdateMatRunBreaks(int32_t x, int32_t y)
+{
+	uint64_t *const pColumn = MatRunBreaks + x * MatRunBreaksPitch;
+	const int32_t iMat = _GetMat(x, y);
+	const auto setBreak = [pColumn](const int32_t iY, const bool fBreak)
+	{
+		const uint64_t dwBit = uint64_t{1} << (iY & 63);
+		if (fBreak) pColumn[iY >> 6] |= dwBit; else pColumn[iY >> 6] &= ~dwBit;
+	};
+	if (y > 0) setBreak(y, _GetMat(x, y - 1) != iMat);
+	if (y + 1 < Height) setBreak(y + 1, _GetMat(x, y + 1) != iMat);
+}
+
+int32_t C4Landscape::GetMatRunHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax)
+{
+	const uint64_t *const pColumn = MatRunBreaks + x * MatRunBreaksPitch;
+	if (iYDir > 0)
+	{
+		iMax = std::min<int32_t>(iMax, Height - y);
+		if (iMax <= 0) return iMax;
+		if (_GetMat(x, y) != iMat) return 0;
+		// next break below y
+		int32_t iWord = (y + 1) >> 6;
+		uint64_t dwBits = pColumn[iWord] & (~uint64_t{0} << ((y + 1) & 63));
+		while (!dwBits)
+		{
+			if ((++iWord << 6) - y >= iMax) return iMax;
+			dwBits = pColumn[iWord];
+		}
+		return std::min<int32_t>((iWord << 6) + std::countr_zero(dwBits) - y, iMax);
+	}
+	else
+	{
+		iMax = std::min<int32_t>(iMax, y + 1);
+		if (iMax <= 0) return iMax;
+		if (_GetMat(x, y) != iMat) return 0;
+		// break at or above y
+		int32_t iWord = y >> 6;
+		uint64_t dwBits = pColumn[iWord] & (~uint64_t{0} >> (63 - (y & 63)));
+		while (!dwBits)
+		{
+			if (y - (iWord << 6) + 2 >= iMax) return iMax;
+			dwBits = pColumn[--iWord];
+		}
+		return std::min<int32_t>(y - ((iWord << 6) + 63 - std::countl_zero(dwBits)) + 1, iMax);
+	}
+}
+
+int32_t C4Landscape::GetEffectiveMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax)
+{
+	if (!MatRunBreaks) return GetMatHeight(x, y, iYDir, iMat, iMax);
+	const int32_t iHeight = GetMatRunHeight(x, y, iYDir, iMat, iMax);
+	// Verification: compare with the scan and continue with its result, so the game stays in sync
+	if (Config.Developer.VerifyMatRuns)
+	{
+		const int32_t iScanned = GetMatHeight(x, y, iYDir, iMat, iMax);
+		if (iScanned != iHeight)
+		{
+			LogNTr(spdlog::level::warn, "Material run verification failed: height {} instead of {} at {}/{} in direction {} in frame {}", iHeight, iScanned, x, y, iYDir, Game.FrameCounter);
+			return iScanned;
+		}
+	}
+	return iHeight;
+}
+
 int32_t C4Landscape::DigFreePix(int32_t tx, int32_t ty)
 {
-	int32_t mat = GetMat(tx, ty);
-	if (mat != MNone)
-		if (Game.Material.Map[mat].DigFree)
-			ClearPix(tx, ty);
+	return DigFreePix(tx, ty, GetPix(tx, ty));
+}
+
+int32_t C4Landscape::DigFreePix(int32_t tx, int32_t ty, uint8_t pix)
+{
+	if (Pix2Free[pix] & C4LS_PixDigFree)
+		ClearPix(tx, ty);
 	CheckInstabilityRange(tx, ty);
-	return mat;
+	return Pix2Mat[pix];
 }
 
 int32_t C4Landscape::ShakeFreePix(int32_t tx, int32_t ty)
 {
-	int32_t mat = GetMat(tx, ty);
-	if (mat != MNone)
-		if (Game.Material.Map[mat].DigFree)
-		{
-			ClearPix(tx, ty);
-			Game.PXS.Create(mat, itofix(tx), itofix(ty));
-		}
+	return ShakeFreePix(tx, ty, GetPix(tx, ty));
+}
+
+int32_t C4Landscape::ShakeFreePix(int32_t tx, int32_t ty, uint8_t pix)
+{
+	int32_t mat = Pix2Mat[pix];
+	if (Pix2Free[pix] & C4LS_PixDigFree)
+	{
+		ClearPix(tx, ty);
+		Game.PXS.Create(mat, itofix(tx), itofix(ty));
+	}
 	CheckInstabilityRange(tx, ty);
 	return mat;
 }
 
 int32_t C4Landscape::BlastFreePix(int32_t tx, int32_t ty, int32_t grade, int32_t iBlastSize)
 {
-	int32_t mat = GetMat(tx, ty);
-	if (MatValid(mat))
+	return BlastFreePix(tx, ty, grade, iBlastSize, GetPix(tx, ty));
+}
+
+int32_t C4Landscape::BlastFreePix(int32_t tx, int32_t ty, int32_t grade, int32_t iBlastSize, uint8_t pix)
+{
+	int32_t mat = Pix2Mat[pix];
+	// Blast Shift
+	if (Pix2Free[pix] & C4LS_PixBlastShift)
 	{
-		// Blast Shift
-		if (Game.Material.Map[mat].BlastShiftTo)
-		{
-			// blast free amount; always blast if 100% is to be blasted away
-			if (Random(BlastMatCount[mat]) < iBlastSize * grade / 6)
-				SetPix(tx, ty, MatTex2PixCol(Game.Material.Map[mat].BlastShiftTo) + GBackIFT(tx, ty));
-		}
-		// Blast Free
-		if (Game.Material.Map[mat].BlastFree) ClearPix(tx, ty);
+		// blast free amount; always blast if 100% is to be blasted away
+		if (Random(BlastMatCount[mat]) < iBlastSize * grade / 6)
+			SetPix(tx, ty, MatTex2PixCol(Game.Material.Map[mat].BlastShiftTo) + GBackIFT(tx, ty));
 	}
+	// Blast Free
+	if (Pix2Free[pix] & C4LS_PixBlastFree) ClearPix(tx, ty);
 
 	CheckInstabilityRange(tx, ty);
 
@@ -979,23 +1206,32 @@ int32_t C4Landscape::BlastFreePix(int32_t tx, int32_t ty, int32_t grade, int32_t
 
 void C4Landscape::DigFree(int32_t tx, int32_t ty, int32_t rad, bool fRequest, C4Object *pByObj)
 {
-	int32_t ycnt, xcnt, iLineWidth, iLineY, iMaterial;
-	// Dig free
-	for (ycnt = -rad; ycnt < rad; ycnt++)
+	int32_t ycnt, xcnt, iLineWidth, iLineY;
+	// Dig free; the dug material is handed to the digging object at once
+	int32_t iDugMat[C4MaxMaterial]{};
 	{
-		iLineWidth = static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt)));
-		iLineY = ty + ycnt;
+		C4LandscapeChangeBatch batch{*this};
+		for (ycnt = -rad; ycnt < rad; ycnt++)
+		{
+			iLineWidth = CircleRowHalfWidth(rad, ycnt);
+			iLineY = ty + ycnt;
+			ForRowSpan(tx - iLineWidth, tx + iLineWidth + (iLineWidth == 0), iLineY, [this, iLineY, &iDugMat](const int32_t x, const uint8_t pix)
+			{
+				const int32_t iMaterial{DigFreePix(x, iLineY, pix)};
+				if (MatValid(iMaterial)) ++iDugMat[iMaterial];
+			});
+			// Clear single pixels - left and right
+			DigFreeSinglePix(tx - iLineWidth - 1, iLineY, -1, 0);
+			DigFreeSinglePix(tx + iLineWidth + (iLineWidth == 0), iLineY, +1, 0);
+		}
+		// Clear single pixels - up and down
+		DigFreeSinglePix(tx, ty - rad - 1, 0, -1);
 		for (xcnt = -iLineWidth; xcnt < iLineWidth + (iLineWidth == 0); xcnt++)
-			if (MatValid(iMaterial = DigFreePix(tx + xcnt, iLineY)))
-				if (pByObj) pByObj->AddMaterialContents(iMaterial, 1);
-		// Clear single pixels - left and right
-		DigFreeSinglePix(tx - iLineWidth - 1, iLineY, -1, 0);
-		DigFreeSinglePix(tx + iLineWidth + (iLineWidth == 0), iLineY, +1, 0);
-	}
-	// Clear single pixels - up and down
-	DigFreeSinglePix(tx, ty - rad - 1, 0, -1);
-	for (xcnt = -iLineWidth; xcnt < iLineWidth + (iLineWidth == 0); xcnt++)
-		DigFreeSinglePix(tx + xcnt, ty + rad, 0, +1);
+			DigFreeSinglePix(tx + xcnt, ty + rad, 0, +1);
+	}
+	if (pByObj)
+		for (int32_t iMaterial = 0; iMaterial < Game.Material.Num; iMaterial++)
+			if (iDugMat[iMaterial]) pByObj->AddMaterialContents(iMaterial, iDugMat[iMaterial]);
 	// Dig out material cast
 	if (!Tick5) if (pByObj) pByObj->DigOutMaterialCast(fRequest);
 }
@@ -1004,10 +1240,13 @@ void C4Landscape::DigFreeRect(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt,
 {
 	// Dig free pixels
 	int32_t cx, cy, iMaterial;
-	for (cx = tx; cx < tx + wdt; cx++)
-		for (cy = ty; cy < ty + hgt; cy++)
-			if (MatValid(iMaterial = DigFreePix(cx, cy)))
-				if (pByObj) pByObj->AddMaterialContents(iMaterial, 1);
+	{
+		C4LandscapeChangeBatch batch{*this};
+		for (cx = tx; cx < tx + wdt; cx++)
+			for (cy = ty; cy < ty + hgt; cy++)
+				if (MatValid(iMaterial = DigFreePix(cx, cy)))
+					if (pByObj) pByObj->AddMaterialContents(iMaterial, 1);
+	}
 	// Clear single pixels
 
 	// Dig out material cast
@@ -1016,20 +1255,21 @@ void C4Landscape::DigFreeRect(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt,
 
 void C4Landscape::ShakeFree(int32_t tx, int32_t ty, int32_t rad)
 {
-	int32_t ycnt, xcnt, lwdt, dpy;
+	int32_t ycnt, lwdt, dpy;
+	C4LandscapeChangeBatch batch{*this};
 	// Shake free pixels
 	for (ycnt = rad - 1; ycnt >= -rad; ycnt--)
 	{
-		lwdt = static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt)));
+		lwdt = CircleRowHalfWidth(rad, ycnt);
 		dpy = ty + ycnt;
-		for (xcnt = -lwdt; xcnt < lwdt + (lwdt == 0); xcnt++)
-			ShakeFreePix(tx + xcnt, dpy);
+		ForRowSpan(tx - lwdt, tx + lwdt + (lwdt == 0), dpy, [this, dpy](const int32_t x, const uint8_t pix) { ShakeFreePix(x, dpy, pix); });
 	}
 }
 
 void C4Landscape::DigFreeMat(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mat)
 {
 	int32_t cx, cy;
+	C4LandscapeChangeBatch batch{*this};
 	if (MatValid(mat))
 		for (cx = tx; cx < tx + wdt; cx++)
 			for (cy = ty; cy < ty + hgt; cy++)
@@ -1039,27 +1279,32 @@ void C4Landscape::DigFreeMat(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, i
 
 void C4Landscape::BlastFree(int32_t tx, int32_t ty, int32_t rad, int32_t grade, int32_t iByPlayer)
 {
-	int32_t ycnt, xcnt, lwdt, dpy, mat, cnt;
+	int32_t ycnt, lwdt, dpy, cnt;
 
 	// Reset material count
 	ClearBlastMatCount();
 
 	// Blast free pixels
 	// count pixel before, so BlastShiftTo can be evaluated
+	// pixel values are counted first and mapped to their materials afterwards
+	int32_t iPixCount[256]{};
 	for (ycnt = -rad; ycnt <= rad; ycnt++)
 	{
-		lwdt = static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt))); dpy = ty + ycnt;
-		for (xcnt = -lwdt; xcnt < lwdt + (lwdt == 0); xcnt++)
-			if (MatValid(mat = GetMat(tx + xcnt, dpy)))
-				BlastMatCount[mat]++;
+		lwdt = CircleRowHalfWidth(rad, ycnt); dpy = ty + ycnt;
+		ForRowSpan(tx - lwdt, tx + lwdt + (lwdt == 0), dpy, [&iPixCount](int32_t, const uint8_t pix) { ++iPixCount[pix]; });
 	}
+	for (cnt = 0; cnt < 256; cnt++)
+		if (iPixCount[cnt] && MatValid(Pix2Mat[cnt]))
+			BlastMatCount[Pix2Mat[cnt]] += iPixCount[cnt];
 	// blast pixels
 	int32_t iBlastSize = rad * rad * 6283 / 2000; // rad^2 * pi
-	for (ycnt = -rad; ycnt <= rad; ycnt++)
 	{
-		lwdt = static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt))); dpy = ty + ycnt;
-		for (xcnt = -lwdt; xcnt < lwdt + (lwdt == 0); xcnt++)
-			BlastFreePix(tx + xcnt, dpy, grade, iBlastSize);
+		C4LandscapeChangeBatch batch{*this};
+		for (ycnt = -rad; ycnt <= rad; ycnt++)
+		{
+			lwdt = CircleRowHalfWidth(rad, ycnt); dpy = ty + ycnt;
+			ForRowSpan(tx - lwdt, tx + lwdt + (lwdt == 0), dpy, [this, dpy, grade, iBlastSize](const int32_t x, const uint8_t pix) { BlastFreePix(x, dpy, grade, iBlastSize, pix); });
+		}
 	}
 
 	// Evaluate material count
@@ -1082,6 +1327,7 @@ void C4Landscape::BlastFree(int32_t tx, int32_t ty, int32_t rad, int32_t grade,
 void C4Landscape::DrawMaterialRect(int32_t mat, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt)
 {
 	int32_t cx, cy;
+	C4LandscapeChangeBatch batch{*this};
 	for (cy = ty; cy < ty + hgt; cy++)
 		for (cx = tx; cx < tx + wdt; cx++)
 			if ((MatDensity(mat) > GetDensity(cx, cy))
@@ -1093,6 +1339,7 @@ void C4Landscape::RaiseTerrain(int32_t tx, int32_t ty, int32_t wdt)
 {
 	int32_t cx, cy;
 	uint8_t cpix;
+	C4LandscapeChangeBatch batch{*this};
 	for (cx = tx; cx < tx + wdt; cx++)
 	{
 		for (cy = ty; (cy + 1 < GBackHgt) && !GBackSolid(cx, cy + 1); cy++);
@@ -1439,28 +1686,38 @@ bool C4Landscape::Incinerate(int32_t x, int32_t y)
 	return false;
 }
 
-bool C4Landscape::Save(C4Group &hGroup)
+bool C4Landscape::Save(C4Group &hGroup, C4GameSaveJobs *pJobs)
 {
 	// Save members
 	if (!Sky.Save(hGroup))
 		return false;
 
-	// Save landscape surface
-	char szTempLandscape[_MAX_PATH + 1];
-	SCopy(Config.AtTempPath(C4CFN_TempLandscape), szTempLandscape);
-	MakeTempFilename(szTempLandscape);
-	if (!Surface8->Save(szTempLandscape))
-		return false;
+	// Encode right away if the caller doesn't collect the jobs
+	C4GameSaveJobs ownJobs;
+	C4GameSaveJobs &jobs = pJobs ? *pJobs : ownJobs;
 
-	// Move temp file to group
-	if (!hGroup.Move(szTempLandscape, C4CFN_Landscape))
-		return false;
+	// Save copies of the landscape surfaces, so the game may continue while they are encoded
+	auto surface8 = std::make_shared<CSurface8>();
+	if (!surface8->CreateCopy(*Surface8)) return false;
+	jobs.Add(C4CFN_Landscape, C4CFN_TempLandscape, [surface8](const char *const szFilename)
+	{
+		return surface8->Save(szFilename);
+	});
 
-	SCopy(Config.AtTempPath(C4CFN_TempLandscapePNG), szTempLandscape);
-	MakeTempFilename(szTempLandscape);
-	if (!Surface32->SavePNG(szTempLandscape, true, false, false))
-		return false;
-	if (!hGroup.Move(szTempLandscape, C4CFN_LandscapePNG)) return false;
+	std::shared_ptr<StdBitmap> surface32{Surface32->CopyToBitmap(true, false, false)};
+	if (!surface32) return false;
+	jobs.Add(C4CFN_LandscapePNG, C4CFN_TempLandscapePNG, [surface32](const char *const szFilename)
+	{
+		try
+		{
+			CPNGFile(szFilename, surface32->GetWidth(), surface32->GetHeight(), surface32->UsesAlpha()).Encode(surface32->GetBytes());
+		}
+		catch (const std::runtime_error &)
+		{
+			return false;
+		}
+		return true;
+	});
 
 	if (fMapChanged && Map)
 		if (!SaveMap(hGroup)) return false;
@@ -1468,7 +1725,20 @@ bool C4Landscape::Save(C4Group &hGroup)
 	// save textures (if changed)
 	if (!SaveTextures(hGroup)) return false;
 
-	return true;
+	return pJobs || ownJobs.Finish(hGroup);
+}
+
+namespace
+{
+	// header of C4CFN_DiffLandscapeTiles
+	// it is followed by a bitmap of the stored tiles and then, for each stored tile, the size and the pixels as runs of (length - 1, pixel)
+	struct C4LandscapeDiffHeader
+	{
+		uint32_t Version;
+		int32_t Width, Height, TileSize;
+	};
+
+	const uint32_t C4LandscapeDiffVersion = 1;
 }
 
 bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
@@ -1476,36 +1746,66 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 	assert(pInitial);
 	if (!pInitial) return false;
 
-	// If it shouldn't be sync-save: Clear all bytes that have not changed
+	// Remove diffs of a resumed savegame
+	hGroup.DeleteEntry(C4CFN_DiffLandscape);
+	hGroup.DeleteEntry(C4CFN_DiffLandscapeTiles);
+
+	const int32_t iTilesX = (Width + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize;
+	const int32_t iTilesY = (Height + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize;
+	const size_t iBitmapSize = (iTilesX * iTilesY + 7) / 8;
+	const C4LandscapeDiffHeader header{C4LandscapeDiffVersion, Width, Height, C4LS_DiffTileSize};
+	std::vector<uint8_t> data(sizeof(header) + iBitmapSize);
+	std::memcpy(data.data(), &header, sizeof(header));
+
 	bool fChanged = false;
-	if (!fSyncSave)
-		for (int y = 0; y < Height; y++)
-			for (int x = 0; x < Width; x++)
-				if (pInitial[y * Width + x] == _GetPix(x, y))
-					Surface8->SetPix(x, y, 0xff);
-				else
-					fChanged = true;
+	for (int32_t ty = 0; ty < iTilesY; ++ty)
+		for (int32_t tx = 0; tx < iTilesX; ++tx)
+		{
+			const int32_t x1 = tx * C4LS_DiffTileSize, x2 = std::min(x1 + C4LS_DiffTileSize, Width);
+			const int32_t y1 = ty * C4LS_DiffTileSize, y2 = std::min(y1 + C4LS_DiffTileSize, Height);
+			// If it shouldn't be sync-save: Skip tiles that have not changed
+			if (!fSyncSave)
+			{
+				int32_t y = y1;
+				while (y < y2 && !std::memcmp(Surface8->Bits + y * Surface8->Pitch + x1, pInitial + y * Width + x1, x2 - x1)) ++y;
+				if (y == y2) continue;
+			}
+			fChanged = true;
+			const int32_t iTile = ty * iTilesX + tx;
+			data[sizeof(header) + iTile / 8] |= 1 << (iTile % 8);
+
+			// run length encode the tile; unchanged bytes are 0xff unless it should be sync-save
+			const size_t iSizePos = data.size();
+			data.resize(iSizePos + sizeof(uint32_t));
+			uint8_t byRun = 0; int32_t iRunLength = 0;
+			for (int32_t y = y1; y < y2; ++y)
+			{
+				const uint8_t *const pRow = Surface8->Bits + y * Surface8->Pitch, *const pInitialRow = pInitial + y * Width;
+				for (int32_t x = x1; x < x2; ++x)
+				{
+					const uint8_t byPix = (fSyncSave || pRow[x] != pInitialRow[x]) ? pRow[x] : 0xff;
+					if (iRunLength && (byPix != byRun || iRunLength == 256))
+					{
+						data.push_back(static_cast<uint8_t>(iRunLength - 1)); data.push_back(byRun);
+						iRunLength = 0;
+					}
+					byRun = byPix; ++iRunLength;
+				}
+			}
+			data.push_back(static_cast<uint8_t>(iRunLength - 1)); data.push_back(byRun);
+			const uint32_t iTileSize = static_cast<uint32_t>(data.size() - iSizePos - sizeof(uint32_t));
+			std::memcpy(data.data() + iSizePos, &iTileSize, sizeof(iTileSize));
+		}
 
 	if (fSyncSave || fChanged)
 	{
-		// Save landscape surface
-		if (!Surface8->Save(Config.AtTempPath(C4CFN_TempLandscape)))
-			return false;
-
-		// Move temp file to group
-		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscape),
-			C4CFN_DiffLandscape))
+		// Save landscape diff directly into the group
+		StdBuf buf;
+		buf.Copy(data.data(), data.size());
+		if (!hGroup.Add(C4CFN_DiffLandscapeTiles, buf, false, true))
 			return false;
 	}
 
-	// Restore landscape pixels
-	if (!fSyncSave)
-		if (pInitial)
-			for (int y = 0; y < Height; y++)
-				for (int x = 0; x < Width; x++)
-					if (_GetPix(x, y) == 0xff)
-						Surface8->SetPix(x, y, pInitial[y * Width + x]);
-
 	// Save changed map, too
 	if (fMapChanged && Map)
 		if (!SaveMap(hGroup)) return false;
@@ -1623,8 +1923,12 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 
 bool C4Landscape::ApplyDiff(C4Group &hGroup)
 {
+	// Load tile diff from group
+	StdBuf buf;
+	if (hGroup.LoadEntry(C4CFN_DiffLandscapeTiles, buf))
+		return ApplyDiffTiles(buf);
 	CSurface8 *pDiff;
-	// Load diff landscape from group
+	// Load diff landscape bitmap of older savegames from group
 	if (!hGroup.AccessEntry(C4CFN_DiffLandscape)) return false;
 	if (!(pDiff = GroupReadSurfaceOwnPal8(hGroup))) return false;
 	// convert all pixels: keep if same material; re-set if different material
@@ -1639,10 +1943,67 @@ bool C4Landscape::ApplyDiff(C4Group &hGroup)
 	return true;
 }
 
+bool C4Landscape::ApplyDiffTiles(const StdBuf &Buf)
+{
+	C4LandscapeDiffHeader header;
+	if (Buf.getSize() < sizeof(header)) return false;
+	std::memcpy(&header, Buf.getData(), sizeof(header));
+	if (header.Version != C4LandscapeDiffVersion || header.Width != Width || header.Height != Height || header.TileSize <= 0) return false;
+
+	const int32_t iTilesX = (Width + header.TileSize - 1) / header.TileSize;
+	const int32_t iTilesY = (Height + header.TileSize - 1) / header.TileSize;
+	const size_t iBitmapSize = (iTilesX * iTilesY + 7) / 8;
+	if (Buf.getSize() < sizeof(header) + iBitmapSize) return false;
+	const uint8_t *const pBitmap = static_cast<const uint8_t *>(Buf.getPtr(sizeof(header)));
+	const uint8_t *const pEnd = static_cast<const uint8_t *>(Buf.getPtr(Buf.getSize()));
+
+	// the first pass only checks the tiles, so a corrupt diff leaves the landscape untouched
+	const auto processTiles = [&](const bool fApply)
+	{
+		const uint8_t *pData = pBitmap + iBitmapSize;
+		for (int32_t iTile = 0; iTile < iTilesX * iTilesY; ++iTile)
+		{
+			if (!(pBitmap[iTile / 8] & (1 << (iTile % 8)))) continue;
+			uint32_t iTileSize;
+			if (pEnd - pData < static_cast<ptrdiff_t>(sizeof(iTileSize))) return false;
+			std::memcpy(&iTileSize, pData, sizeof(iTileSize));
+			pData += sizeof(iTileSize);
+			if (static_cast<size_t>(pEnd - pData) < iTileSize || iTileSize % 2) return false;
+			const uint8_t *const pTileEnd = pData + iTileSize;
+
+			const int32_t x1 = iTile % iTilesX * header.TileSize, x2 = std::min(x1 + header.TileSize, Width);
+			const int32_t y1 = iTile / iTilesX * header.TileSize, y2 = std::min(y1 + header.TileSize, Height);
+			int32_t x = x1, y = y1;
+			for (; pData < pTileEnd; pData += 2)
+			{
+				const uint8_t byPix = pData[1];
+				for (int32_t i = pData[0] + 1; i > 0; --i)
+				{
+					if (y >= y2) return false;
+					// convert all pixels: keep if same material; re-set if different material
+					if (fApply && byPix != 0xff && _GetPix(x, y) != byPix)
+						// material has changed here: readjust with new texture
+						SetPix(x, y, byPix);
+					if (++x == x2) { x = x1; ++y; }
+				}
+			}
+			if (y != y2) return false;
+		}
+		return true;
+	};
+	return processTiles(false) && processTiles(true);
+}
+
 void C4Landscape::Default()
 {
 	Mode = C4LSC_Undefined;
 	Surface8 = nullptr;
+	GuardWidth = 0;
+	ChangeBatchDepth = 0;
+	ChangeBatchRelight.Default();
+	ChangeBatchNavigation.Default();
+	MatRunBreaks = nullptr;
+	MatRunBreaksPitch = 0;
 	Surface32 = nullptr;
 	AnimationSurface = nullptr;
 	Map = nullptr;
@@ -2051,6 +2412,8 @@ bool PathFreePix(int32_t x, int32_t y, int32_t par)
 
 bool PathFree(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t *ix, int32_t *iy)
 {
+	// no pixel with density around the line at all?
+	if (Game.Landscape._AreaFree(x1, y1, x2, y2)) return true;
 	return ForLine(x1, y1, x2, y2, &PathFreePix, 0, ix, iy);
 }
 
@@ -2062,6 +2425,7 @@ bool PathFreeIgnoreVehiclePix(int32_t x, int32_t y, int32_t par)
 
 bool PathFreeIgnoreVehicle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t *ix, int32_t *iy)
 {
+	if (Game.Landscape._AreaFree(x1, y1, x2, y2)) return true;
 	return ForLine(x1, y1, x2, y2, &PathFreeIgnoreVehiclePix, 0, ix, iy);
 }
 
@@ -2827,6 +3191,20 @@ void C4Landscape::UpdatePixMaps()
 	for (i = 0; i < 256; i++) Pix2Dens[i] = MatDensity(Pix2Mat[i]);
 	for (i = 0; i < 256; i++) Pix2Place[i] = MatValid(Pix2Mat[i]) ? Game.Material.Map[Pix2Mat[i]].Placement : 0;
 	Pix2Place[0] = 0;
+	// materials of pixels might have changed
+	if (MatRunBreaks) UpdateMatRuns(C4Rect(0, 0, Width, Height));
+	for (i = 0; i < 256; i++)
+	{
+		Pix2Free[i] = 0;
+		if (!MatValid(Pix2Mat[i])) continue;
+		const C4Material &mat{Game.Material.Map[Pix2Mat[i]]};
+		if (mat.DigFree) Pix2Free[i] |= C4LS_PixDigFree;
+		if (mat.BlastFree) Pix2Free[i] |= C4LS_PixBlastFree;
+		if (mat.BlastShiftTo) Pix2Free[i] |= C4LS_PixBlastShift;
+		if (mat.Instable) Pix2Free[i] |= C4LS_PixInstable;
+	}
+	// densities might have changed
+	Game.PathFinder.InvalidateLandscape();
 }
 
 bool C4Landscape::Mat2Pal()
@@ -2867,6 +3245,8 @@ void C4Landscape::PrepareChange(C4Rect BoundingBox, const bool updateMatCnt)
 
 void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt)
 {
+	// the surface was changed directly
+	if (MatRunBreaks) UpdateMatRuns(BoundingBox);
 	// relight
 	Relight(BoundingBox);
 	if (updateMatAndPixCnt) UpdateMatCnt(BoundingBox, true);
@@ -2879,6 +3259,8 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 		pSolid->Repair(SolidMaskRect);
 	}
 	if (updateMatAndPixCnt) UpdatePixCnt(BoundingBox);
+	// navigation graph
+	Game.PathFinder.InvalidateLandscape(BoundingBox);
 	C4SolidMask::CheckConsistency();
 }
 
@@ -2893,9 +3275,12 @@ void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 				for (int32_t y2 = y * 15; y2 < std::min<int32_t>(y * 15 + 15, Height); y2++)
 					if (_GetDensity(x2, y2))
 						iCnt++;
+			uint8_t &rCnt = PixCnt[x * PixCntPitch + y];
 			if (fCheck)
-				assert(iCnt == PixCnt[x * PixCntPitch + y]);
-			PixCnt[x * PixCntPitch + y] = iCnt;
+				assert(iCnt == rCnt);
+			if (!iCnt != !rCnt)
+				PixCntTile[(y / C4LS_PixCntTileSize) + (x / C4LS_PixCntTileSize) * PixCntTilePitch] += iCnt ? 1 : -1;
+			rCnt = iCnt;
 		}
 }
 
@@ -2982,6 +3367,7 @@ void C4Landscape::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkCastIntAdapt(Gravity), "Gravity",       FIXED100(20)));
 	pComp->Value(mkNamingAdapt(Modulation,              "MatModulation", 0U));
 	pComp->Value(mkNamingAdapt(Mode,                    "Mode",          C4LSC_Undefined));
+	if (pComp->isCompiler()) UpdateGuard();
 }
 
 void C4Landscape::RemoveUnusedTexMapEntries()
@@ -24,8 +24,12 @@
 
 #include <StdSurface8.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 
+class C4GameSaveJobs;
+
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
               IFT        = 0x80,
@@ -41,6 +45,15 @@ const int32_t C4LSC_Undefined = 0,
               C4LSC_Exact = 3;
 
 const int32_t C4LS_MaxRelights = 50;
+const int32_t C4LS_PixCntTileSize = 8; // PixCnt blocks per side of a PixCntTile
+const int32_t C4LS_GuardWidth = 16; // border around the 8 bit surface holding the pixels outside the landscape
+const int32_t C4LS_DiffTileSize = 64; // side length of the tiles of saved landscape diffs
+
+// material properties of landscape pixels used when digging and blasting
+const uint8_t C4LS_PixDigFree    = 1,
+              C4LS_PixBlastFree  = 2,
+              C4LS_PixBlastShift = 4,
+              C4LS_PixInstable   = 8;
 
 class C4MapCreatorS2;
 class C4Object;
@@ -76,10 +89,19 @@ protected:
 	C4Surface *Surface32;
 	C4Surface *AnimationSurface;
 	CSurface8 *Surface8;
+	uint32_t GuardWidth; // NoSave // width of the up to date guard border of Surface8; 0 if there is none
 	int32_t Pix2Mat[256], Pix2Dens[256], Pix2Place[256];
+	uint8_t Pix2Free[256]; // C4LS_Pix* flags
 	int32_t PixCntPitch;
-	uint8_t *PixCnt;
+	uint8_t *PixCnt; // pixels with density per 17x15 block
+	int32_t PixCntTilePitch;
+	uint8_t *PixCntTile; // PixCnt blocks with pixels per tile of C4LS_PixCntTileSize blocks
+	int32_t MatRunBreaksPitch; // NoSave // words per column
+	uint64_t *MatRunBreaks; // NoSave // per column, bit y is set if the material changes between y - 1 and y; bits 0 and Height are always set. Only kept if any material has a MinHeightCount
 	C4Rect Relights[C4LS_MaxRelights];
+	int32_t ChangeBatchDepth; // NoSave // nesting depth of the running change batches
+	C4Rect ChangeBatchRelight; // NoSave // pixels set by SetPix during the change batches
+	C4Rect ChangeBatchNavigation; // NoSave // pixels set by _SetPix during the change batches
 
 public:
 	void Default();
@@ -104,7 +126,8 @@ public:
 	void FindMatTop(int32_t mat, int32_t &x, int32_t &y);
 	uint8_t GetMapIndex(int32_t iX, int32_t iY);
 	bool Load(C4Group &hGroup, bool fLoadSky, bool fSavegame);
-	bool Save(C4Group &hGroup);
+	// the surfaces are copied and encoded by pJobs if given; otherwise, they are encoded before returning
+	bool Save(C4Group &hGroup, C4GameSaveJobs *pJobs = nullptr);
 	bool SaveDiff(C4Group &hGroup, bool fSyncSave);
 	bool SaveMap(C4Group &hGroup);
 	bool SaveInitial();
@@ -112,6 +135,7 @@ public:
 	bool Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bool &rfLoaded, bool fSavegame);
 	bool MapToLandscape();
 	bool ApplyDiff(C4Group &hGroup);
+	bool ApplyDiffTiles(const StdBuf &Buf);
 	bool SetMode(int32_t iMode);
 	bool SetPix(int32_t x, int32_t y, uint8_t npix); // set landscape pixel (bounds checked)
 	bool SetPixDw(int32_t x, int32_t y, uint32_t dwPix); // set pixel how it is visible only
@@ -143,23 +167,15 @@ public:
 
 	inline uint8_t GetPix(int32_t x, int32_t y) // get landscape pixel (bounds checked)
 	{
-		extern uint8_t MCVehic;
-		// Border checks
-		if (x < 0)
-			if (y < LeftOpen) return 0;
-			else return MCVehic;
-			if (x >= Width)
-				if (y < RightOpen) return 0;
-				else return MCVehic;
-				if (y < 0)
-					if (TopOpen) return 0;
-					else return MCVehic;
-					if (y >= Height)
-						if (BottomOpen) return 0;
-						else return MCVehic;
-						return Surface8->_GetPix(x, y);
+		// the guard border holds the pixels next to the landscape, so one range check covers both
+		if (static_cast<uint32_t>(x) + GuardWidth < Width + 2 * GuardWidth && static_cast<uint32_t>(y) + GuardWidth < Height + 2 * GuardWidth)
+			return Surface8->_GetPix(x, y);
+		return GetBorderPix(x, y);
 	}
 
+	uint8_t GetBorderPix(int32_t x, int32_t y); // get landscape pixel outside the guard border
+	void UpdateGuard(); // must be called whenever the open sides or MCVehic change
+
 	inline int32_t _GetMat(int32_t x, int32_t y) // get landscape material (bounds not checked)
 	{
 		return Pix2Mat[_GetPix(x, y)];
@@ -186,7 +202,9 @@ public:
 	}
 
 	inline int32_t GetPixMat(uint8_t byPix) { return Pix2Mat[byPix]; }
+	inline int32_t GetPixDensity(uint8_t byPix) { return Pix2Dens[byPix]; }
 	bool _PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2); // quickly checks wether there *might* be pixel in the path.
+	bool _AreaFree(int32_t x1, int32_t y1, int32_t x2, int32_t y2); // quickly checks whether the rectangle between both points certainly has no pixels with density
 	int32_t GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax);
 	int32_t DigFreePix(int32_t tx, int32_t ty);
 	int32_t ShakeFreePix(int32_t tx, int32_t ty);
@@ -211,6 +229,13 @@ public:
 	void UpdatePixMaps();
 	bool DoRelights();
 	void RemoveUnusedTexMapEntries();
+	// During a change batch, SetPix and _SetPix only collect the changed area. It is queued for relighting and
+	// invalidated in the navigation graph once when the outermost batch ends. Batches must not run scripts.
+	// MatCount and EffectiveMatCount are still updated per pixel, because each EffectiveMatCount delta depends on
+	// the neighbouring pixels at the time of the change. Only GetMaterialCount, the ClearMaterial goal check
+	// in C4Game::Execute and C4SolidMask::CheckConsistency read them, and none is reached from within a batch.
+	void BeginChangeBatch() { ++ChangeBatchDepth; }
+	void EndChangeBatch();
 
 protected:
 	void ExecuteScan();
@@ -228,11 +253,33 @@ protected:
 	CSurface8 *CreateMap(); // create map by landscape attributes
 	CSurface8 *CreateMapS2(C4Group &ScenFile); // create map by def file
 	bool Relight(C4Rect To);
+	void QueueRelight(const C4Rect &Rect);
 	bool ApplyLighting(C4Rect To);
 	bool UpdateAnimationSurface(C4Rect To);
 	uint32_t GetClrByTex(int32_t iX, int32_t iY);
 	bool Mat2Pal(); // assign material colors to landscape palette
 
+	// pix is the current landscape pixel at tx, ty
+	int32_t DigFreePix(int32_t tx, int32_t ty, uint8_t pix);
+	int32_t ShakeFreePix(int32_t tx, int32_t ty, uint8_t pix);
+	int32_t BlastFreePix(int32_t tx, int32_t ty, int32_t grade, int32_t iBlastSize, uint8_t pix);
+
+	// half width of row ycnt of the circles dug and blasted into the landscape
+	static int32_t CircleRowHalfWidth(int32_t rad, int32_t ycnt) { return static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt))); }
+
+	// calls func(x, pix) for the pixels of row y from x1 to x2 (exclusive) from left to right
+	// pixels inside the landscape are read straight from the row when func is called for them, so they reflect changes func made to earlier pixels
+	template<typename Func> void ForRowSpan(int32_t x1, const int32_t x2, const int32_t y, Func &&func)
+	{
+		if (y >= 0 && y < Height)
+		{
+			const uint8_t *const row{Surface8->Bits + y * Surface8->Pitch};
+			for (; x1 < std::min<int32_t>(x2, 0); x1++) func(x1, GetPix(x1, y));
+			for (const int32_t xEnd{std::min(x2, Width)}; x1 < xEnd; x1++) func(x1, row[x1]);
+		}
+		for (; x1 < x2; x1++) func(x1, GetPix(x1, y));
+	}
+
 	void DigFreeSinglePix(int32_t x, int32_t y, int32_t dx, int32_t dy)
 	{
 		if (GetDensity(x, y) > GetDensity(x + dx, y + dy))
@@ -240,6 +287,11 @@ protected:
 	}
 
 	void UpdatePixCnt(const class C4Rect &Rect, bool fCheck = false);
+	void InitMatRuns(); // creates MatRunBreaks if needed
+	void UpdateMatRuns(C4Rect Rect); // recalculates the run breaks of the columns of Rect
+	void UpdateMatRunBreaks(int32_t x, int32_t y); // after the material of pixel x, y changed
+	int32_t GetMatRunHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax); // same as GetMatHeight, but using MatRunBreaks
+	int32_t GetEffectiveMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax); // GetMatHeight for counting EffectiveMatCount
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
 	void PrepareChange(C4Rect BoundingBox, bool updateMatCnt = true);
 	void FinishChange(C4Rect BoundingBox, bool updateMatAndPixCnt = true);
@@ -249,6 +301,20 @@ public:
 	void CompileFunc(StdCompiler *pComp); // without landscape bitmaps and sky
 };
 
+// batches the landscape changes done in its scope
+class C4LandscapeChangeBatch
+{
+public:
+	explicit C4LandscapeChangeBatch(C4Landscape &Landscape) : Landscape{Landscape} { Landscape.BeginChangeBatch(); }
+	~C4LandscapeChangeBatch() { Landscape.EndChangeBatch(); }
+
+	C4LandscapeChangeBatch(const C4LandscapeChangeBatch &) = delete;
+	C4LandscapeChangeBatch &operator=(const C4LandscapeChangeBatch &) = delete;
+
+private:
+	C4Landscape &Landscape;
+};
+
 /* Some global landscape functions */
 
 bool AboveSolid(int32_t &rx, int32_t &ry);
@@ -255,6 +255,7 @@ void C4MaterialMap::Clear()
 {
 	delete[] Map;           Map           = nullptr;
 	delete[] ppReactionMap; ppReactionMap = nullptr;
+	delete[] pReactionCodes; pReactionCodes = nullptr;
 }
 
 int32_t C4MaterialMap::Load(C4Group &hGroup, C4Group *OverloadFile)
@@ -480,6 +481,36 @@ void C4MaterialMap::CrossMapMaterials() // Called after load
 		if (Map[cnt].sAboveTempConvertTo.getLength())
 			Map[cnt].AboveTempConvertTo = Game.TextureMap.GetIndexMatTex(Map[cnt].sAboveTempConvertTo.getData(), nullptr, true, std::format("AboveTempConvertTo of mat {}", Map[cnt].Name).c_str());
 	}
+	// precompile the reactions for PXS
+	UpdateReactionCodes();
+}
+
+void C4MaterialMap::UpdateReactionCodes()
+{
+	delete[] pReactionCodes;
+	const int32_t iPairs = (Num + 1) * (Num + 1);
+	pReactionCodes = new uint8_t[2 * iPairs];
+	for (const MaterialInteractionEvent evEvent : {meePXSPos, meePXSMove})
+		for (int32_t i = 0; i < iPairs; ++i)
+		{
+			const C4MaterialReaction *const pReact = ppReactionMap[i];
+			C4MaterialReactionCode iCode;
+			// no reaction, or user-defined reactions not executed for this event
+			if (!pReact || pReact->pFunc == &C4MaterialReaction::NoReaction || (pReact->fUserDefined && ((1 << evEvent) & ~pReact->iExecMask)))
+				iCode = mrcNone;
+			// insertion and corrosion only check the executing mask before movement
+			else if (evEvent == meePXSPos && (pReact->pFunc == &mrfInsert || pReact->pFunc == &mrfCorrode))
+				iCode = mrcNone;
+			else if (pReact->pFunc == &mrfConvert)
+				iCode = mrcConvert;
+			else if (pReact->pFunc == &mrfPoof)
+				iCode = mrcPoof;
+			else if (pReact->pFunc == &mrfInsert)
+				iCode = mrcInsert;
+			else
+				iCode = mrcFunc;
+			pReactionCodes[evEvent * iPairs + i] = iCode;
+		}
 }
 
 void C4MaterialMap::SetMatReaction(int32_t iPXSMat, int32_t iLSMat, C4MaterialReaction *pReact)
@@ -559,6 +590,7 @@ void C4MaterialMap::Default()
 	Num = 0;
 	Map = nullptr;
 	ppReactionMap = nullptr;
+	pReactionCodes = nullptr;
 }
 
 bool mrfInsertCheck(int32_t &iX, int32_t &iY, C4Fixed &fXDir, C4Fixed &fYDir, int32_t &iPxsMat, int32_t iLsMat, bool *pfPosChanged)
@@ -37,6 +37,16 @@ enum MaterialInteractionEvent
 	meeMassMove = 2, // MassMover-movement
 };
 
+// what a reaction does for a PXS event; precompiled for each material pair, so pairs without any effect are skipped right away
+enum C4MaterialReactionCode : uint8_t
+{
+	mrcNone = 0, // no reaction or no effect for that event
+	mrcConvert,  // default reactions, called directly
+	mrcPoof,
+	mrcInsert,
+	mrcFunc,     // any other reaction: call pFunc
+};
+
 typedef bool(*C4MaterialReactionFunc)(struct C4MaterialReaction *pReaction, int32_t &iX, int32_t &iY, int32_t iLSPosX, int32_t iLSPosY, C4Fixed &fXDir, C4Fixed &fYDir, int32_t &iPxsMat, int32_t iLsMat, MaterialInteractionEvent evEvent, bool *pfPosChanged);
 
 struct C4MaterialReaction
@@ -155,6 +165,7 @@ public:
 	int32_t Num;
 	C4Material *Map;
 	C4MaterialReaction **ppReactionMap;
+	uint8_t *pReactionCodes; // C4MaterialReactionCode of ppReactionMap for meePXSPos and meePXSMove
 
 	C4MaterialReaction DefReactConvert, DefReactPoof, DefReactCorrode, DefReactIncinerate, DefReactInsert;
 
@@ -182,10 +193,31 @@ public:
 		return ppReactionMap[(iLandscapeMat + 1) * (Num + 1) + iPXSMat + 1];
 	}
 
+	C4MaterialReactionCode GetReactionCodeUnsafe(MaterialInteractionEvent evEvent, int32_t iPXSMat, int32_t iLandscapeMat)
+	{
+		assert(pReactionCodes); assert(evEvent == meePXSPos || evEvent == meePXSMove);
+		return static_cast<C4MaterialReactionCode>(pReactionCodes[(evEvent * (Num + 1) + iLandscapeMat + 1) * (Num + 1) + iPXSMat + 1]);
+	}
+
+	// call the reaction of the pair as given by its code
+	bool React(C4MaterialReactionCode iCode, int32_t &iX, int32_t &iY, int32_t iLSPosX, int32_t iLSPosY, C4Fixed &fXDir, C4Fixed &fYDir, int32_t &iPxsMat, int32_t iLsMat, MaterialInteractionEvent evEvent, bool *pfPosChanged)
+	{
+		C4MaterialReaction *const pReact = GetReactionUnsafe(iPxsMat, iLsMat);
+		switch (iCode)
+		{
+		case mrcNone: return false;
+		case mrcConvert: return mrfConvert(pReact, iX, iY, iLSPosX, iLSPosY, fXDir, fYDir, iPxsMat, iLsMat, evEvent, pfPosChanged);
+		case mrcPoof: return mrfPoof(pReact, iX, iY, iLSPosX, iLSPosY, fXDir, fYDir, iPxsMat, iLsMat, evEvent, pfPosChanged);
+		case mrcInsert: return mrfInsert(pReact, iX, iY, iLSPosX, iLSPosY, fXDir, fYDir, iPxsMat, iLsMat, evEvent, pfPosChanged);
+		default: return (*pReact->pFunc)(pReact, iX, iY, iLSPosX, iLSPosY, fXDir, fYDir, iPxsMat, iLsMat, evEvent, pfPosChanged);
+		}
+	}
+
 	void UpdateScriptPointers(); // set all material script pointers
 	void CrossMapMaterials();
 
 protected:
+	void UpdateReactionCodes();
 	void SetMatReaction(int32_t iPXSMat, int32_t iLSMat, C4MaterialReaction *pReact);
 	bool SortEnumeration(int32_t iMat, const char *szMatName);
 };
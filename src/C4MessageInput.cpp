@@ -22,6 +22,8 @@
 #include <C4Include.h>
 #include <C4MessageInput.h>
 
+#include <C4AulCallProfiler.h>
+#include <C4DefExecProfiler.h>
 #include <C4Game.h>
 #include <C4Object.h>
 #include <C4Script.h>
@@ -32,6 +34,7 @@
 #include <C4Log.h>
 #include <C4Player.h>
 #include <C4GameLobby.h>
+#include <C4Trace.h>
 
 // C4ChatInputDialog
 
@@ -460,6 +463,9 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogNTr("/set maxplayer [4] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWMAXIMUMNUMBEROFPLA));
 		LogNTr("/script [script] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_EXECUTEASCRIPTCOMMAND));
 		LogNTr("/clear - {}", LoadResStr(C4ResStrTableKey::IDS_MSG_CLEARTHEMESSAGEBOARD));
+		LogNTr("/profile start|stop [file] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_RECORDSCRIPTCALLSFORPROFI));
+		LogNTr("/trace start|stop [file] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_RECORDTRACEZONESOFALLTHR));
+		LogNTr("/defprofile start|stop|top [count] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_MEASURETHEEXECUTIONTIMEO));
 		return true;
 	}
 	// dev-scripts
@@ -472,6 +478,83 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		Game.Control.DoInput(CID_Script, new C4ControlScript(pCmdPar, C4ControlScript::SCOPE_Console, Config.Developer.ConsoleScriptStrictness), CDT_Decide);
 		return true;
 	}
+	// record script calls; only affects this client
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (SEqual(pCmdPar, "start"))
+		{
+			AulCallProfiler.Start();
+			return true;
+		}
+		if (SEqual2(pCmdPar, "stop"))
+		{
+			AulCallProfiler.Stop();
+			std::vector<std::string> filenames;
+			if (pCmdPar[4] == ' ' && pCmdPar[5])
+				filenames.emplace_back(pCmdPar + 5);
+			else
+			{
+				filenames.emplace_back(Config.AtUserPath("ScriptProfile.json"));
+				filenames.emplace_back(Config.AtUserPath("ScriptProfile.folded"));
+			}
+			for (const auto &filename : filenames)
+			{
+				if (!AulCallProfiler.Save(filename.c_str()))
+				{
+					Log(C4ResStrTableKey::IDS_MSG_CMD_PROFILE_FAILED, filename);
+					return false;
+				}
+				Log(C4ResStrTableKey::IDS_MSG_CMD_PROFILE_SAVED, filename);
+			}
+			return true;
+		}
+		Log(C4ResStrTableKey::IDS_MSG_CMD_PROFILE_USAGE);
+		return false;
+	}
+	// record trace zones; only affects this client
+	if (SEqual(szCmdName, "trace"))
+	{
+		if (SEqual(pCmdPar, "start"))
+		{
+			C4Trace::Start();
+			return true;
+		}
+		if (SEqual2(pCmdPar, "stop"))
+		{
+			C4Trace::Stop();
+			const std::string filename{pCmdPar[4] == ' ' && pCmdPar[5] ? pCmdPar + 5 : Config.AtUserPath("Trace.json")};
+			if (!C4Trace::Save(filename.c_str()))
+			{
+				Log(C4ResStrTableKey::IDS_MSG_CMD_TRACE_FAILED, filename);
+				return false;
+			}
+			Log(C4ResStrTableKey::IDS_MSG_CMD_TRACE_SAVED, filename);
+			return true;
+		}
+		Log(C4ResStrTableKey::IDS_MSG_CMD_TRACE_USAGE);
+		return false;
+	}
+	// measure object execution per definition; only affects this client
+	if (SEqual(szCmdName, "defprofile"))
+	{
+		if (SEqual(pCmdPar, "start"))
+		{
+			DefExecProfiler.Start();
+			return true;
+		}
+		// stop or just show the current top list
+		const bool fStop{SEqual2(pCmdPar, "stop")};
+		if (fStop || SEqual2(pCmdPar, "top"))
+		{
+			if (fStop) DefExecProfiler.Stop();
+			const char *const szCount{SSearch(pCmdPar, " ")};
+			const int count{szCount ? std::max(atoi(szCount), 0) : static_cast<int>(C4DefExecProfiler::DefaultTopCount)};
+			DefExecProfiler.LogTop(count);
+			return true;
+		}
+		Log(C4ResStrTableKey::IDS_MSG_CMD_DEFPROFILE_USAGE);
+		return false;
+	}
 	// set runtimte properties
 	if (SEqual(szCmdName, "set"))
 	{
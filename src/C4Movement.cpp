@@ -629,17 +629,25 @@ bool SimFlight(C4Fixed &x, C4Fixed &y, C4Fixed &xdir, C4Fixed &ydir, int32_t iDe
 		ctcox = fixtoi(x); ctcoy = fixtoi(y);
 		// Bounds
 		if (!Inside<int32_t>(ctcox, 0, GBackWdt) || (ctcoy >= GBackHgt)) return false;
-		// Move to target
-		do
+		// Nothing to hit on the way? Pixels without density never match a minimum density above zero.
+		if (iDensityMin > 0 && Game.Landscape._AreaFree(cx, cy, ctcox, ctcoy))
 		{
-			// Set next step target
-			cx += Sign(ctcox - cx); cy += Sign(ctcoy - cy);
-			// Contact check
-			if (Inside(GBackDensity(cx, cy), iDensityMin, iDensityMax))
+			cx = ctcox; cy = ctcoy;
+		}
+		else
+		{
+			// Move to target
+			do
 			{
-				fBreak = true; break;
-			}
-		} while ((cx != ctcox) || (cy != ctcoy));
+				// Set next step target
+				cx += Sign(ctcox - cx); cy += Sign(ctcoy - cy);
+				// Contact check
+				if (Inside(GBackDensity(cx, cy), iDensityMin, iDensityMax))
+				{
+					fBreak = true; break;
+				}
+			} while ((cx != ctcox) || (cy != ctcoy));
+		}
 		// Adjust GravAccel once per frame
 		ydir += GravAccel;
 	} while (!fBreak);
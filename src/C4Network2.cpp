@@ -25,6 +25,7 @@
 #include <C4Console.h>
 #include <C4GameSave.h>
 #include <C4RoundResults.h>
+#include <C4Trace.h>
 
 // lobby
 #include <C4Gui.h>
@@ -907,6 +908,8 @@ void C4Network2::OnDisconn(C4Network2IOConnection *pConn)
 
 void C4Network2::HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Network2IOConnection *pConn)
 {
+	C4TRACE_ZONE("C4Network2::HandlePacket");
+
 	// find associated client
 	C4Network2Client *pClient = Clients.GetClient(pConn);
 	if (!pClient) pClient = Clients.GetClientByID(pConn->getClientID());
@@ -25,6 +25,7 @@
 #include <C4UserMessages.h>
 #include <C4Log.h>
 #include <C4Game.h>
+#include <C4Trace.h>
 
 #ifndef _WIN32
 #include <sys/socket.h>
@@ -566,6 +567,7 @@ void C4Network2IO::OnDisconn(const C4NetIO::addr_t &addr, C4NetIO *pNetIO, const
 
 void C4Network2IO::OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO)
 {
+	C4TRACE_ZONE("C4Network2IO::OnPacket");
 #if (C4NET2IO_DUMP_LEVEL > 1)
 	unsigned int iTime = timeGetTime();
 	logger->debug("OnPacket: {}:{:02}:{:02}:{:03}: status {:02x} {}",
@@ -805,6 +807,8 @@ bool C4Network2IO::doAutoAccept(const C4ClientCore &CCore, const C4Network2IOCon
 
 bool C4Network2IO::HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnection *pConn, bool fThread)
 {
+	C4TRACE_ZONE("C4Network2IO::HandlePacket");
+
 	// security: add connection reference
 	if (!pConn) return false; pConn->AddRef();
 
@@ -300,6 +300,7 @@ C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
 	ControlCounter = 0;
 	// init graphs
 	statObjCount.SetTitle(LoadResStr(C4ResStrTableKey::IDS_MSG_OBJCOUNT));
+	statTexUpload.SetTitle(LoadResStr(C4ResStrTableKey::IDS_MSG_TEXUPLOAD));
 	statFPS.SetTitle(LoadResStr(C4ResStrTableKey::IDS_MSG_FPS));
 	statNetI.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_INPUT));
 	statNetI.SetColorDw(0x00ff00);
@@ -326,6 +327,7 @@ C4Network2Stats::~C4Network2Stats()
 void C4Network2Stats::ExecuteFrame()
 {
 	statObjCount.RecordValue(C4Graph::ValueType(Game.Objects.ObjectCount()));
+	statTexUpload.RecordValue(C4Graph::ValueType(pTexMgr ? pTexMgr->TakeUploadedBytes() : 0));
 }
 
 void C4Network2Stats::ExecuteSecond()
@@ -373,6 +375,7 @@ C4Graph *C4Network2Stats::GetGraphByName(const StdStrBuf &rszName, bool &rfIsTem
 	rfIsTemp = false;
 	if (SEqualNoCase(rszName.getData(), "oc")) return &statObjCount;
 	if (SEqualNoCase(rszName.getData(), "fps")) return &statFPS;
+	if (SEqualNoCase(rszName.getData(), "texupload")) return &statTexUpload;
 	if (SEqualNoCase(rszName.getData(), "netio")) return &graphNetIO;
 	if (SEqualNoCase(rszName.getData(), "pings")) return &statPings;
 	if (SEqualNoCase(rszName.getData(), "control")) return &statControls;
@@ -171,6 +171,7 @@ private:
 
 	// per-frame stats
 	C4TableGraph statObjCount;
+	C4TableGraph statTexUpload; // bytes of texture changes uploaded
 
 	// per-second stats
 	C4TableGraph statFPS;
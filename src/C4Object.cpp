@@ -33,10 +33,13 @@
 #include <C4Wrappers.h>
 #include <C4Player.h>
 #include <C4ObjectMenu.h>
+#include <C4Trace.h>
+#include <C4DefExecProfiler.h>
 
 #include <cstring>
 #include <format>
 #include <limits>
+#include <optional>
 #include <utility>
 
 void DrawVertex(C4Facet &cgo, int32_t tx, int32_t ty, int32_t col, int32_t contact)
@@ -117,6 +120,7 @@ void C4Object::Default()
 	Timer = 0;
 	t_contact = 0;
 	OCF = 0;
+	fSleeping = false;
 	Action.Default();
 	Shape.Default();
 	fOwnVertices = 0;
@@ -136,6 +140,9 @@ void C4Object::Default()
 	Visibility = VIS_All;
 	LocalNamed.Reset();
 	Marker = 0;
+	ListOrder = 0;
+	PrevInstance = NextInstance = nullptr;
+	IndexedActionTargets.fill(nullptr);
 	ColorMod = BlitMode = 0;
 	CrewDisabled = false;
 	pLayer = nullptr;
@@ -164,7 +171,7 @@ bool C4Object::Init(C4Def *pDef, C4Object *pCreator,
 	Info = pInfo;
 	Def = pDef;
 	Category = Def->Category;
-	Def->Count++;
+	Def->AddInstance(this);
 	if (pCreator) pLayer = pCreator->pLayer;
 
 	// graphics
@@ -227,6 +234,10 @@ C4Object::~C4Object()
 {
 	Clear();
 
+	// remove from object indices
+	if (Status && Def) Def->UnlinkInstance(this);
+	Game.Objects.ClearIndices(this);
+
 #ifndef NDEBUG
 	// debug: mustn't be listed in any list now
 	assert(!Game.Objects.ObjectNumber(this));
@@ -281,7 +292,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 	}
 	Status = 0;
 	// count decrease
-	Def->Count--;
+	Def->RemoveInstance(this);
 	// Kill contents
 	C4Object *cobj; C4ObjectLink *clnk;
 	while ((clnk = Contents.First) && (cobj = clnk->Obj))
@@ -528,28 +539,10 @@ void C4Object::SetOCF()
 #ifdef DEBUGREC_OCF
 	uint32_t dwOCFOld = OCF;
 #endif
+	CheckContainer();
 	// Update the object character flag according to the object's current situation
-	C4Fixed cspeed = GetSpeed();
-#ifndef NDEBUG
-	if (Contained && !Game.Objects.ObjectNumber(Contained))
-	{
-		LogNTr(spdlog::level::warn, "Contained in wild object {}!", static_cast<void *>(Contained.Object()));
-	}
-	else if (Contained && !Contained->Status)
-	{
-		LogNTr(spdlog::level::warn, "Warning: contained in deleted object {} ({})!", static_cast<void *>(Contained.Object()), Contained->GetName());
-	}
-#endif
-	if (Contained)
-		InMat = Contained->Def->ClosedContainer ? MNone : Contained->InMat;
-	else
-		InMat = GBackMat(x, y);
 	// OCF_Normal: The OCF is never zero
 	OCF = OCF_Normal;
-	// OCF_Construct: Can be built outside
-	if (Def->Constructable && (Con < FullCon)
-		&& (r == 0) && !OnFire)
-		OCF |= OCF_Construct;
 	// OCF_Grab: Can be pushed
 	if (Def->Grab && !(Category & C4D_StaticBack))
 		OCF |= OCF_Grab;
@@ -567,12 +560,6 @@ void C4Object::SetOCF()
 	// OCF_FullCon: Is fully completed/grown
 	if (Con >= FullCon)
 		OCF |= OCF_FullCon;
-	// OCF_Chop: Can be chopped
-	uint32_t cocf = OCF_Exclusive;
-	if (Def->Chopable)
-		if (Category & C4D_StaticBack) // Must be static back: this excludes trees that have already been chopped
-			if (!Game.Objects.AtObject(x, y, cocf)) // Can only be chopped if the center is not blocked by an exclusive object
-				OCF |= OCF_Chop;
 	// OCF_Rotate: Can be rotated
 	if (Def->Rotateable)
 		// Don't rotate minimum (invisible) construction sites
@@ -581,33 +568,12 @@ void C4Object::SetOCF()
 	// OCF_Exclusive: No action through this, no construction in front of this
 	if (Def->Exclusive)
 		OCF |= OCF_Exclusive;
-	// OCF_Entrance: Can currently be entered/activated
-	if ((Def->Entrance.Wdt > 0) && (Def->Entrance.Hgt > 0))
-		if ((OCF & OCF_FullCon) && ((Def->RotatedEntrance == 1) || (r <= Def->RotatedEntrance)))
-			OCF |= OCF_Entrance;
-	// HitSpeeds
-	if (cspeed >= HitSpeed1) OCF |= OCF_HitSpeed1;
-	if (cspeed >= HitSpeed2) OCF |= OCF_HitSpeed2;
-	if (cspeed >= HitSpeed3) OCF |= OCF_HitSpeed3;
-	if (cspeed >= HitSpeed4) OCF |= OCF_HitSpeed4;
-	// OCF_Collection
-	if ((OCF & OCF_FullCon) || Def->IncompleteActivity)
-		if ((Def->Collection.Wdt > 0) && (Def->Collection.Hgt > 0))
-			if (!Def->CollectionLimit || (Contents.ObjectCount() < Def->CollectionLimit))
-				if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
-					if (NoCollectDelay == 0)
-						OCF |= OCF_Collection;
 	// OCF_Living
 	if (Category & C4D_Living)
 	{
 		OCF |= OCF_Living;
 		if (Alive) OCF |= OCF_Alive;
 	}
-	// OCF_FightReady
-	if (OCF & OCF_Alive)
-		if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
-			if (!Def->NoFight)
-				OCF |= OCF_FightReady;
 	// OCF_LineConstruct
 	if (OCF & OCF_FullCon)
 		if (Def->LineConnect & ~C4D_EnergyHolder)
@@ -624,40 +590,15 @@ void C4Object::SetOCF()
 	if (Def->AttractLightning)
 		if (OCF & OCF_FullCon)
 			OCF |= OCF_AttractLightning;
-	// OCF_NotContained
-	if (!Contained)
-		OCF |= OCF_NotContained;
 	// OCF_Edible
 	if (Def->Edible)
 		OCF |= OCF_Edible;
-	// OCF_InLiquid
-	if (InLiquid)
-		if (!Contained)
-			OCF |= OCF_InLiquid;
-	// OCF_InSolid
-	if (!Contained)
-		if (GBackSolid(x, y))
-			OCF |= OCF_InSolid;
-	// OCF_InFree
-	if (!Contained)
-		if (!GBackSemiSolid(x, y - 1))
-			OCF |= OCF_InFree;
-	// OCF_Available
-	if (!Contained || (Contained->Def->GrabPutGet & C4D_Grab_Get) || (Contained->OCF & OCF_Entrance))
-		if (!GBackSemiSolid(x, y - 1) || (!GBackSolid(x, y - 1) && !GBackSemiSolid(x, y - 8)))
-			OCF |= OCF_Available;
 	// OCF_PowerConsumer
 	if (Def->LineConnect & C4D_Power_Consumer)
 		if (OCF & OCF_FullCon)
 			OCF |= OCF_PowerConsumer;
-	// OCF_PowerSupply
-	if ((Def->LineConnect & C4D_Power_Generator)
-		|| ((Def->LineConnect & C4D_Power_Output) && (Energy > 0)))
-		if (OCF & OCF_FullCon)
-			OCF |= OCF_PowerSupply;
-	// OCF_Container
-	if ((Def->GrabPutGet & C4D_Grab_Put) || (Def->GrabPutGet & C4D_Grab_Get) || (OCF & OCF_Entrance))
-		OCF |= OCF_Container;
+	// Fluctuant flags
+	OCF |= GetStateOCF() | GetSpeedOCF() | GetChopOCF() | GetLandscapeOCF();
 #ifdef DEBUGREC_OCF
 	assert(!dwOCFOld || ((dwOCFOld & OCF_Carryable) == (OCF & OCF_Carryable)));
 	C4RCOCF rc = { dwOCFOld, OCF, false };
@@ -670,97 +611,134 @@ void C4Object::UpdateOCF()
 #ifdef DEBUGREC_OCF
 	uint32_t dwOCFOld = OCF;
 #endif
-	// Update the object character flag according to the object's current situation
-	C4Fixed cspeed = GetSpeed();
+	CheckContainer();
+	// Keep the bits that only have to be updated with SetOCF (def, category, con, alive, onfire)
+	OCF = OCF & (OCF_Normal | OCF_Carryable | OCF_Exclusive | OCF_Edible | OCF_Grab | OCF_FullCon
+		| OCF_Rotate | OCF_OnFire | OCF_Inflammable | OCF_Living | OCF_Alive
+		| OCF_LineConstruct | OCF_Prey | OCF_CrewMember | OCF_AttractLightning
+		| OCF_PowerConsumer);
+	// Update the fluctuant flags according to the object's current situation
+	OCF |= GetStateOCF() | GetSpeedOCF() | GetChopOCF() | GetLandscapeOCF();
+#ifdef DEBUGREC_OCF
+	C4RCOCF rc = { dwOCFOld, OCF, true };
+	AddDbgRec(RCT_OCF, &rc, sizeof(rc));
+#endif
+#ifndef NDEBUG
+	DEBUGREC_OFF
+		uint32_t updateOCF = OCF;
+	SetOCF();
+	assert(updateOCF == OCF);
+	DEBUGREC_ON
+#endif
+}
+
+void C4Object::CheckContainer()
+{
 #ifndef NDEBUG
 	if (Contained && !Game.Objects.ObjectNumber(Contained))
 	{
-		LogNTr(spdlog::level::warn, "contained in wild object {}!", static_cast<void *>(Contained.Object()));
+		LogNTr(spdlog::level::warn, "Contained in wild object {}!", static_cast<void *>(Contained.Object()));
 	}
 	else if (Contained && !Contained->Status)
 	{
-		LogNTr(spdlog::level::warn, "contained in deleted object {} ({})!", static_cast<void *>(Contained.Object()), Contained->GetName());
+		LogNTr(spdlog::level::warn, "Contained in deleted object {} ({})!", static_cast<void *>(Contained.Object()), Contained->GetName());
 	}
 #endif
-	if (Contained)
-		InMat = Contained->Def->ClosedContainer ? MNone : Contained->InMat;
-	else
-		InMat = GBackMat(x, y);
-	// Keep the bits that only have to be updated with SetOCF (def, category, con, alive, onfire)
-	OCF = OCF & (OCF_Normal | OCF_Carryable | OCF_Exclusive | OCF_Edible | OCF_Grab | OCF_FullCon
-		/*| OCF_Chop - now updated regularly, see below */
-		| OCF_Rotate | OCF_OnFire | OCF_Inflammable | OCF_Living | OCF_Alive
-		| OCF_LineConstruct | OCF_Prey | OCF_CrewMember | OCF_AttractLightning
-		| OCF_PowerConsumer);
+}
+
+uint32_t C4Object::GetStateOCF()
+{
+	// Depends on the definition, the flags kept by UpdateOCF and the object's own state
+	uint32_t ocf = 0;
 	// OCF_Construct: Can be built outside
 	if (Def->Constructable && (Con < FullCon)
 		&& (r == 0) && !OnFire)
-		OCF |= OCF_Construct;
+		ocf |= OCF_Construct;
 	// OCF_Entrance: Can currently be entered/activated
 	if ((Def->Entrance.Wdt > 0) && (Def->Entrance.Hgt > 0))
 		if ((OCF & OCF_FullCon) && ((Def->RotatedEntrance == 1) || (r <= Def->RotatedEntrance)))
-			OCF |= OCF_Entrance;
-	// OCF_Chop: Can be chopped
-	uint32_t cocf = OCF_Exclusive;
-	if (Def->Chopable)
-		if (Category & C4D_StaticBack) // Must be static back: this excludes trees that have already been chopped
-			if (!Game.Objects.AtObject(x, y, cocf)) // Can only be chopped if the center is not blocked by an exclusive object
-				OCF |= OCF_Chop;
-	// HitSpeeds
-	if (cspeed >= HitSpeed1) OCF |= OCF_HitSpeed1;
-	if (cspeed >= HitSpeed2) OCF |= OCF_HitSpeed2;
-	if (cspeed >= HitSpeed3) OCF |= OCF_HitSpeed3;
-	if (cspeed >= HitSpeed4) OCF |= OCF_HitSpeed4;
+			ocf |= OCF_Entrance;
 	// OCF_Collection
 	if ((OCF & OCF_FullCon) || Def->IncompleteActivity)
 		if ((Def->Collection.Wdt > 0) && (Def->Collection.Hgt > 0))
 			if (!Def->CollectionLimit || (Contents.ObjectCount() < Def->CollectionLimit))
 				if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
 					if (NoCollectDelay == 0)
-						OCF |= OCF_Collection;
+						ocf |= OCF_Collection;
 	// OCF_FightReady
 	if (OCF & OCF_Alive)
 		if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
 			if (!Def->NoFight)
-				OCF |= OCF_FightReady;
-	// OCF_NotContained
-	if (!Contained)
-		OCF |= OCF_NotContained;
-	// OCF_InLiquid
-	if (InLiquid)
-		if (!Contained)
-			OCF |= OCF_InLiquid;
-	// OCF_InSolid
-	if (!Contained)
-		if (GBackSolid(x, y))
-			OCF |= OCF_InSolid;
-	// OCF_InFree
-	if (!Contained)
-		if (!GBackSemiSolid(x, y - 1))
-			OCF |= OCF_InFree;
-	// OCF_Available
-	if (!Contained || (Contained->Def->GrabPutGet & C4D_Grab_Get) || (Contained->OCF & OCF_Entrance))
-		if (!GBackSemiSolid(x, y - 1) || (!GBackSolid(x, y - 1) && !GBackSemiSolid(x, y - 8)))
-			OCF |= OCF_Available;
+				ocf |= OCF_FightReady;
 	// OCF_PowerSupply
 	if ((Def->LineConnect & C4D_Power_Generator)
 		|| ((Def->LineConnect & C4D_Power_Output) && (Energy > 0)))
 		if (OCF & OCF_FullCon)
-			OCF |= OCF_PowerSupply;
+			ocf |= OCF_PowerSupply;
 	// OCF_Container
-	if ((Def->GrabPutGet & C4D_Grab_Put) || (Def->GrabPutGet & C4D_Grab_Get) || (OCF & OCF_Entrance))
-		OCF |= OCF_Container;
-#ifdef DEBUGREC_OCF
-	C4RCOCF rc = { dwOCFOld, OCF, true };
-	AddDbgRec(RCT_OCF, &rc, sizeof(rc));
-#endif
-#ifndef NDEBUG
-	DEBUGREC_OFF
-		uint32_t updateOCF = OCF;
-	SetOCF();
-	assert(updateOCF == OCF);
-	DEBUGREC_ON
-#endif
+	if ((Def->GrabPutGet & C4D_Grab_Put) || (Def->GrabPutGet & C4D_Grab_Get) || (ocf & OCF_Entrance))
+		ocf |= OCF_Container;
+	return ocf;
+}
+
+uint32_t C4Object::GetSpeedOCF()
+{
+	// HitSpeeds
+	const C4Fixed cspeed = GetSpeed();
+	uint32_t ocf = 0;
+	if (cspeed >= HitSpeed1) ocf |= OCF_HitSpeed1;
+	if (cspeed >= HitSpeed2) ocf |= OCF_HitSpeed2;
+	if (cspeed >= HitSpeed3) ocf |= OCF_HitSpeed3;
+	if (cspeed >= HitSpeed4) ocf |= OCF_HitSpeed4;
+	return ocf;
+}
+
+uint32_t C4Object::GetChopOCF()
+{
+	// OCF_Chop: Can be chopped
+	uint32_t cocf = OCF_Exclusive;
+	if (Def->Chopable)
+		if (Category & C4D_StaticBack) // Must be static back: this excludes trees that have already been chopped
+			if (!Game.Objects.AtObject(x, y, cocf)) // Can only be chopped if the center is not blocked by an exclusive object
+				return OCF_Chop;
+	return 0;
+}
+
+uint32_t C4Object::GetLandscapeOCF()
+{
+	// Reads every landscape pixel at most once
+	C4Landscape &landscape = Game.Landscape;
+	uint32_t ocf = 0;
+	if (Contained)
+	{
+		InMat = Contained->Def->ClosedContainer ? MNone : Contained->InMat;
+		// Contents are only available in containers that allow getting them
+		if (!(Contained->Def->GrabPutGet & C4D_Grab_Get) && !(Contained->OCF & OCF_Entrance))
+			return 0;
+	}
+	else
+	{
+		const uint8_t pix = landscape.GetPix(x, y);
+		InMat = landscape.GetPixMat(pix);
+		// OCF_NotContained
+		ocf |= OCF_NotContained;
+		// OCF_InLiquid
+		if (InLiquid)
+			ocf |= OCF_InLiquid;
+		// OCF_InSolid
+		if (DensitySolid(landscape.GetPixDensity(pix)))
+			ocf |= OCF_InSolid;
+	}
+	// OCF_InFree and OCF_Available: free above or only a thin layer of liquid
+	const int32_t densityAbove = landscape.GetDensity(x, y - 1);
+	if (!DensitySemiSolid(densityAbove))
+	{
+		if (!Contained) ocf |= OCF_InFree;
+		ocf |= OCF_Available;
+	}
+	else if (!DensitySolid(densityAbove) && !GBackSemiSolid(x, y - 8))
+		ocf |= OCF_Available;
+	return ocf;
 }
 
 bool C4Object::ExecFire(int32_t iFireNumber, int32_t iCausedByPlr)
@@ -1042,10 +1020,9 @@ void C4Object::ExecBase()
 	}
 }
 
-void C4Object::Execute()
-{
 #ifdef DEBUGREC
-	// record debug
+void C4Object::AddExecDbgRec()
+{
 	C4RCExecObj rc;
 	rc.Number = Number;
 	rc.id = Def->id;
@@ -1053,33 +1030,56 @@ void C4Object::Execute()
 	rc.fy = fix_y;
 	rc.fr = fix_r;
 	AddDbgRec(RCT_ExecObj, &rc, sizeof(rc));
+}
+#endif
+
+void C4Object::Execute()
+{
+	C4TRACE_ZONE("C4Object::Execute");
+
+#ifdef DEBUGREC
+	// record debug
+	AddExecDbgRec();
 #endif
+	C4DefExecProfiler::Timer profilerTimer{Def};
+	// still set if sleeping objects are verified
+	const bool fWasSleeping{fSleeping};
+	fSleeping = false;
+	std::optional<C4ObjectSleepState> sleepState;
+	if (MaySleep()) sleepState = GetSleepState();
 	// OCF
 	UpdateOCF();
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_OCF);
 	// Command
 	ExecuteCommand();
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Command);
 	// Action
 	// need not check status, because dead objects have lost their action
 	ExecAction();
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Action);
 	// commands and actions are likely to have removed the object, and movement
 	// *must not* be executed for dead objects (SolidMask-errors)
 	if (!Status) return;
 	// Movement
 	ExecMovement();
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Movement);
 	if (!Status) return;
 	// particles
 	if (BackParticles) BackParticles.Exec(this);
 	if (FrontParticles) FrontParticles.Exec(this);
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Particles);
 	// effects
 	if (pEffects)
 	{
 		pEffects->Execute(this);
+		profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Effects);
 		if (!Status) return;
 	}
 	// Life
 	ExecLife();
 	// Base
 	ExecBase();
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Other);
 	// Timer
 	Timer++;
 	if (Timer >= Def->Timer)
@@ -1087,11 +1087,96 @@ void C4Object::Execute()
 		Timer = 0;
 		// TimerCall
 		if (Def->TimerCall) Def->TimerCall->Exec(this);
+		profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Timer);
 	}
 	// Menu
 	if (Menu) Menu->Execute();
 	// View delays
 	if (ViewEnergy > 0) ViewEnergy--;
+	// Sleep if the next executions would do the same as this one
+	if (sleepState && MaySleep() && *sleepState == GetSleepState())
+	{
+		fSleeping = true;
+		SleepState = *sleepState;
+	}
+	else if (fWasSleeping)
+	{
+		LogNTr(spdlog::level::warn, "Object sleep verification failed: {} (#{}) changed in frame {}", GetName(), Number, Game.FrameCounter);
+	}
+	profilerTimer.EndPhase(C4DefExecProfiler::PHASE_Other);
+}
+
+bool C4Object::SkipSleepingExecute()
+{
+	if (!fSleeping) return false;
+	// Changed by other objects, scripts or the landscape
+	if (GetSleepState() != SleepState)
+	{
+		fSleeping = false;
+		return false;
+	}
+	// Periodic checks: gravity mobilization, structures digging free snow, timer call
+	if ((!Tick10 && !(Category & C4D_StaticBack))
+		|| (!Tick35 && (Category & C4D_Structure))
+		|| (Def->TimerCall && Timer + 1 >= Def->Timer))
+	{
+		fSleeping = false;
+		return false;
+	}
+	// Verification: execute anyway and check that nothing changes
+	if (Config.Developer.VerifyObjectSleep) return false;
+#ifdef DEBUGREC
+	// record the skipped execution like an executed one, so records with and without sleeping can be compared
+	AddExecDbgRec();
+#endif
+	// The timer keeps running
+	Timer++;
+	if (Timer >= Def->Timer) Timer = 0;
+	return true;
+}
+
+bool C4Object::MaySleep()
+{
+	// Off until verified with replays
+	if (!Config.Developer.ObjectSleep && !Config.Developer.VerifyObjectSleep) return false;
+	// Anything depending on other objects
+	if (!Status || Contained || Mobile || Command || pEffects || Menu || Alive || OnFire) return false;
+	if (Action.Act > ActIdle) return false;
+	if (BackParticles || FrontParticles) return false;
+	// OCF_Chop depends on exclusive objects at the center
+	if (Def->Chopable && (Category & C4D_StaticBack)) return false;
+	// Stabilization depends on the landscape around the shape
+	if (!(Category & C4D_StaticBack) && !Def->NoStabilize)
+	{
+		int32_t nr = r; while (nr < -180) nr += 360; while (nr > 180) nr -= 360;
+		if (nr != 0 && Inside<int32_t>(nr, -StableRange, +StableRange)) return false;
+	}
+	// Periodic growth, energy loss, incineration and base execution
+	if (Def->Growth && (Category & C4D_StaticBack) && Con < FullCon) return false;
+	if (Energy && !(Category & C4D_Living) && !(Def->LineConnect & C4D_EnergyHolder)) return false;
+	if (InMat != MNone && Game.Material.Map[InMat].Incindiary && Def->ContactIncinerate) return false;
+	if (Base != NO_OWNER || (Def->CanBeBase && Contents.ObjectCount())) return false;
+	return true;
+}
+
+C4ObjectSleepState C4Object::GetSleepState()
+{
+	return {
+		.x = x, .y = y, .r = r,
+		.fix_x = fix_x, .fix_y = fix_y, .fix_r = fix_r,
+		.xdir = xdir, .ydir = ydir, .rdir = rdir,
+		.Category = Category, .Con = Con, .Energy = Energy, .ViewEnergy = ViewEnergy, .NoCollectDelay = NoCollectDelay, .Base = Base, .InMat = InMat,
+		.ContentsCount = Contents.ObjectCount(),
+		.Act = Action.Act, .t_attach = Action.t_attach,
+		.OCF = OCF,
+		.Mobile = Mobile, .InLiquid = InLiquid, .OnFire = OnFire, .Alive = Alive, .Particles = BackParticles || FrontParticles,
+		.Def = Def,
+		.Contained = Contained,
+		.Command = Command,
+		.pEffects = pEffects,
+		.Menu = Menu,
+		.Pix = {GBackPix(x, y), GBackPix(x, y - 1), GBackPix(x, y - 8)}
+	};
 }
 
 bool C4Object::At(int32_t ctx, int32_t cty)
@@ -1192,11 +1277,11 @@ bool C4Object::ChangeDef(C4ID idNew)
 	SetDir(0); // will drop any outdated flipdir
 	if (pSolidMaskData) pSolidMaskData->Remove(true, false);
 	delete pSolidMaskData; pSolidMaskData = nullptr;
-	Def->Count--;
+	Def->RemoveInstance(this);
 	// Def change
 	Def = pDef;
 	id = pDef->id;
-	Def->Count++;
+	Def->AddInstance(this);
 	LocalNamed.SetNameList(&pDef->Script.LocalNamed);
 	// new def: Needs to be resorted
 	Unsorted = true;
@@ -2172,6 +2257,7 @@ void C4Object::ClearPointers(C4Object *pObj)
 	// Action targets
 	if (Action.Target == pObj) Action.Target = nullptr;
 	if (Action.Target2 == pObj) Action.Target2 = nullptr;
+	Game.Objects.UpdateActionTargets(this);
 	// Commands
 	C4Command *cCom;
 	for (cCom = Command; cCom; cCom = cCom->Next)
@@ -2817,6 +2903,7 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 					break;
 				pCmd->cObj = this;
 			}
+			Game.Objects.UpdateCommands(this);
 		}
 		else
 		{
@@ -2832,7 +2919,7 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 	if (fCompiler)
 	{
 		// add to def count
-		Def->Count++;
+		Def->AddInstance(this);
 
 		// set local variable names
 		LocalNamed.SetNameList(&Def->Script.LocalNamed);
@@ -2887,6 +2974,7 @@ void C4Object::EnumeratePointers()
 void C4Object::DenumeratePointers()
 {
 	DenumerateObjectPtrs(Contained, Action.Target, Action.Target2, pLayer);
+	Game.Objects.UpdateActionTargets(this);
 
 	// Post-compile object list
 	Contents.DenumerateRead();
@@ -3855,6 +3943,7 @@ void C4Object::ClearCommands()
 			Command->iExec = 2;
 		Command = pNext;
 	}
+	Game.Objects.UpdateCommands(this);
 }
 
 void C4Object::ClearCommand(C4Command *pUntil)
@@ -3872,6 +3961,7 @@ void C4Object::ClearCommand(C4Command *pUntil)
 		else
 			pCom->iExec = 2;
 	}
+	Game.Objects.UpdateCommands(this);
 }
 
 bool C4Object::AddCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int32_t iTy,
@@ -3903,6 +3993,7 @@ bool C4Object::AddCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		pCom->Next = Command;
 		Command = pCom;
 	}
+	Game.Objects.UpdateCommands(this);
 	// Success
 	return true;
 }
@@ -4121,6 +4212,7 @@ bool C4Object::SetAction(int32_t iAct, C4Object *pTarget, C4Object *pTarget2, in
 	// Set target if specified
 	if (pTarget) Action.Target = pTarget;
 	if (pTarget2) Action.Target2 = pTarget2;
+	if (pTarget || pTarget2) Game.Objects.UpdateActionTargets(this);
 
 	// Set Action Facet
 	UpdateActionFace();
@@ -5156,6 +5248,7 @@ void C4Object::ExecAction()
 			GrabLost(this);
 			// Lose target
 			Action.Target = nullptr;
+			Game.Objects.UpdateActionTargets(this);
 			// Done
 			return;
 		}
@@ -83,6 +83,7 @@ const int32_t MagicPhysicalFactor = 1000;
 #define ANY_CONTAINER (123)
 #define NO_CONTAINER  (124)
 
+class C4ObjectMenu;
 class C4SolidMask;
 
 class C4Action
@@ -114,6 +115,31 @@ public:
 	void GetBridgeData(int32_t &riBridgeTime, bool &rfMoveClonk, bool &rfWall, int32_t &riBridgeMaterial);
 };
 
+// Everything C4Object::Execute reads or changes for a resting object.
+// An object falls asleep when an execution left this state unchanged and the object does nothing
+// that depends on other objects or on the frame (see C4Object::MaySleep). As long as the state stays the
+// same, every further execution would not change anything either, so it is skipped entirely.
+// Any change by other objects, scripts or the landscape wakes the object up at its place in the
+// execution order, so sleeping never changes the outcome of a frame and is invisible to the sync.
+struct C4ObjectSleepState
+{
+	int32_t x, y, r;
+	C4Fixed fix_x, fix_y, fix_r;
+	C4Fixed xdir, ydir, rdir;
+	int32_t Category, Con, Energy, ViewEnergy, NoCollectDelay, Base, InMat, ContentsCount;
+	int32_t Act, t_attach;
+	uint32_t OCF;
+	bool Mobile, InLiquid, OnFire, Alive, Particles;
+	const C4Def *Def;
+	const C4Object *Contained;
+	const C4Command *Command;
+	const C4Effect *pEffects;
+	const C4ObjectMenu *Menu;
+	std::array<uint8_t, 3> Pix; // landscape at the positions checked by UpdateOCF
+
+	bool operator==(const C4ObjectSleepState &) const = default;
+};
+
 class C4Object
 {
 public:
@@ -160,6 +186,9 @@ public:
 	uint32_t OCF;
 	int32_t Visibility;
 	uint32_t Marker; // state var used by Objects::CrossCheck and C4FindObject - NoSave
+	uint64_t ListOrder; // position in main object list used by object indices; 0 if not in main list - NoSave
+	C4Object *PrevInstance, *NextInstance; // other objects counted in Def->Count; see C4Def::FirstInstance - NoSave
+	std::array<C4Object *, 2> IndexedActionTargets; // action targets as listed in Game.Objects action target index - NoSave
 	C4EnumeratedObjectPtr pLayer; // layer-object containing this object
 	C4DrawTransform *pDrawTransform; // assigned drawing transformation
 
@@ -198,6 +227,9 @@ public:
 
 	C4Value *FirstRef; // No-Save
 
+	bool fSleeping; // NoSave // executions are skipped while SleepState doesn't change
+	C4ObjectSleepState SleepState; // NoSave //
+
 	class C4GraphicsOverlay *pGfxOverlay; // singly linked list of overlay graphics
 
 protected:
@@ -271,6 +303,7 @@ public:
 	void DrawTopFace(C4FacetEx &cgo, int32_t iByPlayer = -1, DrawMode eDrawMode = ODM_Normal);
 	void DrawFace(C4FacetEx &cgo, int32_t cgoX, int32_t cgoY, int32_t iPhaseX = 0, int32_t iPhaseY = 0);
 	void Execute();
+	bool SkipSleepingExecute(); // called instead of Execute; returns whether the object is still asleep
 	void ClearPointers(C4Object *ptr);
 	bool ExecMovement();
 	bool ExecFire(int32_t iIndex, int32_t iCausedByPlr);
@@ -285,6 +318,17 @@ public:
 	void Stabilize();
 	void SetOCF();
 	void UpdateOCF(); // Update fluctuant OCF
+	void CheckContainer(); // debug warnings about invalid containers
+	// fluctuant OCF groups, computed the same way by SetOCF and UpdateOCF
+	uint32_t GetStateOCF(); // depends on own state and the flags only updated by SetOCF
+	uint32_t GetSpeedOCF();
+	uint32_t GetChopOCF(); // depends on other objects
+	uint32_t GetLandscapeOCF(); // depends on the landscape or the container; also updates InMat
+	bool MaySleep();
+#ifdef DEBUGREC
+	void AddExecDbgRec();
+#endif
+	C4ObjectSleepState GetSleepState();
 	void UpdateShape(bool bUpdateVertices = true);
 	void UpdatePos(); // pos/shape changed
 	void UpdateSolidMask(bool fRestoreAttachedObjects);
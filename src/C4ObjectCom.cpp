@@ -373,6 +373,7 @@ C4Object *CreateLine(C4ID idType, int32_t iOwner, C4Object *pFrom, C4Object *pTo
 	pLine->Shape.VtxY[1] = pTo->y + pTo->Shape.Hgt / 4;
 	pLine->Action.Target = pFrom;
 	pLine->Action.Target2 = pTo;
+	Game.Objects.UpdateActionTargets(pLine);
 	return pLine;
 }
 
@@ -421,6 +422,7 @@ bool ObjectComLineConstruction(C4Object *cObj)
 		StartSoundEffect("Connect", false, 100, cObj);
 		if (cline->Action.Target  == tstruct) cline->Action.Target  = linekit;
 		if (cline->Action.Target2 == tstruct) cline->Action.Target2 = linekit;
+		Game.Objects.UpdateActionTargets(cline);
 		// Message
 		GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_DISCONNECT, cline->GetName(), tstruct->GetName()).c_str(), tstruct);
 		return true;
@@ -476,6 +478,7 @@ bool ObjectComLineConstruction(C4Object *cObj)
 		StartSoundEffect("Connect", false, 100, cObj);
 		if (cline->Action.Target == linekit) cline->Action.Target = tstruct;
 		if (cline->Action.Target2 == linekit) cline->Action.Target2 = tstruct;
+		Game.Objects.UpdateActionTargets(cline);
 		linekit->Exit();
 		linekit->AssignRemoval();
 
@@ -18,6 +18,7 @@
 
 #include <C4Include.h>
 #include <C4ObjectList.h>
+#include <C4StaticLayer.h>
 
 #include <C4Object.h>
 #include <C4Wrappers.h>
@@ -408,11 +409,13 @@ void C4ObjectList::DrawIfCategory(C4FacetEx &cgo, int iPlayer, uint32_t dwCat, b
 			clnk->Obj->DrawTopFace(cgo, iPlayer);
 }
 
-void C4ObjectList::Draw(C4FacetEx &cgo, int iPlayer)
+void C4ObjectList::Draw(C4FacetEx &cgo, int iPlayer, C4StaticLayer *pStaticLayer)
 {
-	C4ObjectLink *clnk;
+	C4ObjectLink *clnk = Last;
+	// Draw static objects at the back of the list from cached layers
+	if (pStaticLayer) clnk = pStaticLayer->Draw(cgo, iPlayer, clnk);
 	// Draw objects (base)
-	for (clnk = Last; clnk; clnk = clnk->Prev)
+	for (; clnk; clnk = clnk->Prev)
 		if (!(clnk->Obj->Category & C4D_BackgroundOrForeground))
 			clnk->Obj->Draw(cgo, iPlayer);
 	// Draw objects (top face)
@@ -28,6 +28,7 @@
 
 class C4Object;
 class C4FacetEx;
+class C4StaticLayer;
 
 constexpr std::int32_t
 	C4EnumPointer1 = 1000000000,
@@ -92,7 +93,7 @@ public:
 	void Copy(const C4ObjectList &rList);
 	void DrawAll(C4FacetEx &cgo, int iPlayer = -1); // draw all objects, including bg
 	void DrawIfCategory(C4FacetEx &cgo, int iPlayer, uint32_t dwCat, bool fInvert); // draw all objects that match dwCat (or don't match if fInvert)
-	void Draw(C4FacetEx &cgo, int iPlayer = -1); // draw all objects
+	void Draw(C4FacetEx &cgo, int iPlayer = -1, C4StaticLayer *pStaticLayer = nullptr); // draw all objects
 	void DrawIDList(C4Facet &cgo, int iSelection, C4DefList &rDefs, int32_t dwCategory, C4RegionList *pRegions = nullptr, int iRegionCom = COM_None, bool fDrawOneCounts = true);
 	void DrawSelectMark(C4FacetEx &cgo);
 	void CloseMenus();
@@ -50,28 +50,35 @@ void C4PXS::Execute()
 	}
 
 	// Material conversion
+	C4MaterialMap &rMaterials = Game.Material;
 	int32_t iX = fixtoi(x), iY = fixtoi(y);
 	inmat = GBackMat(iX, iY);
-	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
-	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, Mat, inmat, meePXSPos, nullptr))
-	{
-		Deactivate(); return;
-	}
+	if (const C4MaterialReactionCode iCode = rMaterials.GetReactionCodeUnsafe(meePXSPos, Mat, inmat))
+		if (rMaterials.React(iCode, iX, iY, iX, iY, xdir, ydir, Mat, inmat, meePXSPos, nullptr))
+		{
+			Deactivate(); return;
+		}
 
 	// Gravity
 	ydir += GravAccel;
 
-	if (GBackDensity(iX, iY + 1) < Game.Material.Map[Mat].Density)
+	const C4Material &rMat = rMaterials.Map[Mat];
+	if (GBackDensity(iX, iY + 1) < rMat.Density)
 	{
+		// Air friction, based on WindDrift. MaxSpeed is ignored.
+		int32_t iWindDrift = (std::max)(rMat.WindDrift - 20, 0);
+
 		// Air speed: Wind plus some random
+		// the random values are drawn in this order in any case to keep the game in sync
 		int32_t iWind = GBackWind(iX, iY);
 		C4Fixed txdir = itofix(iWind, 15) + FIXED256(Random(1200) - 600);
 		C4Fixed tydir = FIXED256(Random(1200) - 600);
 
-		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = (std::max)(Game.Material.Map[Mat].WindDrift - 20, 0);
-		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
-		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
+		if (iWindDrift)
+		{
+			xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
+			ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
+		}
 	}
 
 	C4Fixed ctcox = x + xdir;
@@ -96,9 +103,8 @@ void C4PXS::Execute()
 		int32_t inX = iX + Sign(iToX - iX), inY = iY + Sign(iToY - iY);
 		// Contact?
 		inmat = GBackMat(inX, inY);
-		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
-		if (pReact)
-			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, Mat, inmat, meePXSMove, &fStopMovement))
+		if (const C4MaterialReactionCode iCode = rMaterials.GetReactionCodeUnsafe(meePXSMove, Mat, inmat))
+			if (rMaterials.React(iCode, iX, iY, inX, inY, xdir, ydir, Mat, inmat, meePXSMove, &fStopMovement))
 			{
 				// destructive contact
 				Deactivate();
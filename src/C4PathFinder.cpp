@@ -39,6 +39,12 @@
    SetCompletePath don't set move-to waypoint if setting use-zone waypoint (is
    done by C4Command::Transfer on demand and would only cause no-good-entry-point
    move-to's on crawl-zone-entries).
+
+   Navigation graph
+   Find first queries a coarse graph of walkable surface segments which is kept
+   across requests and rebuilt sector by sector when the landscape changes. The
+   ray tracer is only run if the graph can't answer the request (start or target
+   not above ground, no connection within the node limit).
 */
 
 #include <C4Include.h>
@@ -46,6 +52,12 @@
 
 #include <C4FacetEx.h>
 #include <C4Game.h>
+#include <C4Wrappers.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
 
 const int32_t C4PF_MaxDepth  = 35,
               C4PF_MaxCrawl  = 800,
@@ -68,7 +80,15 @@ const int32_t C4PF_MaxDepth  = 35,
               C4PF_Crawl_Bottom   = 3,
               C4PF_Crawl_Left     = 4,
 
-              C4PF_Draw_Rate = 10;
+              C4PF_Draw_Rate = 10,
+
+              C4PF_Graph_MaxStep      = 2,  // max height difference of neighbouring surface columns to be walkable
+              C4PF_Graph_MaxLinkDist  = 40, // max horizontal distance and drop height of jump links
+              C4PF_Graph_MaxEndLinks  = 8,  // max jump links per segment end
+              C4PF_Graph_Clearance    = 6,  // points are lifted this far above the surface for line checks
+              C4PF_Graph_AnchorDepth  = 64, // max distance of start and target above ground
+              C4PF_Graph_MaxNodes     = 2000,
+              C4PF_Graph_PullLookAhead = 12;
 
 // C4PathFinderRay
 
@@ -510,6 +530,457 @@ bool C4PathFinderRay::CheckBackRayShorten()
 	return false;
 }
 
+// C4PathFinderGraph
+
+C4PathFinderGraph::C4PathFinderGraph()
+{
+	Default();
+}
+
+void C4PathFinderGraph::Default()
+{
+	PointFree = nullptr;
+	Clear();
+}
+
+void C4PathFinderGraph::Clear()
+{
+	Width = Height = 0;
+	SectorsX = SectorsY = 0;
+	Sectors.clear();
+	LastPath.clear();
+}
+
+void C4PathFinderGraph::Init(bool(*fnPointFree)(int32_t, int32_t))
+{
+	Clear();
+	PointFree = fnPointFree;
+}
+
+void C4PathFinderGraph::InvalidateAll()
+{
+	// Layout is recreated on next request
+	Sectors.clear();
+	LastPath.clear();
+}
+
+void C4PathFinderGraph::Invalidate(const C4Rect &rect)
+{
+	if (Sectors.empty() || rect.Wdt <= 0 || rect.Hgt <= 0) return;
+	// One pixel margin: surface detection looks one pixel down
+	const int32_t x1 = std::max<int32_t>(rect.x - 1, 0) / SectorSize, x2 = std::min<int32_t>(rect.x + rect.Wdt, Width - 1) / SectorSize;
+	const int32_t y1 = std::max<int32_t>(rect.y - 1, 0) / SectorSize, y2 = std::min<int32_t>(rect.y + rect.Hgt, Height - 1) / SectorSize;
+	for (int32_t y = y1; y <= y2; ++y)
+		for (int32_t x = x1; x <= x2; ++x)
+			Sectors[y * SectorsX + x].Dirty = true;
+}
+
+bool C4PathFinderGraph::EnsureLayout()
+{
+	if (!PointFree || GBackWdt <= 0 || GBackHgt <= 0) return false;
+	if (!Sectors.empty() && Width == GBackWdt && Height == GBackHgt) return true;
+	Width = GBackWdt; Height = GBackHgt;
+	SectorsX = (Width + SectorSize - 1) / SectorSize;
+	SectorsY = (Height + SectorSize - 1) / SectorSize;
+	Sectors.clear();
+	Sectors.resize(SectorsX * SectorsY);
+	return true;
+}
+
+C4PathFinderGraph::Sector &C4PathFinderGraph::GetSector(const int32_t iIndex)
+{
+	Sector &sector = Sectors[iIndex];
+	if (sector.Dirty) BuildSegments(iIndex);
+	return sector;
+}
+
+C4PathFinderGraph::Sector &C4PathFinderGraph::GetLinkedSector(const int32_t iIndex)
+{
+	Sector &sector = GetSector(iIndex);
+	// Links depend on the segments of all neighbouring sectors
+	bool fValid = sector.LinksValid;
+	const int32_t sx = iIndex % SectorsX, sy = iIndex / SectorsX;
+	for (int32_t i = 0; i < 9; ++i)
+	{
+		const int32_t nx = sx + i % 3 - 1, ny = sy + i / 3 - 1;
+		const uint32_t revision = (Inside<int32_t>(nx, 0, SectorsX - 1) && Inside<int32_t>(ny, 0, SectorsY - 1)) ? GetSector(ny * SectorsX + nx).Revision : 0;
+		if (revision != sector.LinkRevisions[i]) fValid = false;
+	}
+	if (!fValid) BuildLinks(iIndex);
+	return sector;
+}
+
+void C4PathFinderGraph::BuildSegments(const int32_t iIndex)
+{
+	Sector &sector = Sectors[iIndex];
+	sector.Dirty = false;
+	sector.LinksValid = false;
+	++sector.Revision;
+	sector.Segments.clear();
+	sector.LinkStart.clear();
+	sector.Links.clear();
+
+	const int32_t x0 = (iIndex % SectorsX) * SectorSize, y0 = (iIndex / SectorsX) * SectorSize;
+	const int32_t x1 = std::min<int32_t>(x0 + SectorSize, Width), y1 = std::min<int32_t>(y0 + SectorSize, Height);
+	// Segments that reached the previous column and may be continued
+	std::vector<int32_t> open, nextOpen;
+	for (int32_t x = x0; x < x1; ++x)
+	{
+		nextOpen.clear();
+		bool fFree = PointFree(x, y0);
+		for (int32_t y = y0; y < y1; ++y)
+		{
+			const bool fFreeBelow = PointFree(x, y + 1);
+			const bool fSurface = fFree && !fFreeBelow;
+			fFree = fFreeBelow;
+			if (!fSurface) continue;
+			// Continue closest segment of previous column
+			auto best = open.end();
+			int32_t iBestDist = C4PF_Graph_MaxStep + 1;
+			for (auto it = open.begin(); it != open.end(); ++it)
+				if (const int32_t iDist = Abs(sector.Segments[*it].Y.back() - y); iDist < iBestDist)
+				{
+					best = it; iBestDist = iDist;
+				}
+			int32_t iSegment;
+			if (best != open.end())
+			{
+				iSegment = *best;
+				open.erase(best);
+				Segment &segment = sector.Segments[iSegment];
+				segment.X2 = x;
+				segment.Y.push_back(y);
+			}
+			else
+			{
+				iSegment = static_cast<int32_t>(sector.Segments.size());
+				sector.Segments.push_back({x, x, {y}});
+			}
+			nextOpen.push_back(iSegment);
+		}
+		std::swap(open, nextOpen);
+	}
+}
+
+void C4PathFinderGraph::BuildLinks(const int32_t iIndex)
+{
+	Sector &sector = Sectors[iIndex];
+	sector.LinkStart.clear();
+	sector.Links.clear();
+
+	// Collect neighbour sectors (including this one)
+	const int32_t sx = iIndex % SectorsX, sy = iIndex / SectorsX;
+	std::array<int32_t, 9> neighbours;
+	for (int32_t i = 0; i < 9; ++i)
+	{
+		const int32_t nx = sx + i % 3 - 1, ny = sy + i / 3 - 1;
+		if (Inside<int32_t>(nx, 0, SectorsX - 1) && Inside<int32_t>(ny, 0, SectorsY - 1))
+		{
+			neighbours[i] = ny * SectorsX + nx;
+			sector.LinkRevisions[i] = GetSector(neighbours[i]).Revision;
+		}
+		else
+		{
+			neighbours[i] = -1;
+			sector.LinkRevisions[i] = 0;
+		}
+	}
+
+	// Jump link checks must only read pixels of the neighbour sectors, whose revisions are tracked.
+	// Lines between points of these sectors stay inside of them, so only lifting needs to be limited.
+	const int32_t iMinY = std::max<int32_t>(sy - 1, 0) * SectorSize;
+
+	struct Candidate
+	{
+		int32_t Dist, ToSector, ToSegment;
+		Point To;
+	};
+	std::vector<Candidate> candidates;
+
+	for (int32_t iSegment = 0; iSegment < static_cast<int32_t>(sector.Segments.size()); ++iSegment)
+	{
+		sector.LinkStart.push_back(static_cast<int32_t>(sector.Links.size()));
+		const Segment &segment = sector.Segments[iSegment];
+
+		// Walk links to segments continuing in the next column
+		for (const auto neighbour : neighbours)
+		{
+			if (neighbour < 0) continue;
+			const Sector &other = Sectors[neighbour];
+			for (int32_t iOther = 0; iOther < static_cast<int32_t>(other.Segments.size()); ++iOther)
+			{
+				const Segment &target = other.Segments[iOther];
+				if (target.X1 == segment.X2 + 1 && Abs(target.Y.front() - segment.Y.back()) <= C4PF_Graph_MaxStep)
+					sector.Links.push_back({neighbour, iOther, segment.Right(), target.Left(), 1});
+				if (target.X2 == segment.X1 - 1 && Abs(target.Y.back() - segment.Y.front()) <= C4PF_Graph_MaxStep)
+					sector.Links.push_back({neighbour, iOther, segment.Left(), target.Right(), 1});
+			}
+		}
+
+		// Jump links from both ends to nearby segment ends with free line of sight
+		const Point ends[2] = {segment.Left(), segment.Right()};
+		for (int32_t iEnd = 0; iEnd < (segment.X1 == segment.X2 ? 1 : 2); ++iEnd)
+		{
+			const Point from = ends[iEnd];
+			candidates.clear();
+			for (const auto neighbour : neighbours)
+			{
+				if (neighbour < 0) continue;
+				const Sector &other = Sectors[neighbour];
+				for (int32_t iOther = 0; iOther < static_cast<int32_t>(other.Segments.size()); ++iOther)
+				{
+					if (neighbour == iIndex && iOther == iSegment) continue;
+					const Segment &target = other.Segments[iOther];
+					for (const Point to : {target.Left(), target.Right()})
+					{
+						const int32_t dx = to.X - from.X, dy = to.Y - from.Y;
+						if (Abs(dx) > C4PF_Graph_MaxLinkDist || Abs(dy) > C4PF_Graph_MaxLinkDist) continue;
+						// Jump heights are not known here; climbing and jumping up is left to the ray tracer
+						if (dy < -C4PF_Graph_MaxStep) continue;
+						// Covered by walk links
+						if (Abs(dx) <= 1 && Abs(dy) <= C4PF_Graph_MaxStep) continue;
+						candidates.push_back({Distance(from.X, from.Y, to.X, to.Y), neighbour, iOther, to});
+						if (target.X1 == target.X2) break;
+					}
+				}
+			}
+			// Closest first; full ordering keeps the result independent of the sort implementation
+			std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b)
+			{
+				if (a.Dist != b.Dist) return a.Dist < b.Dist;
+				if (a.ToSector != b.ToSector) return a.ToSector < b.ToSector;
+				if (a.ToSegment != b.ToSegment) return a.ToSegment < b.ToSegment;
+				return a.To.X < b.To.X;
+			});
+			int32_t iFound = 0;
+			const Point lifted = Lift(from, iMinY);
+			for (const auto &candidate : candidates)
+			{
+				if (iFound >= C4PF_Graph_MaxEndLinks) break;
+				const Point to = Lift(candidate.To, iMinY);
+				if (!LineFree(lifted.X, lifted.Y, to.X, to.Y)) continue;
+				sector.Links.push_back({candidate.ToSector, candidate.ToSegment, from, candidate.To, candidate.Dist});
+				++iFound;
+			}
+		}
+	}
+	sector.LinkStart.push_back(static_cast<int32_t>(sector.Links.size()));
+	sector.LinksValid = true;
+}
+
+bool C4PathFinderGraph::LineFree(int32_t iX1, int32_t iY1, const int32_t iX2, const int32_t iY2)
+{
+	const int32_t dx = Abs(iX2 - iX1), dy = Abs(iY2 - iY1);
+	const int32_t xincr = (iX2 > iX1) ? +1 : -1, yincr = (iY2 > iY1) ? +1 : -1;
+	int32_t d = dx - dy;
+	for (;;)
+	{
+		if (!PointFree(iX1, iY1)) return false;
+		if (iX1 == iX2 && iY1 == iY2) return true;
+		const int32_t d2 = 2 * d;
+		if (d2 > -dy) { d -= dy; iX1 += xincr; }
+		if (d2 < dx) { d += dx; iY1 += yincr; }
+	}
+}
+
+C4PathFinderGraph::Point C4PathFinderGraph::Lift(Point pt, const int32_t iMinY)
+{
+	for (int32_t i = 0; i < C4PF_Graph_Clearance && pt.Y > iMinY && PointFree(pt.X, pt.Y - 1); ++i)
+		--pt.Y;
+	return pt;
+}
+
+bool C4PathFinderGraph::FindAnchor(const int32_t iX, int32_t iY, int32_t &rSector, int32_t &rSegment, Point &rAnchor)
+{
+	if (!PointFree(iX, iY)) return false;
+	// Drop down to the surface
+	const int32_t iMaxY = iY + C4PF_Graph_AnchorDepth;
+	while (PointFree(iX, iY + 1))
+		if (++iY >= iMaxY) return false;
+	// Find the segment containing the surface point
+	rSector = GetSectorIndex(iX, iY);
+	if (rSector < 0) return false;
+	const Sector &sector = GetSector(rSector);
+	for (int32_t i = 0; i < static_cast<int32_t>(sector.Segments.size()); ++i)
+	{
+		const Segment &segment = sector.Segments[i];
+		if (Inside(iX, segment.X1, segment.X2) && segment.GetY(iX) == iY)
+		{
+			rSegment = i;
+			rAnchor = {iX, iY};
+			return true;
+		}
+	}
+	return false;
+}
+
+bool C4PathFinderGraph::GetZonePoint(const Segment &segment, const C4TransferZone &zone, Point &rPoint)
+{
+	// Zone including its adjacent border (exit points lie just outside the zone)
+	const int32_t x1 = std::max<int32_t>(segment.X1, zone.X - 1), x2 = std::min<int32_t>(segment.X2, zone.X + zone.Wdt);
+	if (x1 > x2) return false;
+	// Closest column to the zone center whose surface lies within the zone
+	const int32_t iX = BoundBy<int32_t>(zone.X + zone.Wdt / 2, x1, x2);
+	for (int32_t iDist = 0; iX - iDist >= x1 || iX + iDist <= x2; ++iDist)
+		for (const int32_t x : {iX - iDist, iX + iDist})
+			if (Inside(x, x1, x2) && Inside<int32_t>(segment.GetY(x), zone.Y - 1, zone.Y + zone.Hgt))
+			{
+				rPoint = {x, segment.GetY(x)};
+				return true;
+			}
+	return false;
+}
+
+bool C4PathFinderGraph::Find(const int32_t iFromX, const int32_t iFromY, const int32_t iToX, const int32_t iToY, C4TransferZones *const pTransferZones, const int32_t iLevel, std::vector<Waypoint> &rWaypoints)
+{
+	rWaypoints.clear();
+	LastPath.clear();
+	if (!EnsureLayout()) return false;
+
+	// Start and target must be just above a walkable surface
+	int32_t iStartSector, iStartSegment, iTargetSector, iTargetSegment;
+	Point start, target;
+	if (!FindAnchor(iFromX, iFromY, iStartSector, iStartSegment, start)) return false;
+	if (!FindAnchor(iToX, iToY, iTargetSector, iTargetSegment, target)) return false;
+	// Same segment: leave obstacles on the surface itself to the ray tracer
+	if (iStartSector == iTargetSector && iStartSegment == iTargetSegment) return false;
+
+	struct Node
+	{
+		int32_t G;
+		uint64_t Parent;
+		Point Entry, From;
+		C4TransferZone *Zone;
+		bool Closed;
+	};
+
+	struct OpenEntry
+	{
+		int32_t F;
+		uint64_t Key;
+
+		// Total ordering, so ties are resolved the same way everywhere (sync)
+		bool operator>(const OpenEntry &other) const { return F != other.F ? F > other.F : Key > other.Key; }
+	};
+
+	const auto makeKey = [](const int32_t iSector, const int32_t iSegment) { return (static_cast<uint64_t>(iSector) << 32) | static_cast<uint32_t>(iSegment); };
+	const uint64_t startKey = makeKey(iStartSector, iStartSegment), targetKey = makeKey(iTargetSector, iTargetSegment);
+
+	// A* over the segments
+	std::unordered_map<uint64_t, Node> nodes;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<>> open;
+	nodes[startKey] = {0, startKey, start, start, nullptr, false};
+	open.push({Distance(start.X, start.Y, target.X, target.Y), startKey});
+	bool fFound = false;
+	for (int32_t iExpanded = 0; !open.empty();)
+	{
+		const uint64_t current = open.top().Key;
+		open.pop();
+		Node &node = nodes[current];
+		if (node.Closed) continue;
+		node.Closed = true;
+		if (current == targetKey) { fFound = true; break; }
+		if (++iExpanded > C4PF_Graph_MaxNodes * iLevel) break;
+
+		const int32_t iSector = static_cast<int32_t>(current >> 32), iSegment = static_cast<int32_t>(current & 0xffffffff);
+		const Sector &sector = GetLinkedSector(iSector);
+		const Segment &segment = sector.Segments[iSegment];
+
+		const auto relax = [&](const int32_t iToSector, const int32_t iToSegment, const Point from, const Point to, const int32_t iCost, C4TransferZone *const pZone)
+		{
+			const int32_t g = node.G + Abs(from.X - node.Entry.X) + Abs(from.Y - node.Entry.Y) + iCost;
+			const uint64_t key = makeKey(iToSector, iToSegment);
+			const auto [it, inserted] = nodes.try_emplace(key);
+			Node &next = it->second;
+			if (!inserted && (next.Closed || next.G <= g)) return;
+			next = {g, current, to, from, pZone, false};
+			open.push({g + Distance(to.X, to.Y, target.X, target.Y), key});
+		};
+
+		for (int32_t i = sector.LinkStart[iSegment]; i < sector.LinkStart[iSegment + 1]; ++i)
+		{
+			const Link &link = sector.Links[i];
+			relax(link.ToSector, link.ToSegment, link.From, link.To, link.Cost, nullptr);
+		}
+
+		// Transfer zones connect all segments touching them
+		if (pTransferZones)
+			for (C4TransferZone *pZone = pTransferZones->First; pZone; pZone = pZone->Next)
+			{
+				Point from;
+				if (!pZone->Object || !GetZonePoint(segment, *pZone, from)) continue;
+				const int32_t x1 = std::max<int32_t>(pZone->X - 1, 0) / SectorSize, x2 = std::min<int32_t>(pZone->X + pZone->Wdt, Width - 1) / SectorSize;
+				const int32_t y1 = std::max<int32_t>(pZone->Y - 1, 0) / SectorSize, y2 = std::min<int32_t>(pZone->Y + pZone->Hgt, Height - 1) / SectorSize;
+				for (int32_t sy = y1; sy <= y2; ++sy)
+					for (int32_t sx = x1; sx <= x2; ++sx)
+					{
+						const int32_t iOtherSector = sy * SectorsX + sx;
+						const Sector &other = GetSector(iOtherSector);
+						for (int32_t iOther = 0; iOther < static_cast<int32_t>(other.Segments.size()); ++iOther)
+						{
+							Point to;
+							if (iOtherSector == iSector && iOther == iSegment) continue;
+							if (GetZonePoint(other.Segments[iOther], *pZone, to))
+								relax(iOtherSector, iOther, from, to, Distance(from.X, from.Y, to.X, to.Y), pZone);
+						}
+					}
+			}
+	}
+	if (!fFound) return false;
+
+	// Collect path points from start to target
+	std::vector<Waypoint> path;
+	path.push_back({iToX, iToY, nullptr});
+	path.push_back({target.X, target.Y, nullptr});
+	for (uint64_t key = targetKey; key != startKey;)
+	{
+		const Node &node = nodes[key];
+		path.push_back({node.Entry.X, node.Entry.Y, node.Zone});
+		path.push_back({node.From.X, node.From.Y, nullptr});
+		key = node.Parent;
+	}
+	path.push_back({start.X, start.Y, nullptr});
+	path.push_back({iFromX, iFromY, nullptr});
+	std::reverse(path.begin(), path.end());
+	for (size_t i = 1; i + 1 < path.size(); ++i)
+	{
+		const Point lifted = Lift({path[i].X, path[i].Y});
+		path[i].X = lifted.X; path[i].Y = lifted.Y;
+	}
+
+	// Skip points that can be reached directly (transfers may not be skipped)
+	std::vector<Waypoint> pulled;
+	for (size_t i = 0; i + 1 < path.size();)
+	{
+		size_t j = std::min(path.size() - 1, i + C4PF_Graph_PullLookAhead);
+		for (size_t k = i + 1; k < j; ++k)
+			if (path[k].Zone) { j = k; break; }
+		while (j > i + 1 && !path[j].Zone && !LineFree(path[i].X, path[i].Y, path[j].X, path[j].Y))
+			--j;
+		pulled.push_back(path[j]);
+		i = j;
+	}
+	// The target itself is not a waypoint
+	pulled.pop_back();
+	if (pulled.empty()) return false;
+
+	// Waypoints are set from target to start (like C4PathFinderRay::SetCompletePath)
+	rWaypoints.assign(pulled.rbegin(), pulled.rend());
+	LastPath.push_back({iFromX, iFromY});
+	for (const auto &waypoint : pulled) LastPath.push_back({waypoint.X, waypoint.Y});
+	LastPath.push_back({iToX, iToY});
+	return true;
+}
+
+void C4PathFinderGraph::Draw(C4FacetEx &cgo)
+{
+	for (size_t i = 1; i < LastPath.size(); ++i)
+		lpDDraw->DrawLine(cgo.Surface,
+			cgo.X + LastPath[i - 1].X - cgo.TargetX, cgo.Y + LastPath[i - 1].Y - cgo.TargetY,
+			cgo.X + LastPath[i].X - cgo.TargetX, cgo.Y + LastPath[i].Y - cgo.TargetY,
+			CGreen);
+}
+
 // C4PathFinder
 
 C4PathFinder::C4PathFinder()
@@ -531,7 +1002,9 @@ void C4PathFinder::Default()
 	Success = false;
 	TransferZones = nullptr;
 	TransferZonesEnabled = true;
+	GraphEnabled = false;
 	Level = 1;
+	Graph.Default();
 }
 
 void C4PathFinder::Clear()
@@ -546,6 +1019,7 @@ void C4PathFinder::Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *p
 	// Set data
 	PointFree = fnPointFree;
 	TransferZones = pTransferZones;
+	Graph.Init(fnPointFree);
 }
 
 void C4PathFinder::EnableTransferZones(bool fEnabled)
@@ -553,6 +1027,11 @@ void C4PathFinder::EnableTransferZones(bool fEnabled)
 	TransferZonesEnabled = fEnabled;
 }
 
+void C4PathFinder::EnableGraph(bool fEnabled)
+{
+	GraphEnabled = fEnabled;
+}
+
 void C4PathFinder::SetLevel(int iLevel)
 {
 	Level = BoundBy(iLevel, 1, 10);
@@ -561,6 +1040,7 @@ void C4PathFinder::SetLevel(int iLevel)
 void C4PathFinder::Draw(C4FacetEx &cgo)
 {
 	if (TransferZones) TransferZones->Draw(cgo);
+	Graph.Draw(cgo);
 	for (C4PathFinderRay *pRay = FirstRay; pRay; pRay = pRay->Next) pRay->Draw(cgo);
 }
 
@@ -611,6 +1091,9 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 	// Start & target coordinates must be free
 	if (!PointFree(iFromX, iFromY) || !PointFree(iToX, iToY)) return false;
 
+	// Navigation graph
+	if (GraphEnabled && FindByGraph(iFromX, iFromY, iToX, iToY)) return true;
+
 	// Add the first two rays
 	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Left, nullptr)) return false;
 	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Right, nullptr)) return false;
@@ -622,6 +1105,17 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 	return Success;
 }
 
+bool C4PathFinder::FindByGraph(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY)
+{
+	std::vector<C4PathFinderGraph::Waypoint> waypoints;
+	if (!Graph.Find(iFromX, iFromY, iToX, iToY, TransferZonesEnabled ? TransferZones : nullptr, Level, waypoints))
+		return false;
+	for (const auto &waypoint : waypoints)
+		SetWaypoint(waypoint.X, waypoint.Y, waypoint.Zone ? reinterpret_cast<intptr_t>(waypoint.Zone->Object) : 0, WaypointParameter);
+	Success = true;
+	return true;
+}
+
 bool C4PathFinder::AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone)
 {
 	// Max depth
@@ -19,8 +19,14 @@
 #pragma once
 
 #include "C4ForwardDeclarations.h"
+#include <C4Rect.h>
 #include <C4TransferZone.h>
 
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 class C4PathFinderRay
 {
 	friend class C4PathFinder;
@@ -60,6 +66,105 @@ protected:
 	bool PathFree(int32_t &rX, int32_t &rY, int32_t iToX, int32_t iToY, C4TransferZone **ppZone = nullptr);
 };
 
+// Coarse navigation graph over the landscape: walkable surface segments per sector,
+// connected by walk and jump links and by transfer zones. Sectors are rebuilt lazily
+// when the landscape in or around them has changed, so the graph is always a function
+// of the current landscape only (required for sync).
+class C4PathFinderGraph
+{
+public:
+	struct Point
+	{
+		int32_t X, Y;
+	};
+
+	struct Waypoint
+	{
+		int32_t X, Y;
+		C4TransferZone *Zone;
+	};
+
+private:
+	struct Segment
+	{
+		int32_t X1, X2; // column range (inclusive)
+		std::vector<int32_t> Y; // surface height per column
+
+		int32_t GetY(int32_t iX) const { return Y[iX - X1]; }
+		Point Left() const { return {X1, Y.front()}; }
+		Point Right() const { return {X2, Y.back()}; }
+	};
+
+	struct Link
+	{
+		int32_t ToSector, ToSegment;
+		Point From, To;
+		int32_t Cost;
+	};
+
+	struct Sector
+	{
+		bool Dirty{true};
+		bool LinksValid{false};
+		uint32_t Revision{0};
+		std::array<uint32_t, 9> LinkRevisions{};
+		std::vector<Segment> Segments;
+		std::vector<int32_t> LinkStart; // index of first link per segment; one extra entry for the end
+		std::vector<Link> Links;
+	};
+
+public:
+	C4PathFinderGraph();
+
+private:
+	bool(*PointFree)(int32_t, int32_t);
+	int32_t Width, Height; // landscape size the sectors were laid out for
+	int32_t SectorsX, SectorsY;
+	std::vector<Sector> Sectors;
+	std::vector<Point> LastPath; // for debug drawing
+
+public:
+	void Default();
+	void Clear();
+	void Init(bool(*fnPointFree)(int32_t, int32_t));
+	void Draw(C4FacetEx &cgo);
+	void InvalidateAll();
+	void Invalidate(const C4Rect &rect);
+
+	inline void Invalidate(int32_t iX, int32_t iY) // landscape pixel changed (called from C4Landscape::_SetPix)
+	{
+		if (Sectors.empty()) return;
+		const auto index = GetSectorIndex(iX, iY);
+		if (index >= 0) Sectors[index].Dirty = true;
+		// surface detection in the sector above looks one pixel down
+		if (!(iY % SectorSize) && iY > 0)
+			if (const auto above = GetSectorIndex(iX, iY - 1); above >= 0) Sectors[above].Dirty = true;
+	}
+
+	// Finds a path; waypoints are returned from target to start, excluding both
+	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, C4TransferZones *pTransferZones, int32_t iLevel, std::vector<Waypoint> &rWaypoints);
+
+private:
+	static constexpr int32_t SectorSize = 32;
+
+	int32_t GetSectorIndex(int32_t iX, int32_t iY) const
+	{
+		if (iX < 0 || iY < 0 || iX >= Width || iY >= Height) return -1;
+		return (iY / SectorSize) * SectorsX + iX / SectorSize;
+	}
+
+	bool EnsureLayout();
+	Sector &GetSector(int32_t iIndex);
+	Sector &GetLinkedSector(int32_t iIndex);
+	void BuildSegments(int32_t iIndex);
+	void BuildLinks(int32_t iIndex);
+	bool IsSurface(int32_t iX, int32_t iY) { return PointFree(iX, iY) && !PointFree(iX, iY + 1); }
+	bool LineFree(int32_t iX1, int32_t iY1, int32_t iX2, int32_t iY2);
+	Point Lift(Point pt, int32_t iMinY = std::numeric_limits<int32_t>::min()); // never lifts above row iMinY
+	bool FindAnchor(int32_t iX, int32_t iY, int32_t &rSector, int32_t &rSegment, Point &rAnchor);
+	bool GetZonePoint(const Segment &segment, const C4TransferZone &zone, Point &rPoint);
+};
+
 class C4PathFinder
 {
 	friend class C4PathFinderRay;
@@ -78,7 +183,9 @@ protected:
 	bool Success;
 	C4TransferZones *TransferZones;
 	bool TransferZonesEnabled;
+	bool GraphEnabled;
 	int Level;
+	C4PathFinderGraph Graph;
 
 public:
 	void Draw(C4FacetEx &cgo);
@@ -87,11 +194,16 @@ public:
 	void Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones = nullptr);
 	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
 	void EnableTransferZones(bool fEnabled);
+	void EnableGraph(bool fEnabled);
 	void SetLevel(int iLevel);
+	void InvalidateLandscape() { Graph.InvalidateAll(); }
+	void InvalidateLandscape(const C4Rect &rect) { Graph.Invalidate(rect); }
+	void InvalidateLandscape(int32_t iX, int32_t iY) { Graph.Invalidate(iX, iY); }
 
 protected:
 	void Run();
 	bool AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone = nullptr);
 	bool SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY);
 	bool Execute();
+	bool FindByGraph(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY);
 };
@@ -213,6 +213,7 @@ void C4SGame::Default()
 	Mode = C4S_Cooperative;
 	CooperativeGoal = C4S_NoGoal;
 	EnableRemoveFlag = false;
+	NavigationGraph = false;
 	Goals.Clear();
 	Rules.Clear();
 	FoWColor = 0;
@@ -228,6 +229,7 @@ void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
 	pComp->Value(mkNamingAdapt(ClearMaterial,                     "ClearMaterials",     C4NameList()));
 	pComp->Value(mkNamingAdapt(ValueGain,                         "ValueGain",          0));
 	pComp->Value(mkNamingAdapt(EnableRemoveFlag,                  "EnableRemoveFlag",   false));
+	pComp->Value(mkNamingAdapt(NavigationGraph,                   "NavigationGraph",    false));
 	pComp->Value(mkNamingAdapt(Realism.ConstructionNeedsMaterial, "StructNeedMaterial", false));
 	pComp->Value(mkNamingAdapt(Realism.StructuresNeedEnergy,      "StructNeedEnergy",   true));
 	if (!fSection)
@@ -141,6 +141,7 @@ public:
 	int32_t Mode;
 	int32_t Elimination;
 	bool EnableRemoveFlag;
+	bool NavigationGraph; // find walking paths in a graph of landscape surfaces before tracing rays
 
 	// Player winning
 	int32_t ValueGain; // If nonzero and value gain is equal or higher
@@ -38,6 +38,7 @@
 #include <C4ValueHash.h>
 #include <C4NetworkRestartInfos.h>
 #include <C4SoundSystem.h>
+#include <C4DefExecProfiler.h>
 
 #include <array>
 #include <cinttypes>
@@ -1112,6 +1113,7 @@ static bool FnSetActionTargets(C4AulContext *cthr, C4Object *pTarget1, C4Object
 	// set targets
 	pObj->Action.Target = pTarget1;
 	pObj->Action.Target2 = pTarget2;
+	Game.Objects.UpdateActionTargets(pObj);
 	return true;
 }
 
@@ -5046,7 +5048,8 @@ static C4ValueHash *FnGetPath(C4AulContext *ctx, C4ValueInt iFromX, C4ValueInt i
 	auto *hash = new C4ValueHash;
 	(*hash)[C4VString("Length")] = C4VInt(pathinfo.length);
 
-	auto *array = new C4ValueArray(static_cast<int32_t>(pathinfo.path.size()));
+	auto *array = new C4ValueArray();
+	array->Reserve(static_cast<int32_t>(pathinfo.path.size()));
 
 	if (!pathinfo.path.empty())
 	{
@@ -5058,7 +5061,7 @@ static C4ValueHash *FnGetPath(C4AulContext *ctx, C4ValueInt iFromX, C4ValueInt i
 			if (pathinfo.path[i].obj)
 				(*waypoint)[C4VString("TransferTarget")] = C4VObj(pathinfo.path[i].obj);
 
-			(*array)[static_cast<int32_t>(i)] = C4VMap(waypoint);
+			array->Append(C4VMap(waypoint));
 		}
 	}
 
@@ -5986,6 +5989,29 @@ static void FnStopScriptProfiler(C4AulContext *ctx)
 	C4AulProfiler::StopProfiling();
 }
 
+static void FnStartDefProfiler(C4AulContext *ctx)
+{
+	DefExecProfiler.Start();
+}
+
+static void FnStopDefProfiler(C4AulContext *ctx, std::optional<C4ValueInt> iTopCount)
+{
+	DefExecProfiler.Stop();
+	DefExecProfiler.LogTop(iTopCount ? std::max<C4ValueInt>(*iTopCount, 0) : C4DefExecProfiler::DefaultTopCount);
+}
+
+static std::optional<C4ValueInt> FnGetDefProfilerTime(C4AulContext *ctx, C4ID idDef, std::optional<C4ValueInt> iPhase)
+{
+	// times differ between clients
+	if (Game.Control.SyncMode()) return {};
+	C4Def *pDef = C4Id2Def(idDef);
+	if (!pDef) return {};
+	// microseconds of the given phase or of all phases
+	if (!iPhase) return {static_cast<C4ValueInt>(pDef->ExecStats.GetTotal() / 1000)};
+	if (!Inside<C4ValueInt>(*iPhase, 0, C4DefExecProfiler::PHASE_Count - 1)) return {};
+	return {static_cast<C4ValueInt>(pDef->ExecStats.Time[*iPhase] / 1000)};
+}
+
 static bool FnCustomMessage(C4AulContext *ctx, C4String *pMsg, C4Object *pObj, C4ValueInt iOwner, C4ValueInt iOffX, C4ValueInt iOffY, std::optional<C4ValueInt> clr, C4ID idDeco, C4String *sPortrait, C4ValueInt dwFlags, C4ValueInt iHSize)
 {
 	// safeties
@@ -6079,13 +6105,12 @@ static C4ValueArray *FnGetKeys(C4AulContext *ctx, C4ValueHash *map)
 {
 	if (!map) throw C4AulExecError(ctx->Obj, "GetKeys(): map expected, got 0");
 
-	C4ValueArray *keys = new C4ValueArray(map->size());
+	C4ValueArray *keys = new C4ValueArray();
+	keys->Reserve(static_cast<std::int32_t>(map->size()));
 
-	size_t i = 0;
 	for (const auto &[key, value] : *map)
 	{
-		(*keys)[i] = key;
-		++i;
+		keys->Append(key);
 	}
 
 	return keys;
@@ -6095,13 +6120,12 @@ static C4ValueArray *FnGetValues(C4AulContext *ctx, C4ValueHash *map)
 {
 	if (!map) throw C4AulExecError(ctx->Obj, "GetValues(): map expected, got 0");
 
-	C4ValueArray *keys = new C4ValueArray(map->size());
+	C4ValueArray *keys = new C4ValueArray();
+	keys->Reserve(static_cast<std::int32_t>(map->size()));
 
-	size_t i = 0;
 	for (const auto &[key, value] : *map)
 	{
-		(*keys)[i] = value;
-		++i;
+		keys->Append(value);
 	}
 
 	return keys;
@@ -6544,6 +6568,15 @@ static constexpr C4ScriptConstDef C4ScriptConstMap[] =
 	{ "C4PVM_Cursor",    C4V_Int, C4PVM_Cursor },
 	{ "C4PVM_Target",    C4V_Int, C4PVM_Target },
 	{ "C4PVM_Scrolling", C4V_Int, C4PVM_Scrolling },
+
+	{ "DEFPROF_OCF",       C4V_Int, C4DefExecProfiler::PHASE_OCF },
+	{ "DEFPROF_Command",   C4V_Int, C4DefExecProfiler::PHASE_Command },
+	{ "DEFPROF_Action",    C4V_Int, C4DefExecProfiler::PHASE_Action },
+	{ "DEFPROF_Movement",  C4V_Int, C4DefExecProfiler::PHASE_Movement },
+	{ "DEFPROF_Particles", C4V_Int, C4DefExecProfiler::PHASE_Particles },
+	{ "DEFPROF_Effects",   C4V_Int, C4DefExecProfiler::PHASE_Effects },
+	{ "DEFPROF_Timer",     C4V_Int, C4DefExecProfiler::PHASE_Timer },
+	{ "DEFPROF_Other",     C4V_Int, C4DefExecProfiler::PHASE_Other },
 };
 
 template <> struct C4ValueConv<C4Value>
@@ -7023,6 +7056,9 @@ void InitFunctionMap(C4AulScriptEngine *pEngine)
 	AddFunc(pEngine, "StartCallTrace",                  FnStartCallTrace);
 	AddFunc(pEngine, "StartScriptProfiler",             FnStartScriptProfiler);
 	AddFunc(pEngine, "StopScriptProfiler",              FnStopScriptProfiler);
+	AddFunc(pEngine, "StartDefProfiler",                FnStartDefProfiler);
+	AddFunc(pEngine, "StopDefProfiler",                 FnStopDefProfiler);
+	AddFunc(pEngine, "GetDefProfilerTime",              FnGetDefProfilerTime,              false);
 	AddFunc(pEngine, "CustomMessage",                   FnCustomMessage);
 	AddFunc(pEngine, "PauseGame",                       FnPauseGame);
 	AddFunc(pEngine, "ExecuteCommand",                  FnExecuteCommand);
@@ -57,6 +57,8 @@ bool C4ScriptHost::Load(const char *szName, C4Group &hGroup, const char *szFilen
 		pStringTable->LoadEx("StringTbl", hGroup, C4CFN_ScriptStringTbl, szLanguage);
 	// set name
 	ScriptName = std::format("{}" DirSep "{}", hGroup.GetFullName().getData(), Filename);
+	// sources may have changed: drop byte code cached for the previous ones
+	if (Engine) Engine->BytecodeCache.Invalidate(*this);
 	// preparse script
 	MakeScript();
 	// Success
@@ -0,0 +1,312 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Offscreen cache for static objects that do not change between frames */
+
+#include <C4Include.h>
+#include <C4StaticLayer.h>
+
+#include <C4Application.h>
+#include <C4Config.h>
+#include <C4Game.h>
+#include <C4Object.h>
+#include <C4ObjectList.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+C4StaticLayer::~C4StaticLayer()
+{
+	Clear();
+}
+
+void C4StaticLayer::Clear()
+{
+	Sectors.clear();
+	Objects.clear();
+	Segment.clear();
+}
+
+void C4StaticLayer::ClearPointers(C4Object *const pObj)
+{
+	if (!Objects.erase(pObj)) return;
+	// sectors showing the object have to be rendered again
+	for (auto &[key, sector] : Sectors)
+		if (std::any_of(sector.Contents.begin(), sector.Contents.end(), [pObj](const auto &content) { return content.first == pObj; }))
+			sector.Contents.clear();
+}
+
+bool C4StaticLayer::IsAvailable()
+{
+	if (!Config.Graphics.StaticLayer || fUnavailable) return false;
+	// editor viewports use several contexts, which do not share framebuffers
+	if (!Application.isFullScreen) return false;
+	if (!lpDDraw || !lpDDraw->CanRenderOffscreen()) return false;
+	// debug displays depend on more than the draw state
+	const C4GraphicsSystem &GraphicsSystem{Game.GraphicsSystem};
+	if (GraphicsSystem.ShowCommand || GraphicsSystem.ShowVertices || GraphicsSystem.ShowEntrance || GraphicsSystem.ShowAction || GraphicsSystem.ShowSolidMask) return false;
+	// fog of war with transparency would be applied to premultiplied colors
+	if (Game.FoWColor >> 24) return false;
+	return true;
+}
+
+bool C4StaticLayer::IsCacheable(C4Object *const pObj)
+{
+	// output must not depend on the frame counter or anything else outside DrawState and the viewing player
+	return pObj->Status && pObj->Def && !pObj->Def->Line
+		&& !pObj->Visibility && !pObj->pLayer
+		&& !(pObj->Category & (C4D_Parallax | C4D_IgnoreFoW))
+		&& !pObj->GetOnFire() && !pObj->NeedEnergy
+		&& !(pObj->BlitMode & C4GFXBLIT_ADDITIVE);
+}
+
+bool C4StaticLayer::GetDrawBounds(C4Object *const pObj, C4Rect &rBounds)
+{
+	rBounds.Default();
+	// not drawn at all?
+	if (!pObj->Status || !pObj->Def || pObj->Contained) return true;
+	// overlays, particles, transformations, select marks and stretched actions may draw anywhere
+	if (pObj->pGfxOverlay || pObj->BackParticles || pObj->FrontParticles || pObj->pDrawTransform || pObj->Select) return false;
+	const C4Action &Action{pObj->Action};
+	if (Action.Act > ActIdle && pObj->Def->ActMap[Action.Act].FacetTargetStretch) return false;
+	const C4Shape &Shape{pObj->Shape};
+	// shape and definition face centered in it, relative to the object position
+	C4Rect rc{Shape.x, Shape.y, Shape.Wdt, Shape.Hgt};
+	const int32_t iCon{std::max<int32_t>(pObj->GetCon(), FullCon)};
+	const int32_t iFaceWdt{pObj->Def->Shape.Wdt * iCon / FullCon}, iFaceHgt{pObj->Def->Shape.Hgt * iCon / FullCon};
+	rc.Add(C4Rect{Shape.x + (Shape.Wdt - iFaceWdt) / 2, Shape.y + (Shape.Hgt - iFaceHgt) / 2, iFaceWdt, iFaceHgt});
+	// action facet
+	if (Action.Act > ActIdle && Action.Facet.Surface)
+	{
+		rc.Add(C4Rect{Shape.x + Action.FacetX, Shape.y + Action.FacetY, Action.Facet.Wdt, Action.Facet.Hgt});
+		rc.Add(C4Rect{(pObj->Def->Shape.x + Action.FacetX) * iCon / FullCon, (pObj->Def->Shape.y + Action.FacetY) * iCon / FullCon,
+			Action.Facet.Wdt * iCon / FullCon, Action.Facet.Hgt * iCon / FullCon});
+	}
+	// rotated fire covers the vertex outline
+	if (pObj->GetOnFire() && pObj->r)
+	{
+		C4Rect rcFire;
+		pObj->Shape.GetVertexOutline(rcFire);
+		rc.Add(rcFire);
+	}
+	// rotated: anything within reach of the shape center
+	if (pObj->r)
+	{
+		const int32_t iCX{Shape.x + Shape.Wdt / 2}, iCY{Shape.y + Shape.Hgt / 2};
+		const int32_t iDX{std::max(std::abs(rc.x - iCX), std::abs(rc.x + rc.Wdt - iCX))};
+		const int32_t iDY{std::max(std::abs(rc.y - iCY), std::abs(rc.y + rc.Hgt - iCY))};
+		const auto iRadius = static_cast<int32_t>(std::ceil(std::sqrt(static_cast<float>(iDX * iDX + iDY * iDY))));
+		rc.Set(iCX - iRadius, iCY - iRadius, 2 * iRadius, 2 * iRadius);
+	}
+	// energy shortage symbol above the shape
+	if (pObj->NeedEnergy)
+	{
+		const C4Facet &fctEnergy{Game.GraphicsResource.fctEnergy};
+		rc.Add(C4Rect{Shape.x + Shape.Wdt / 2 - fctEnergy.Wdt / 2, Shape.y - fctEnergy.Hgt - 5, fctEnergy.Wdt, fctEnergy.Hgt});
+	}
+	// filtering may touch neighbouring pixels
+	rc.Enlarge(2);
+	rc.x += pObj->x; rc.y += pObj->y;
+	rBounds = rc;
+	return true;
+}
+
+void C4StaticLayer::GetDrawState(C4Object *const pObj, DrawState &rState)
+{
+	const C4Action &Action{pObj->Action};
+	rState.pDef = pObj->Def;
+	rState.pGraphics = pObj->GetGraphics();
+	rState.iX = pObj->x; rState.iY = pObj->y;
+	rState.iR = pObj->r; rState.iCon = pObj->GetCon();
+	rState.iShapeX = pObj->Shape.x; rState.iShapeY = pObj->Shape.y;
+	rState.iShapeWdt = pObj->Shape.Wdt; rState.iShapeHgt = pObj->Shape.Hgt;
+	rState.dwCategory = pObj->Category;
+	rState.dwColor = pObj->Color;
+	rState.dwColorMod = pObj->ColorMod;
+	rState.dwBlitMode = pObj->BlitMode;
+	rState.iAction = Action.Act;
+	rState.iPhase = Action.Phase;
+	rState.iDrawDir = Action.DrawDir;
+	rState.sfcAction = Action.Facet.Surface;
+	rState.iActionX = Action.Facet.X; rState.iActionY = Action.Facet.Y;
+	rState.iActionWdt = Action.Facet.Wdt; rState.iActionHgt = Action.Facet.Hgt;
+	rState.iFacetX = Action.FacetX; rState.iFacetY = Action.FacetY;
+	rState.fContained = !!pObj->Contained;
+}
+
+int32_t C4StaticLayer::SectorIndex(const int32_t iCoord)
+{
+	// round towards negative infinity
+	return (iCoord >= 0 ? iCoord : iCoord - SectorSize + 1) / SectorSize;
+}
+
+C4StaticLayer::Entry C4StaticLayer::Track(C4Object *const pObj)
+{
+	Entry entry{pObj, nullptr, {}, false, false};
+	entry.fBounded = GetDrawBounds(pObj, entry.Bounds);
+	TrackedObject &tracked{Objects[pObj]};
+	if (IsCacheable(pObj))
+	{
+		DrawState state;
+		GetDrawState(pObj, state);
+		if (!(state == tracked.State))
+		{
+			tracked.State = state;
+			tracked.UnchangedSince = Game.FrameCounter;
+		}
+		entry.fSettled = entry.fBounded && Game.FrameCounter - tracked.UnchangedSince >= SettleFrames;
+	}
+	else
+	{
+		tracked.State = {};
+		tracked.UnchangedSince = Game.FrameCounter;
+	}
+	entry.pState = &tracked.State;
+	return entry;
+}
+
+C4StaticLayer::Sector *C4StaticLayer::GetSector(const int32_t iSX, const int32_t iSY, const int32_t iPlayer)
+{
+	const SectorKey key{iSX, iSY, iPlayer};
+	if (const auto it = Sectors.find(key); it != Sectors.end())
+	{
+		it->second.LastUsed = Game.FrameCounter;
+		return &it->second;
+	}
+	// make room by dropping the least recently used sector not needed for this frame
+	if (Sectors.size() >= MaxSectors)
+	{
+		const auto it = std::min_element(Sectors.begin(), Sectors.end(), [](const auto &a, const auto &b) { return a.second.LastUsed < b.second.LastUsed; });
+		if (it->second.LastUsed == Game.FrameCounter) return nullptr;
+		Sectors.erase(it);
+	}
+	auto sfcLayer = std::make_unique<C4Surface>();
+	if (!sfcLayer->Create(SectorSize, SectorSize, false, true) || !sfcLayer->IsRenderTarget())
+	{
+		// no framebuffer support after all
+		fUnavailable = true;
+		return nullptr;
+	}
+	Sector &sector{Sectors[key]};
+	sector.Surface = std::move(sfcLayer);
+	sector.LastUsed = Game.FrameCounter;
+	return &sector;
+}
+
+bool C4StaticLayer::RenderSector(Sector &rSector, const int32_t iSX, const int32_t iSY, const int32_t iPlayer, const std::vector<size_t> &rEntries)
+{
+	// still showing the same objects in the same state?
+	if (std::equal(rEntries.begin(), rEntries.end(), rSector.Contents.begin(), rSector.Contents.end(),
+		[this](const size_t e, const auto &content) { return content.first == Segment[e].pObj && content.second == *Segment[e].pState; }))
+		return true;
+	rSector.Contents.clear();
+	if (!lpDDraw->ClearRenderTarget(rSector.Surface.get())) return false;
+	// fog of war is applied when compositing
+	C4FacetEx cgoSector;
+	cgoSector.Set(rSector.Surface.get(), 0, 0, SectorSize, SectorSize, iSX * SectorSize, iSY * SectorSize);
+	int iClipX1, iClipY1, iClipX2, iClipY2;
+	lpDDraw->GetPrimaryClipper(iClipX1, iClipY1, iClipX2, iClipY2);
+	lpDDraw->SetPrimaryClipper(0, 0, SectorSize - 1, SectorSize - 1);
+	const bool fClrModMap{lpDDraw->GetClrModMapEnabled()};
+	lpDDraw->SetClrModMapEnabled(false);
+	for (const size_t e : rEntries)
+	{
+		Segment[e].pObj->Draw(cgoSector, iPlayer);
+		rSector.Contents.emplace_back(Segment[e].pObj, *Segment[e].pState);
+	}
+	lpDDraw->SetClrModMapEnabled(fClrModMap);
+	lpDDraw->SetPrimaryClipper(iClipX1, iClipY1, iClipX2, iClipY2);
+	return true;
+}
+
+C4ObjectLink *C4StaticLayer::Draw(C4FacetEx &cgo, const int32_t iPlayer, C4ObjectLink *pLink)
+{
+	if (!IsAvailable())
+	{
+		// free layer surfaces when switched off
+		if (!Sectors.empty()) Clear();
+		return pLink;
+	}
+	// collect the static objects at the back of the list, which are drawn first
+	// lines are drawn between vertices anywhere in the landscape and are never cached, so they end the segment
+	Segment.clear();
+	for (; pLink && (pLink->Obj->Category & C4D_SortLimit) == C4D_StaticBack && !(pLink->Obj->Def && pLink->Obj->Def->Line); pLink = pLink->Prev)
+		if (!(pLink->Obj->Category & C4D_BackgroundOrForeground))
+			Segment.push_back(Track(pLink->Obj));
+	if (Segment.empty()) return pLink;
+	// sort objects into the visible sectors
+	const int32_t iSX1{SectorIndex(cgo.TargetX)}, iSY1{SectorIndex(cgo.TargetY)};
+	const int32_t iSWdt{SectorIndex(cgo.TargetX + cgo.Wdt - 1) - iSX1 + 1}, iSHgt{SectorIndex(cgo.TargetY + cgo.Hgt - 1) - iSY1 + 1};
+	SectorEntries.resize(iSWdt * iSHgt);
+	for (auto &entries : SectorEntries) entries.clear();
+	bool fCacheView{true};
+	for (size_t i = 0; i < Segment.size(); ++i)
+	{
+		const Entry &entry{Segment[i]};
+		// objects that may draw anywhere rule out caching for the whole view
+		if (!entry.fBounded) { fCacheView = false; break; }
+		if (entry.Bounds.Wdt <= 0 || entry.Bounds.Hgt <= 0) continue;
+		const int32_t iX1{std::max(SectorIndex(entry.Bounds.x) - iSX1, 0)}, iX2{std::min(SectorIndex(entry.Bounds.x + entry.Bounds.Wdt - 1) - iSX1, iSWdt - 1)};
+		const int32_t iY1{std::max(SectorIndex(entry.Bounds.y) - iSY1, 0)}, iY2{std::min(SectorIndex(entry.Bounds.y + entry.Bounds.Hgt - 1) - iSY1, iSHgt - 1)};
+		for (int32_t iY = iY1; iY <= iY2; ++iY)
+			for (int32_t iX = iX1; iX <= iX2; ++iX)
+				SectorEntries[iY * iSWdt + iX].push_back(i);
+	}
+	// render sectors whose objects have all settled
+	std::vector<std::pair<Sector *, int32_t>> cached;
+	DirectSectors.clear();
+	if (fCacheView)
+		for (int32_t i = 0; i < iSWdt * iSHgt; ++i)
+		{
+			const std::vector<size_t> &entries{SectorEntries[i]};
+			if (entries.empty()) continue;
+			const int32_t iSX{iSX1 + i % iSWdt}, iSY{iSY1 + i / iSWdt};
+			Sector *pSector{nullptr};
+			if (std::all_of(entries.begin(), entries.end(), [this](const size_t e) { return Segment[e].fSettled; }))
+				pSector = GetSector(iSX, iSY, iPlayer);
+			if (pSector && RenderSector(*pSector, iSX, iSY, iPlayer, entries))
+				cached.emplace_back(pSector, i);
+			else
+				DirectSectors.push_back(i);
+		}
+	// nothing cached in view: draw as usual
+	if (cached.empty())
+	{
+		for (const Entry &entry : Segment) entry.pObj->Draw(cgo, iPlayer);
+		return pLink;
+	}
+	// composite cached sectors
+	for (const auto &[pSector, i] : cached)
+	{
+		const int32_t iTX{cgo.X + (iSX1 + i % iSWdt) * SectorSize - cgo.TargetX}, iTY{cgo.Y + (iSY1 + i / iSWdt) * SectorSize - cgo.TargetY};
+		lpDDraw->Blit(pSector->Surface.get(), 0.0f, 0.0f, static_cast<float>(SectorSize), static_cast<float>(SectorSize),
+			cgo.Surface, iTX, iTY, SectorSize, SectorSize);
+	}
+	// draw the remaining sectors object by object
+	if (!DirectSectors.empty())
+	{
+		int iClipX1, iClipY1, iClipX2, iClipY2;
+		lpDDraw->GetPrimaryClipper(iClipX1, iClipY1, iClipX2, iClipY2);
+		for (const int32_t i : DirectSectors)
+		{
+			const int32_t iTX{cgo.X + (iSX1 + i % iSWdt) * SectorSize - cgo.TargetX}, iTY{cgo.Y + (iSY1 + i / iSWdt) * SectorSize - cgo.TargetY};
+			lpDDraw->SetPrimaryClipper(std::max(iClipX1, iTX), std::max(iClipY1, iTY), std::min(iClipX2, iTX + SectorSize - 1), std::min(iClipY2, iTY + SectorSize - 1));
+			for (const size_t e : SectorEntries[i]) Segment[e].pObj->Draw(cgo, iPlayer);
+		}
+		lpDDraw->SetPrimaryClipper(iClipX1, iClipY1, iClipX2, iClipY2);
+	}
+	return pLink;
+}
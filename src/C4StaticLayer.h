@@ -0,0 +1,117 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Offscreen cache for static objects that do not change between frames */
+
+#pragma once
+
+#include "C4ForwardDeclarations.h"
+#include "C4Rect.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+class C4DefGraphics;
+class C4ObjectLink;
+
+// Static background objects (C4D_StaticBack) are drawn first and rarely change.
+// Once an object's draw state has stayed the same for a while, the sectors it touches
+// are rendered into offscreen surfaces for each viewing player and composited instead of drawing every object again.
+// Sectors containing objects that changed recently are drawn object by object, clipped to the sector.
+class C4StaticLayer
+{
+public:
+	static constexpr int32_t SectorSize = 256; // size of cached layer surfaces
+	static constexpr int32_t SettleFrames = 35; // number of frames an object must stay unchanged before it is cached
+	static constexpr size_t MaxSectors = 128; // maximum number of cached layer surfaces
+
+private:
+	// everything the output of C4Object::Draw depends on for cacheable objects
+	struct DrawState
+	{
+		C4Def *pDef;
+		C4DefGraphics *pGraphics;
+		int32_t iX, iY, iR, iCon;
+		int32_t iShapeX, iShapeY, iShapeWdt, iShapeHgt;
+		uint32_t dwCategory, dwColor, dwColorMod, dwBlitMode;
+		int32_t iAction, iPhase, iDrawDir;
+		C4Surface *sfcAction;
+		int32_t iActionX, iActionY, iActionWdt, iActionHgt, iFacetX, iFacetY;
+		bool fContained;
+
+		bool operator==(const DrawState &) const = default;
+	};
+
+	struct TrackedObject
+	{
+		DrawState State;
+		int32_t UnchangedSince; // frame at which State was last changed
+	};
+
+	// a static object about to be drawn
+	struct Entry
+	{
+		C4Object *pObj;
+		const DrawState *pState;
+		C4Rect Bounds; // landscape area the object draws to
+		bool fBounded; // false if the object may draw anywhere
+		bool fSettled; // unchanged long enough to be cached
+	};
+
+	struct Sector
+	{
+		std::unique_ptr<C4Surface> Surface;
+		std::vector<std::pair<C4Object *, DrawState>> Contents; // objects shown by Surface in drawing order
+		int32_t LastUsed{0}; // frame
+	};
+
+	using SectorKey = std::tuple<int32_t, int32_t, int32_t>; // sector x, sector y, viewing player
+
+	std::unordered_map<C4Object *, TrackedObject> Objects;
+	std::map<SectorKey, Sector> Sectors;
+	bool fUnavailable{false}; // set if layer surfaces cannot be rendered to
+
+	// reused per draw
+	std::vector<Entry> Segment;
+	std::vector<std::vector<size_t>> SectorEntries;
+	std::vector<int32_t> DirectSectors;
+
+public:
+	C4StaticLayer() = default;
+	C4StaticLayer(const C4StaticLayer &) = delete;
+	C4StaticLayer &operator=(const C4StaticLayer &) = delete;
+	~C4StaticLayer();
+
+	void Clear();
+	void ClearPointers(C4Object *pObj);
+
+	// draw the static objects at the back of the list starting at pLink and return the first link left to be drawn
+	C4ObjectLink *Draw(C4FacetEx &cgo, int32_t iPlayer, C4ObjectLink *pLink);
+
+private:
+	bool IsAvailable();
+	Entry Track(C4Object *pObj);
+	Sector *GetSector(int32_t iSX, int32_t iSY, int32_t iPlayer);
+	bool RenderSector(Sector &rSector, int32_t iSX, int32_t iSY, int32_t iPlayer, const std::vector<size_t> &rEntries);
+
+	static bool IsCacheable(C4Object *pObj);
+	static bool GetDrawBounds(C4Object *pObj, C4Rect &rBounds);
+	static void GetDrawState(C4Object *pObj, DrawState &rState);
+	static int32_t SectorIndex(int32_t iCoord);
+};
@@ -17,10 +17,13 @@
 /* a wrapper class to DirectDraw surfaces */
 
 #include <C4Config.h>
+#include <C4DecodedImageCache.h>
 #include <C4Group.h>
 #include <C4GroupSet.h>
 #include <C4Log.h>
 #include <C4Surface.h>
+#include <C4ThreadPool.h>
+#include <C4Trace.h>
 
 #include <Bitmap256.h>
 #include "StdApp.h"
@@ -33,8 +36,112 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <latch>
 #include <memory>
 #include <stdexcept>
+#include <string>
+
+struct C4SurfaceDecodeJob
+{
+	std::unique_ptr<uint8_t[]> Data; // file contents
+	std::size_t Size;
+	std::unique_ptr<CPNGFile> Png; // header already read
+	std::unique_ptr<StdJpeg> Jpeg;
+	const char *Format; // for error messages
+	std::uint32_t Width, Height;
+	bool UseAlpha;
+	bool KeepOnError{false}; // a broken image leaves an empty surface instead of failing the load
+	std::string CacheDirectory; // empty if decoded images are not cached
+
+	std::unique_ptr<StdBitmap> Bitmap; // decoding result
+	std::string Error;
+	std::latch Done{1};
+
+	C4Surface *Surface{nullptr}; // only accessed on the main thread
+
+	void Decode()
+	{
+		C4TRACE_ZONE("C4Surface::Decode");
+		// any exception must end here, because Done is counted down after this
+		try
+		{
+			DecodeBitmap();
+		}
+		catch (const std::exception &e)
+		{
+			Error = e.what();
+			Bitmap.reset();
+		}
+		catch (...)
+		{
+			Error = "Unknown error";
+			Bitmap.reset();
+		}
+		// the decoders point into the file contents
+		Png.reset(); Jpeg.reset(); Data.reset();
+	}
+
+private:
+	void DecodeBitmap()
+	{
+		C4DecodedImageCache::Key key;
+		if (!CacheDirectory.empty())
+		{
+			key = C4DecodedImageCache::GetKey(Data.get(), Size);
+			Bitmap = DecodedImageCache.Load(CacheDirectory, key, Width, Height, UseAlpha);
+			if (Bitmap) return;
+		}
+		if (Png)
+		{
+			Bitmap = std::make_unique<StdBitmap>(Width, Height, UseAlpha);
+			Png->Decode(Bitmap->GetBytes());
+			// if color is fully transparent, ensure it's black
+			if (UseAlpha)
+			{
+				auto *const pixels = static_cast<std::uint32_t *>(Bitmap->GetBytes());
+				const std::size_t count{static_cast<std::size_t>(Width) * Height};
+				for (std::size_t i = 0; i < count; ++i)
+					pixels[i] = (pixels[i] >> 24) == 0xff ? 0xff000000 : pixels[i];
+			}
+		}
+		else
+		{
+			Bitmap = std::make_unique<StdBitmap>(Width, Height, UseAlpha);
+			for (std::uint32_t y = 0; y < Height; ++y)
+			{
+				const auto row = static_cast<const uint8_t *>(Jpeg->DecodeRow());
+				for (std::uint32_t x = 0; x < Width; ++x)
+					Bitmap->SetPixel(x, y, C4RGB(row[x * 3], row[x * 3 + 1], row[x * 3 + 2]));
+			}
+			Jpeg->Finish();
+		}
+		if (!CacheDirectory.empty())
+			C4DecodedImageCache::Store(CacheDirectory, key, *Bitmap, Width, Height, UseAlpha);
+	}
+};
+
+C4SurfaceDecodeBatch::C4SurfaceDecodeBatch() : pPrevious{Current}
+{
+	Current = this;
+}
+
+C4SurfaceDecodeBatch::~C4SurfaceDecodeBatch()
+{
+	Finish();
+	Current = pPrevious;
+}
+
+void C4SurfaceDecodeBatch::Finish()
+{
+	C4TRACE_ZONE("C4SurfaceDecodeBatch::Finish");
+	for (const auto &job : Jobs)
+	{
+		if (job->Surface) job->Surface->FinishDecode();
+		// surfaces cleared in the meantime have dropped their job, but it must not outlive the batch
+		else job->Done.wait();
+	}
+	Jobs.clear();
+}
 
 C4Surface::C4Surface() : fIsBackground(false)
 {
@@ -85,6 +192,10 @@ C4Surface &C4Surface::operator=(C4Surface &&other)
 	swap(Format, other.Format);
 #endif
 	swap(fIsBackground, other.fIsBackground);
+	swap(PendingDecode, other.PendingDecode);
+	swap(fDecodeFailed, other.fDecodeFailed);
+	if (PendingDecode) PendingDecode->Surface = this;
+	if (other.PendingDecode) other.PendingDecode->Surface = &other;
 
 	return *this;
 }
@@ -96,6 +207,7 @@ void C4Surface::Default()
 	ClipX = ClipY = ClipX2 = ClipY2 = 0;
 	Locked = 0;
 	fPrimary = false;
+	fDecodeFailed = false;
 	ppTex = nullptr;
 	pMainSfc = nullptr;
 	ClrByOwnerClr = 0;
@@ -109,8 +221,20 @@ void C4Surface::Default()
 
 void C4Surface::Clear()
 {
+	// drop pending decode; the job finishes on its own
+	if (PendingDecode)
+	{
+		PendingDecode->Surface = nullptr;
+		PendingDecode.reset();
+	}
 	// Undo all locks
 	while (Locked) Unlock();
+	// stop rendering to this surface
+	if (lpDDraw && lpDDraw->RenderTarget == this)
+	{
+		lpDDraw->FlushDrawList();
+		lpDDraw->RenderTarget = nullptr;
+	}
 	// release surface
 	FreeTextures();
 	ppTex = nullptr;
@@ -123,7 +247,9 @@ void C4Surface::Clear()
 bool C4Surface::IsRenderTarget()
 {
 	// primary is always OK...
-	return fPrimary;
+	if (fPrimary) return true;
+	// offscreen surfaces need a framebuffer
+	return fIsRenderTarget && ppTex && (*ppTex)->IsRenderTarget();
 }
 
 void C4Surface::NoClip()
@@ -409,9 +535,28 @@ bool C4Surface::Read(C4Group &hGroup, bool fOwnPal)
 }
 
 bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale)
+{
+	const std::unique_ptr<StdBitmap> bmp{CopyToBitmap(fSaveAlpha, fApplyGamma, fSaveOverlayOnly, scale)};
+	if (!bmp) return false;
+
+	// Save bitmap to PNG file
+	try
+	{
+		CPNGFile(szFilename, bmp->GetWidth(), bmp->GetHeight(), bmp->UsesAlpha()).Encode(bmp->GetBytes());
+	}
+	catch (const std::runtime_error &)
+	{
+		return false;
+	}
+
+	// Success
+	return true;
+}
+
+std::unique_ptr<StdBitmap> C4Surface::CopyToBitmap(bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale)
 {
 	// Lock - WARNING - maybe locking primary surface here...
-	if (!Lock()) return false;
+	if (!Lock()) return nullptr;
 
 	if (lpDDraw->Gamma.GetSize() == 0)
 		fApplyGamma = false;
@@ -420,7 +565,7 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 	int realHgt = static_cast<int32_t>(ceilf(Hgt * scale));
 
 	// Create bitmap
-	StdBitmap bmp(realWdt, realHgt, fSaveAlpha);
+	auto bmp = std::make_unique<StdBitmap>(realWdt, realHgt, fSaveAlpha);
 
 	// reset overlay if desired
 	C4Surface *pMainSfcBackup;
@@ -429,9 +574,10 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 #ifndef USE_CONSOLE
 	if (fPrimary && pGL)
 	{
+		pGL->FlushDrawList();
 		// Take shortcut. FIXME: Check Endian
 		for (int y = 0; y < realHgt; ++y)
-			glReadPixels(0, realHgt - y, realWdt, 1, fSaveAlpha ? GL_BGRA : GL_BGR, GL_UNSIGNED_BYTE, bmp.GetPixelAddr(0, y));
+			glReadPixels(0, realHgt - y, realWdt, 1, fSaveAlpha ? GL_BGRA : GL_BGR, GL_UNSIGNED_BYTE, bmp->GetPixelAddr(0, y));
 	}
 	else
 #endif
@@ -442,7 +588,7 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 			{
 				uint32_t dwClr = GetPixDw(x, y, false, scale);
 				if (fApplyGamma) dwClr = lpDDraw->Gamma.ApplyTo(dwClr);
-				bmp.SetPixel(x, y, dwClr);
+				bmp->SetPixel(x, y, dwClr);
 			}
 	}
 
@@ -452,18 +598,7 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 	// Unlock
 	Unlock();
 
-	// Save bitmap to PNG file
-	try
-	{
-		CPNGFile(szFilename, realWdt, realHgt, fSaveAlpha).Encode(bmp.GetBytes());
-	}
-	catch (const std::runtime_error &)
-	{
-		return false;
-	}
-
-	// Success
-	return true;
+	return bmp;
 }
 
 bool C4Surface::Wipe()
@@ -492,6 +627,7 @@ bool C4Surface::GetSurfaceSize(int &irX, int &irY)
 
 bool C4Surface::Lock()
 {
+	WaitForDecode();
 	// lock main sfc
 	if (pMainSfc) if (!pMainSfc->Lock()) return false;
 	// not yet locked?
@@ -515,6 +651,7 @@ bool C4Surface::Lock()
 
 bool C4Surface::LockForUpdate(const C4Rect rect)
 {
+	WaitForDecode();
 	// texture present?
 	if (!ppTex) return false;
 
@@ -590,8 +727,18 @@ bool C4Surface::Unlock(bool noUpload)
 	return true;
 }
 
+bool C4Surface::SetStreamed(const bool fToVal)
+{
+	// texture present?
+	if (!ppTex) return false;
+	for (int i = 0; i < iTexX * iTexY; ++i)
+		if (!ppTex[i]->SetStreamed(fToVal)) return false;
+	return true;
+}
+
 bool C4Surface::GetTexAt(C4TexRef **ppTexRef, int &rX, int &rY)
 {
+	WaitForDecode();
 	// texture present?
 	if (!ppTex) return false;
 	// get pos
@@ -651,6 +798,7 @@ uint32_t C4Surface::GetPixDw(int iX, int iY, bool fApplyModulation, float scale)
 				int wdt = static_cast<int32_t>(ceilf(Wdt * scale));
 				wdt = ((wdt + 3) / 4) * 4; // round up to the next multiple of 4
 				PrimarySurfaceLockBits = new unsigned char[wdt * hgt * 3];
+				pGL->FlushDrawList();
 				glReadPixels(0, 0, wdt, hgt, GL_BGR, GL_UNSIGNED_BYTE, PrimarySurfaceLockBits);
 				PrimarySurfaceLockPitch = wdt * 3;
 			}
@@ -746,6 +894,7 @@ bool C4Surface::BltPix(int iX, int iY, C4Surface *sfcSource, int iSrcX, int iSrc
 	if (!GetLockTexAt(&pTexRef, iX, iY)) return false;
 
 	uint32_t *pPix = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(pTexRef->texLock.pBits) + iY * pTexRef->texLock.Pitch + iX * 4);
+	if (pTexRef->fStreamed) pTexRef->MarkChanged(iX, iY, iX + 1, iY + 1);
 	// get source pix as dword
 	uint32_t srcPix = sfcSource->GetPixDw(iSrcX, iSrcY, true);
 	// merge
@@ -914,32 +1063,72 @@ bool C4Surface::Load(C4Group &hGroup, const char *szFilename, bool fOwnPal, bool
 
 bool C4Surface::ReadPNG(C4Group &hGroup)
 {
-	// create mem block
-	int iSize = hGroup.AccessedEntrySize();
-	std::unique_ptr<uint8_t[]> pData(new uint8_t[iSize]);
+	auto job = std::make_shared<C4SurfaceDecodeJob>();
 	// load file into mem
-	hGroup.Read(pData.get(), iSize);
-	// load as png file
-	std::unique_ptr<StdBitmap> bmp;
-	std::uint32_t width, height; bool useAlpha;
+	job->Size = hGroup.AccessedEntrySize();
+	job->Data = std::make_unique_for_overwrite<uint8_t[]>(job->Size);
+	hGroup.Read(job->Data.get(), job->Size);
+	// read the header; the pixels are decoded later
 	try
 	{
-		CPNGFile png(pData.get(), iSize);
-		width = png.Width(); height = png.Height(), useAlpha = png.UsesAlpha();
-		bmp.reset(new StdBitmap(width, height, useAlpha));
-		png.Decode(bmp->GetBytes());
+		job->Png = std::make_unique<CPNGFile>(job->Data.get(), job->Size);
 	}
 	catch (const std::runtime_error &e)
 	{
 		LogNTr(spdlog::level::err, "Could not create surface from PNG file: {}", e.what());
-		bmp.reset();
+		return false;
 	}
-	// free file data
-	pData.reset();
-	// abort if loading wasn't successful
-	if (!bmp) return false;
+	job->Format = "PNG";
+	job->Width = job->Png->Width(); job->Height = job->Png->Height();
+	job->UseAlpha = job->Png->UsesAlpha();
+	job->CacheDirectory = DecodedImageCache.GetDirectory();
 	// create surface(s) - do not create an 8bit-buffer!
-	if (!Create(width, height)) return false;
+	if (!Create(job->Width, job->Height)) return false;
+	return Decode(std::move(job));
+}
+
+bool C4Surface::Decode(std::shared_ptr<C4SurfaceDecodeJob> job)
+{
+	// decode right away without a batch
+	if (!C4SurfaceDecodeBatch::Current || !C4ThreadPool::Global)
+	{
+		job->Decode();
+		return UploadDecoded(*job);
+	}
+	job->Surface = this;
+	PendingDecode = job;
+	C4SurfaceDecodeBatch::Current->Jobs.push_back(job);
+	C4ThreadPool::Global->SubmitCallback([job]
+	{
+		job->Decode();
+		job->Done.count_down();
+	});
+	return true;
+}
+
+void C4Surface::FinishDecode()
+{
+	const auto job = std::move(PendingDecode);
+	job->Surface = nullptr;
+	job->Done.wait();
+	if (!UploadDecoded(*job) && !job->KeepOnError) fDecodeFailed = true;
+}
+
+bool C4Surface::UploadDecoded(C4SurfaceDecodeJob &job)
+{
+	if (!job.Bitmap)
+	{
+		LogNTr(spdlog::level::err, "Could not create surface from {} file: {}", job.Format, job.Error);
+		return false;
+	}
+	const bool result{UploadBitmap(*job.Bitmap, job.UseAlpha)};
+	job.Bitmap.reset();
+	return result;
+}
+
+bool C4Surface::UploadBitmap(const StdBitmap &bmp, const bool useAlpha)
+{
+	C4TRACE_ZONE("C4Surface::UploadBitmap");
 	// lock for writing data
 	if (!Lock()) return false;
 	if (!ppTex)
@@ -966,10 +1155,9 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				// Optimize the easy case of a png in the same format as the display
 				// 32 bit
 				uint32_t *pPix = reinterpret_cast<uint32_t *>((reinterpret_cast<char *>(pTexRef->texLock.pBits)) + iY * pTexRef->texLock.Pitch);
-				memcpy(pPix, static_cast<const std::uint32_t *>(bmp->GetPixelAddr32(0, rY)) +
+				// fully transparent pixels have been made black by the decoder
+				memcpy(pPix, static_cast<const std::uint32_t *>(bmp.GetPixelAddr32(0, rY)) +
 					tX * iTexSize, maxX * 4);
-				int iX = maxX;
-				while (iX--) { if (reinterpret_cast<uint8_t *>(pPix)[3] == 0xff) *pPix = 0xff000000; ++pPix; }
 			}
 			else
 #endif
@@ -977,7 +1165,7 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				// Loop through every pixel and convert
 				for (int iX = 0; iX < maxX; ++iX)
 				{
-					uint32_t dwCol = bmp->GetPixel(iX + tX * iTexSize, rY);
+					uint32_t dwCol = bmp.GetPixel(iX + tX * iTexSize, rY);
 					// if color is fully transparent, ensure it's black
 					if (dwCol >> 24 == 0xff) dwCol = 0xff000000;
 					// set pix in surface
@@ -1028,57 +1216,43 @@ bool C4Surface::Copy(C4Surface &fromSfc)
 
 bool C4Surface::ReadJPEG(C4Group &hGroup)
 {
-	// create mem block
-	size_t size = hGroup.AccessedEntrySize();
-	unsigned char *pData = new unsigned char[size];
+	auto job = std::make_shared<C4SurfaceDecodeJob>();
 	// load file into mem
-	hGroup.Read(pData, size);
-
-	bool locked = false;
+	job->Size = hGroup.AccessedEntrySize();
+	job->Data = std::make_unique_for_overwrite<uint8_t[]>(job->Size);
+	hGroup.Read(job->Data.get(), job->Size);
+	// read the header; the pixels are decoded later
 	try
 	{
-		StdJpeg jpeg(pData, size);
-		const std::uint32_t width = jpeg.Width(), height = jpeg.Height();
-
-		// create surface(s) - do not create an 8bit-buffer!
-		if (!Create(width, height)) return false;
-
-		// lock for writing data
-		if (!Lock()) return false;
-		locked = true;
-
-		// put the data in the image
-		for (std::uint32_t y = 0; y < height; ++y)
-		{
-			const auto row = jpeg.DecodeRow();
-			for (std::uint32_t x = 0; x < width; ++x)
-			{
-				const auto pixel = static_cast<const uint8_t *>(row) + x * 3;
-				SetPixDw(x, y, C4RGB(pixel[0], pixel[1], pixel[2]));
-			}
-		}
-		jpeg.Finish();
+		job->Jpeg = std::make_unique<StdJpeg>(job->Data.get(), job->Size);
 	}
 	catch (const std::runtime_error &e)
 	{
 		LogNTr(spdlog::level::err, "Could not create surface from JPEG file: {}", e.what());
+		return true;
 	}
-
-	// unlock
-	if (locked) Unlock();
-	// free data
-	delete[] pData;
-	// return if successful
+	job->Format = "JPEG";
+	job->Width = job->Jpeg->Width(); job->Height = job->Jpeg->Height();
+	job->UseAlpha = true;
+	job->KeepOnError = true;
+	job->CacheDirectory = DecodedImageCache.GetDirectory();
+	// create surface(s) - do not create an 8bit-buffer!
+	if (!Create(job->Width, job->Height)) return false;
+	// a broken JPEG leaves an empty surface, as always
+	Decode(std::move(job));
 	return true;
 }
 
-C4TexRef::C4TexRef(int iSize, bool fSingle) : LockCount{0}
+C4TexRef::C4TexRef(int iSize, bool fAsRenderTarget) : LockCount{0}
 {
 	// zero fields
 #ifndef USE_CONSOLE
 	texName = 0;
+	fboName = 0;
 #endif
 	texLock.pBits = nullptr; fIntLock = false;
+	fStreamed = false;
+	DirtyX1 = DirtyY1 = DirtyX2 = DirtyY2 = 0;
 	// store size
 	this->iSize = iSize;
 	// add to texture manager
@@ -1105,6 +1279,27 @@ C4TexRef::C4TexRef(int iSize, bool fSingle) : LockCount{0}
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexImage2D(GL_TEXTURE_2D, 0, 4, iSize, iSize, 0, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, nullptr);
+
+	// render targets are only drawn to by the gpu and need no memory copy
+	if (fAsRenderTarget && lpDDraw->CanRenderOffscreen())
+	{
+		// pending blits go to the currently bound framebuffer
+		lpDDraw->FlushDrawList();
+		GLint prevFramebuffer{0};
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+		glGenFramebuffers(1, &fboName);
+		glBindFramebuffer(GL_FRAMEBUFFER, fboName);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texName, 0);
+		const bool fComplete{glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE};
+		glBindFramebuffer(GL_FRAMEBUFFER, prevFramebuffer);
+		if (fComplete)
+		{
+			LockSize = {0, 0, 0, 0};
+			return;
+		}
+		glDeleteFramebuffers(1, &fboName);
+		fboName = 0;
+	}
 #endif
 
 	// create mem array for texture creation
@@ -1122,6 +1317,9 @@ C4TexRef::~C4TexRef()
 #ifndef USE_CONSOLE
 	if (pGL && pGL->pCurrCtx)
 	{
+		// recorded blits might still refer to this texture
+		pGL->FlushDrawList();
+		if (fboName) glDeleteFramebuffers(1, &fboName);
 		glDeleteTextures(1, &texName);
 	}
 #endif
@@ -1171,7 +1369,12 @@ bool C4TexRef::LockForUpdate(const C4Rect rect)
 bool C4TexRef::Lock()
 {
 	// already locked?
-	if (texLock.pBits) return true;
+	if (texLock.pBits)
+	{
+		// streamed textures may be changed anywhere now
+		if (fStreamed) MarkChanged(0, 0, iSize, iSize);
+		return true;
+	}
 	LockSize = {0, 0, iSize, iSize};
 	// lock
 #ifndef USE_CONSOLE
@@ -1200,6 +1403,8 @@ void C4TexRef::Unlock([[maybe_unused]] bool noUpload)
 {
 	// locked?
 	if (!texLock.pBits || fIntLock) return;
+	// streamed textures stay locked; changes are uploaded by the texture manager
+	if (fStreamed) return;
 #ifndef USE_CONSOLE
 	if (pGL)
 	{
@@ -1207,6 +1412,8 @@ void C4TexRef::Unlock([[maybe_unused]] bool noUpload)
 		{
 			// select context, if not already done
 			if (!pGL->pCurrCtx) if (!pGL->MainCtx.Select()) return;
+			// recorded blits must use the previous contents
+			pGL->FlushDrawList();
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 			glBindTexture(GL_TEXTURE_2D, texName);
 			glTexSubImage2D(GL_TEXTURE_2D, 0,
@@ -1252,7 +1459,59 @@ bool C4TexRef::FillBlack()
 
 // texture manager
 
-C4TexMgr::C4TexMgr()
+bool C4TexRef::SetStreamed(const bool fToVal)
+{
+	if (fStreamed == fToVal) return true;
+	if (fToVal)
+	{
+		// need the complete texture in RAM
+		if (texLock.pBits && (LockSize.x || LockSize.y || LockSize.Wdt != iSize || LockSize.Hgt != iSize)) Unlock();
+		if (!texLock.pBits && !Lock()) return false;
+		fStreamed = true;
+		// contents of a fresh lock might not have been uploaded yet
+		MarkChanged(0, 0, iSize, iSize);
+	}
+	else
+	{
+		UploadChanges();
+		fStreamed = false;
+		Unlock(true);
+	}
+	return true;
+}
+
+size_t C4TexRef::UploadChanges()
+{
+	// anything changed?
+	if (DirtyX1 >= DirtyX2) return 0;
+	const C4Rect rect{DirtyX1, DirtyY1, DirtyX2 - DirtyX1, DirtyY2 - DirtyY1};
+	DirtyX1 = DirtyY1 = DirtyX2 = DirtyY2 = 0;
+#ifndef USE_CONSOLE
+	if (pGL && texLock.pBits)
+	{
+		// select context, if not already done
+		if (!pGL->pCurrCtx) if (!pGL->MainCtx.Select()) return 0;
+		// recorded blits must use the previous contents
+		pGL->FlushDrawList();
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, iSize);
+		glBindTexture(GL_TEXTURE_2D, texName);
+		glTexSubImage2D(GL_TEXTURE_2D, 0,
+			rect.x, rect.y, rect.Wdt, rect.Hgt,
+			GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texLock.pBits + rect.y * texLock.Pitch + rect.x * 4);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		return static_cast<size_t>(rect.Wdt) * rect.Hgt * 4;
+	}
+#endif
+	return 0;
+}
+
+void C4TexRef::QueueUpload()
+{
+	pTexMgr->QueueUpload(this);
+}
+
+C4TexMgr::C4TexMgr() : UploadedBytes{0}
 {
 	// clear textures
 	Textures.clear();
@@ -1274,6 +1533,7 @@ void C4TexMgr::UnregTex(C4TexRef *pTex)
 {
 	// remove texture from list
 	Textures.remove(pTex);
+	std::erase(UploadQueue, pTex);
 	// if list is empty, remove self
 	if (Textures.empty()) { delete this; pTexMgr = nullptr; }
 }
@@ -1297,7 +1557,19 @@ void C4TexMgr::IntUnlock()
 	{
 		C4TexRef *pRef = *i;
 		if (pRef->fIntLock) { pRef->fIntLock = false; pRef->Unlock(); }
+		// streamed textures stay locked, so their whole contents must be uploaded again
+		else if (pRef->fStreamed) pRef->MarkChanged(0, 0, pRef->iSize, pRef->iSize);
+	}
+}
+
+void C4TexMgr::UploadChanges()
+{
+	// each texture is queued once, with the union of its changes
+	for (C4TexRef *const pTex : UploadQueue)
+	{
+		UploadedBytes += pTex->UploadChanges();
 	}
+	UploadQueue.clear();
 }
 
 C4TexMgr *pTexMgr;
@@ -27,6 +27,8 @@
 #endif
 
 #include <list>
+#include <memory>
+#include <vector>
 
 // config settings
 #define C4GFXCFG_NO_ALPHA_ADD    1
@@ -65,6 +67,8 @@ extern CStdDDraw *lpDDraw;
 
 class C4Group;
 class C4GroupSet;
+class StdBitmap;
+struct C4SurfaceDecodeJob;
 
 class C4Surface
 {
@@ -88,6 +92,7 @@ public:
 	bool Unlock(bool noUpload = false);
 	bool Lock();
 	bool LockForUpdate(C4Rect rect);
+	bool SetStreamed(bool fToVal); // keep textures in RAM and upload changed parts once per frame
 	bool GetTexAt(C4TexRef **ppTexRef, int &rX, int &rY); // get texture and adjust x/y
 	bool GetLockTexAt(C4TexRef **ppTexRef, int &rX, int &rY); // get texture; ensure it's locked and adjust x/y
 	bool SetPix(int iX, int iY, uint8_t byCol); // set 8bit-px
@@ -105,6 +110,7 @@ public:
 	void NoClip();
 	bool Read(C4Group &hGroup, bool fOwnPal = false);
 	bool SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale = 1.0f);
+	std::unique_ptr<StdBitmap> CopyToBitmap(bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale = 1.0f); // copy pixels for encoding them elsewhere; nullptr on failure
 	bool Wipe(); // empty to transparent
 	bool GetSurfaceSize(int &irX, int &irY); // get surface size
 	void SetClr(uint32_t toClr) { ClrByOwnerClr = toClr ? toClr : 0xff; }
@@ -118,10 +124,16 @@ public:
 	bool Copy(C4Surface &fromSfc);
 	bool ReadPNG(C4Group &hGroup);
 	bool ReadJPEG(C4Group &hGroup);
+	bool HasDecodeFailed() const { return fDecodeFailed; } // a batched ReadPNG could not be decoded; valid after C4SurfaceDecodeBatch::Finish
 
 private:
 	bool CreateTextures(); // create ppTex-array
 	void FreeTextures(); // free ppTex-array if existent
+	bool Decode(std::shared_ptr<C4SurfaceDecodeJob> job); // decode now or in the current C4SurfaceDecodeBatch
+	bool UploadDecoded(C4SurfaceDecodeJob &job);
+	bool UploadBitmap(const StdBitmap &bmp, bool useAlpha); // copy a decoded image of the surface size into the textures
+	void FinishDecode(); // wait for the pending decode and upload it
+	void WaitForDecode() { if (PendingDecode) FinishDecode(); }
 
 	friend class CStdDDraw;
 	friend class CPattern;
@@ -148,10 +160,37 @@ public:
 private:
 	int Locked;
 	bool fPrimary;
+	std::shared_ptr<C4SurfaceDecodeJob> PendingDecode; // image that is still decoded by a C4SurfaceDecodeBatch
+	bool fDecodeFailed;
+
+	friend class C4SurfaceDecodeBatch;
 
 	bool IsSingleSurface() const { return iTexX * iTexY == 1; } // return whether surface is not split
 };
 
+// While a batch exists, ReadPNG and ReadJPEG only read the file and its header and create the surface.
+// The pixels are decoded on C4ThreadPool, so the decoding overlaps with reading the next files.
+// They are uploaded on the main thread when the batch finishes or when the surface is locked before.
+class C4SurfaceDecodeBatch
+{
+public:
+	C4SurfaceDecodeBatch();
+	~C4SurfaceDecodeBatch();
+
+	C4SurfaceDecodeBatch(const C4SurfaceDecodeBatch &) = delete;
+	C4SurfaceDecodeBatch &operator=(const C4SurfaceDecodeBatch &) = delete;
+
+	void Finish(); // upload all images decoded so far
+
+private:
+	std::vector<std::shared_ptr<C4SurfaceDecodeJob>> Jobs;
+	C4SurfaceDecodeBatch *pPrevious;
+
+	static inline C4SurfaceDecodeBatch *Current{nullptr};
+
+	friend class C4Surface;
+};
+
 struct D3DLOCKED_RECT
 {
 	int Pitch;
@@ -165,10 +204,13 @@ public:
 	D3DLOCKED_RECT texLock; // current lock-data
 #ifndef USE_CONSOLE
 	GLuint texName;
+	GLuint fboName; // framebuffer of offscreen render targets
 #endif
 	int iSize;
 	bool fIntLock; // if set, texref is locked internally only
+	bool fStreamed; // if set, texref stays locked and changes are uploaded by the texture manager
 	C4Rect LockSize;
+	int DirtyX1, DirtyY1, DirtyX2, DirtyY2; // changed part of streamed texture
 
 	C4TexRef(int iSize, bool fAsRenderTarget); // create texture with given size
 	~C4TexRef(); // release texture
@@ -179,13 +221,37 @@ public:
 	void Unlock(bool noUpload = false); // unlock texture
 	bool ClearRect(C4Rect rect); // clear rect in texture to transparent
 	bool FillBlack(); // fill complete texture in black
+	bool SetStreamed(bool fToVal);
+#ifndef USE_CONSOLE
+	bool IsRenderTarget() const { return fboName != 0; }
+#else
+	bool IsRenderTarget() const { return false; }
+#endif
+	size_t UploadChanges(); // upload changed part of streamed texture; returns number of bytes
 
 	void SetPix(int iX, int iY, uint32_t v)
 	{
 		*reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(texLock.pBits) + (iY - LockSize.y) * texLock.Pitch + (iX - LockSize.x) * 4) = v;
+		if (fStreamed) MarkChanged(iX, iY, iX + 1, iY + 1);
+	}
+
+	void MarkChanged(int iX1, int iY1, int iX2, int iY2)
+	{
+		if (DirtyX1 >= DirtyX2)
+		{
+			DirtyX1 = iX1; DirtyY1 = iY1; DirtyX2 = iX2; DirtyY2 = iY2;
+			QueueUpload();
+		}
+		else
+		{
+			DirtyX1 = (std::min)(DirtyX1, iX1); DirtyY1 = (std::min)(DirtyY1, iY1);
+			DirtyX2 = (std::max)(DirtyX2, iX2); DirtyY2 = (std::max)(DirtyY2, iY2);
+		}
 	}
 
 private:
+	void QueueUpload();
+
 	int32_t LockCount;
 };
 
@@ -194,6 +260,8 @@ class C4TexMgr
 {
 public:
 	std::list<C4TexRef *> Textures;
+	std::vector<C4TexRef *> UploadQueue; // streamed textures with changes
+	size_t UploadedBytes; // bytes uploaded from the queue since last TakeUploadedBytes
 
 public:
 	C4TexMgr();
@@ -204,6 +272,10 @@ public:
 
 	void IntLock(); // do an internal lock
 	void IntUnlock(); // undo internal lock
+
+	void QueueUpload(C4TexRef *pTex) { UploadQueue.push_back(pTex); }
+	void UploadChanges(); // upload changes of all streamed textures
+	size_t TakeUploadedBytes() { const size_t result{UploadedBytes}; UploadedBytes = 0; return result; }
 };
 
 extern C4TexMgr *pTexMgr;
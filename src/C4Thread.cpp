@@ -14,6 +14,7 @@
  */
 
 #include "C4Thread.h"
+#include "C4Trace.h"
 
 #ifdef _WIN32
 #include "C4Windows.h"
@@ -38,4 +39,6 @@ void C4Thread::SetCurrentThreadName(const std::string_view name)
 #elif defined(__APPLE__)
 	pthread_setname_np(std::string{name}.c_str());
 #endif
+
+	C4Trace::SetThreadName(name);
 }
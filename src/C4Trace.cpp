@@ -0,0 +1,174 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Trace.h>
+
+#include <StdBuf.h>
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic_bool C4Trace::Capturing{false};
+
+namespace
+{
+	struct Zone
+	{
+		const char *Name;
+		std::int64_t Start;
+		std::int64_t End;
+	};
+
+	constexpr std::size_t BlockSize{1 << 14}; // zones per block of a thread buffer
+
+	struct ThreadBuffer
+	{
+		std::uint32_t Id;
+		std::array<std::unique_ptr<Zone[]>, C4Trace::BufferSize / BlockSize> Blocks; // allocated when recording reaches them and reused by later captures
+		// capture number in the upper and number of recorded zones in the lower half,
+		// so both are read consistently by Save while the thread keeps recording
+		std::atomic<std::uint64_t> State{0};
+		std::string Name; // guarded by BuffersMutex
+	};
+
+	std::mutex BuffersMutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> Buffers; // kept after threads exit until their zones are saved or discarded
+	std::uint32_t NextId{0}; // guarded by BuffersMutex
+	std::atomic<std::uint32_t> CurrentCapture{0};
+	std::int64_t CaptureStart{0};
+
+	ThreadBuffer &GetThreadBuffer()
+	{
+		thread_local const std::shared_ptr<ThreadBuffer> buffer{[]
+		{
+			auto newBuffer = std::make_shared<ThreadBuffer>();
+			const std::lock_guard lock{BuffersMutex};
+			newBuffer->Id = NextId++;
+			Buffers.emplace_back(newBuffer);
+			return newBuffer;
+		}()};
+		return *buffer;
+	}
+
+	// free the buffers of threads that have exited; BuffersMutex must be held
+	void PruneExitedThreads()
+	{
+		// the thread_local reference is the only other owner and is released on thread exit
+		std::erase_if(Buffers, [](const auto &buffer) { return buffer.use_count() == 1; });
+	}
+}
+
+std::int64_t C4Trace::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void C4Trace::Record(const char *const name, const std::int64_t start, const std::int64_t end)
+{
+	ThreadBuffer &buffer{GetThreadBuffer()};
+	const std::uint64_t capture{CurrentCapture.load(std::memory_order_acquire)};
+
+	std::uint64_t state{buffer.State.load(std::memory_order_relaxed)};
+	if ((state >> 32) != capture) state = capture << 32;
+
+	const std::size_t count{static_cast<std::size_t>(state & 0xFFFFFFFF)};
+	if (count == BufferSize) return;
+
+	std::unique_ptr<Zone[]> &block{buffer.Blocks[count / BlockSize]};
+	if (!block) block = std::make_unique_for_overwrite<Zone[]>(BlockSize);
+	block[count % BlockSize] = {name, start, end};
+	buffer.State.store(state + 1, std::memory_order_release);
+}
+
+void C4Trace::Start()
+{
+	{
+		// zones of exited threads would be discarded anyway
+		const std::lock_guard lock{BuffersMutex};
+		PruneExitedThreads();
+	}
+	CaptureStart = Now();
+	CurrentCapture.fetch_add(1, std::memory_order_release);
+	Capturing.store(true, std::memory_order_relaxed);
+}
+
+void C4Trace::Stop()
+{
+	Capturing.store(false, std::memory_order_relaxed);
+}
+
+bool C4Trace::Save(const char *const filename)
+{
+	const std::uint64_t capture{CurrentCapture.load(std::memory_order_acquire)};
+	std::string output{"{\"displayTimeUnit\":\"ns\",\"traceEvents\":["};
+	bool first{true};
+	const auto addEvent = [&output, &first](const std::string &event)
+	{
+		if (!first) output += ',';
+		first = false;
+		output += '\n';
+		output += event;
+	};
+
+	const std::lock_guard lock{BuffersMutex};
+	for (const auto &buffer : Buffers)
+	{
+		const std::uint64_t state{buffer->State.load(std::memory_order_acquire)};
+		if ((state >> 32) != capture) continue;
+
+		const std::size_t count{static_cast<std::size_t>(state & 0xFFFFFFFF)};
+		const std::string name{buffer->Name.empty() ? std::format("Thread {}", buffer->Id) : EscapeJson(buffer->Name)};
+		addEvent(std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}{}\"}}}}",
+			buffer->Id, name, count == BufferSize ? " (buffer full)" : ""));
+
+		// timestamps are in microseconds
+		for (std::size_t i{0}; i < count; ++i)
+		{
+			const Zone &zone{buffer->Blocks[i / BlockSize][i % BlockSize]};
+			addEvent(std::format("{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+				EscapeJson(zone.Name), buffer->Id, (zone.Start - CaptureStart) / 1000.0, (zone.End - zone.Start) / 1000.0));
+		}
+	}
+	output += "\n]}\n";
+	// zones of exited threads cannot be added to anymore
+	PruneExitedThreads();
+
+	return StdStrBuf{output.c_str(), output.size(), false}.SaveToFile(filename);
+}
+
+void C4Trace::SetThreadName(const std::string_view name)
+{
+	ThreadBuffer &buffer{GetThreadBuffer()};
+	const std::lock_guard lock{BuffersMutex};
+	buffer.Name = name;
+}
+
+std::string C4Trace::EscapeJson(const std::string_view text)
+{
+	std::string result;
+	result.reserve(text.size());
+	for (const char c : text)
+	{
+		if (c == '"' || c == '\\') result += '\\';
+		if (static_cast<unsigned char>(c) < 0x20) result += std::format("\\u{:04x}", static_cast<int>(c));
+		else result += c;
+	}
+	return result;
+}
@@ -0,0 +1,69 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Scoped trace zones for measuring engine code */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Trace zones measure the time spent in a scope of engine code:
+//   C4TRACE_ZONE("C4Game::Execute ExecObjects");
+// They are always compiled in. While no capture is running, a zone costs a single relaxed atomic load.
+// During a capture, every thread records its finished zones into a buffer of its own without locking.
+// Captures are saved as Chrome trace JSON, which can be opened in about:tracing or Perfetto.
+namespace C4Trace
+{
+	inline constexpr std::size_t BufferSize{1 << 20}; // zones recorded per thread and capture; later zones are dropped
+
+	extern std::atomic_bool Capturing;
+
+	inline bool IsCapturing() { return Capturing.load(std::memory_order_relaxed); }
+
+	std::int64_t Now(); // steady clock time in nanoseconds
+	void Record(const char *name, std::int64_t start, std::int64_t end); // name must stay valid until the capture is saved
+
+	void Start(); // discards the previous capture
+	void Stop();
+	bool Save(const char *filename);
+
+	void SetThreadName(std::string_view name); // shown for the calling thread
+
+	std::string EscapeJson(std::string_view text);
+}
+
+class C4TraceZone
+{
+public:
+	explicit C4TraceZone(const char *const name) : name{name}, start{C4Trace::IsCapturing() ? C4Trace::Now() : -1} {}
+	~C4TraceZone() { if (start >= 0) C4Trace::Record(name, start, C4Trace::Now()); }
+
+	C4TraceZone(const C4TraceZone &) = delete;
+	C4TraceZone &operator=(const C4TraceZone &) = delete;
+
+private:
+	const char *name;
+	std::int64_t start;
+};
+
+#define C4TRACE_CONCAT2(a, b) a##b
+#define C4TRACE_CONCAT(a, b) C4TRACE_CONCAT2(a, b)
+
+// measures the rest of the enclosing scope; name must be a string literal
+#define C4TRACE_ZONE(name) C4TraceZone C4TRACE_CONCAT(traceZone, __LINE__){name}
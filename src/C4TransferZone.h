@@ -27,6 +27,7 @@ class C4TransferZones;
 class C4TransferZone
 {
 	friend class C4TransferZones;
+	friend class C4PathFinderGraph;
 
 public:
 	C4TransferZone();
@@ -50,6 +51,8 @@ public:
 
 class C4TransferZones
 {
+	friend class C4PathFinderGraph;
+
 public:
 	C4TransferZones();
 	~C4TransferZones();
@@ -182,6 +182,37 @@ void C4Value::Move(C4Value *nValue)
 	Set0();
 }
 
+void C4Value::Relocate(C4Value *nValue)
+{
+	assert(nValue->Type == C4V_Any && !nValue->Data && !nValue->FirstRef);
+
+	// the reference is relinked by Move
+	if (Type == C4V_pC4Value)
+	{
+		Move(nValue);
+		return;
+	}
+
+	nValue->Data = Data;
+	nValue->Type = Type;
+
+	// the reference held on containers and strings is passed on
+	if (Type == C4V_C4Object)
+	{
+		Data.Obj->DelRef(this, GetNextRef());
+		Data.Obj->AddRef(nValue);
+	}
+
+	// change references
+	for (C4Value *pVal = FirstRef; pVal; pVal = pVal->GetNextRef())
+		pVal->Data.Ref = nValue;
+
+	nValue->FirstRef = FirstRef;
+	FirstRef = nullptr;
+	Data.Raw = 0;
+	Type = C4V_Any;
+}
+
 void C4Value::GetContainerElement(C4Value *index, C4Value &target, C4AulContext *pctx, bool noref)
 {
 	try
@@ -141,13 +141,6 @@ public:
 		Data.Ref = pVal; AddDataRef();
 	}
 
-	static C4Value *OfMap(C4ValueHash *map)
-	{
-		auto ret = new C4Value;
-		ret->OwningMap = map;
-		return ret;
-	}
-
 	C4Value &operator=(const C4Value &nValue);
 
 	~C4Value();
@@ -217,6 +210,8 @@ public:
 	C4Value operator--(int)            { C4Value alt = GetRefVal(); GetData().Int--; GetRefVal().Type = C4V_Int; return alt; }
 
 	void Move(C4Value *nValue);
+	// like Move, but nValue must be empty and contained arrays and maps are handed over instead of being copied
+	void Relocate(C4Value *nValue);
 
 	C4Value GetRef() { return C4Value(this); }
 	void Deref() { Set(GetRefVal()); }
@@ -298,6 +293,7 @@ protected:
 
 	friend class C4Object;
 	friend class C4AulDefFunc;
+	friend class C4ValueHash;
 };
 
 // converter
@@ -15,10 +15,12 @@
  */
 
 #include "C4ValueHash.h"
+#include "C4Object.h"
 #include "C4StringTable.h"
 
-#include <optional>
-#include <stdexcept>
+#include <algorithm>
+#include <bit>
+#include <cassert>
 
 C4ValueHash::C4ValueHash() { }
 
@@ -39,6 +41,7 @@ void C4ValueHash::CompileFunc(StdCompiler *pComp)
 
 void C4ValueHash::DenumeratePointers()
 {
+	// key hashes do not change, see std::hash<C4Value>
 	for (auto [key, value] : *this)
 	{
 		const_cast<C4Value &>(key).DenumeratePointer();
@@ -48,50 +51,76 @@ void C4ValueHash::DenumeratePointers()
 
 void C4ValueHash::removeValue(C4Value *value)
 {
-	const auto erase = [this](const auto &it)
+	// called by a key or value that became nil, so the entry must stay in place until the next compaction
+	const auto offset = reinterpret_cast<std::uintptr_t>(value) - reinterpret_cast<std::uintptr_t>(entries.data());
+	if (offset >= entries.size() * sizeof(Entry)) return;
+	Entry &entry = entries[offset / sizeof(Entry)];
+	if (entry.Removed || (value != &entry.Key && value != &entry.Value)) return;
+	entry.Removed = true;
+	entry.Key.OwningMap = entry.Value.OwningMap = nullptr;
+	--count;
+}
+
+const C4ValueHash::Entry *C4ValueHash::find(const C4Value &key, const std::size_t hash) const
+{
+	if (slots.empty()) return nullptr;
+	const std::size_t mask = slots.size() - 1;
+	for (std::size_t i = hash & mask; slots[i] != EmptySlot; i = (i + 1) & mask)
 	{
-		keyOrder.erase(it->second.keyOrderIterator);
-		map.erase(it);
-	};
-	bool found = false;
-	auto keyIt = map.end();
-	for (auto it = map.begin(); it != map.end(); )
+		const Entry &entry = entries[slots[i]];
+		if (!entry.Removed && entry.Hash == hash && keyEquals(entry.Key, key)) return &entry;
+	}
+	return nullptr;
+}
+
+void C4ValueHash::rebuild(const std::size_t slotCount)
+{
+	std::vector<Entry> newEntries;
+	newEntries.reserve(slotCount / 2);
+	for (Entry &entry : entries)
 	{
-		if (&it->first == value)
-		{
-			keyIt = it;
-			emptyValues.push_front(it->second.value);
-		}
-		else if (it->second.value == value)
-		{
-			erase(it++);
-			found = true;
-			continue;
-		}
-		++it;
+		if (entry.Removed) continue;
+		Entry &newEntry = newEntries.emplace_back(entry.Hash, entry.Order);
+		// keys and values of maps are never references themselves
+		assert(entry.Key.Type != C4V_pC4Value && entry.Value.Type != C4V_pC4Value);
+		entry.Key.OwningMap = entry.Value.OwningMap = nullptr;
+		entry.Key.Relocate(&newEntry.Key);
+		entry.Value.Relocate(&newEntry.Value);
+		newEntry.Key.OwningMap = newEntry.Value.OwningMap = this;
 	}
-	if (found) emptyValues.push_front(value);
-	if (keyIt != map.end()) erase(keyIt);
+	entries.swap(newEntries);
+
+	slots.assign(slotCount, EmptySlot);
+	const std::size_t mask = slotCount - 1;
+	for (std::size_t index = 0; index < entries.size(); ++index)
+	{
+		std::size_t i = entries[index].Hash & mask;
+		while (slots[i] != EmptySlot) i = (i + 1) & mask;
+		slots[i] = static_cast<std::int32_t>(index);
+	}
+	++compactions;
+	// removed entries are destroyed now, turning references to their values into copies
 }
 
 bool C4ValueHash::contains(const C4Value &key) const
 {
-	return map.find(key) != map.end();
+	return find(key, std::hash<C4Value>{}(key)) != nullptr;
 }
 
 void C4ValueHash::clear()
 {
-	for (auto &[key, value] : map) delete value.value;
-	map.clear();
-	for (auto &value : emptyValues) delete value;
-	emptyValues.clear();
+	std::vector<Entry> oldEntries;
+	oldEntries.swap(entries);
+	slots.clear();
+	count = 0;
+	++compactions;
 }
 
 C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 {
-	for (const auto key : other.keyOrder)
+	for (const Entry &entry : other.entries)
 	{
-		(*this)[*key].Set(*other.map.at(*key).value);
+		if (!entry.Removed) (*this)[entry.Key].Set(entry.Value);
 	}
 	return *this;
 }
@@ -100,9 +129,11 @@ bool C4ValueHash::operator==(const C4ValueHash &other) const
 {
 	if (other.size() != size()) return false;
 
-	for (const auto &it : map)
+	for (const Entry &entry : entries)
 	{
-		if (!other.contains(it.first) || other[it.first] != *it.second.value)
+		if (entry.Removed) continue;
+		const Entry *otherEntry = other.find(entry.Key, entry.Hash);
+		if (!otherEntry || otherEntry->Value != entry.Value)
 			return false;
 	}
 
@@ -116,78 +147,102 @@ bool C4ValueHash::hasIndex(const C4Value &key) const
 
 C4Value &C4ValueHash::operator[](const C4Value &key)
 {
-	try
-	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
+	const std::size_t hash = std::hash<C4Value>{}(key);
+	if (const Entry *entry = find(key, hash))
+		return const_cast<C4Value &>(entry->Value);
+
+	const C4Value *newKey = &key.GetRefVal();
+	C4Value keyCopy;
+	// full or index half used: drop removed entries and grow if necessary
+	if (entries.size() == entries.capacity() || entries.size() * 2 >= slots.size())
 	{
-		C4Value *value;
-		if (emptyValues.empty()) value = C4Value::OfMap(this);
-		else
-		{
-			value = emptyValues.front();
-			emptyValues.pop_front();
-		}
-
-		const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key, this), std::forward_as_tuple(MapEntry{value, {}})).first;
-		inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
-		return *value;
+		// the key might be relocated otherwise
+		keyCopy.Set(*newKey);
+		newKey = &keyCopy;
+		rebuild(std::max(MinSlots, std::bit_ceil(4 * (count + 1))));
 	}
+
+	const std::size_t index = entries.size();
+	Entry &entry = entries.emplace_back(hash, nextOrder++);
+	entry.Key.Set(*newKey);
+	entry.Key.OwningMap = entry.Value.OwningMap = this;
+	const std::size_t mask = slots.size() - 1;
+	std::size_t i = hash & mask;
+	while (slots[i] != EmptySlot) i = (i + 1) & mask;
+	slots[i] = static_cast<std::int32_t>(index);
+	++count;
+	return entry.Value;
 }
 
 const C4Value &C4ValueHash::operator[](const C4Value &key) const
 {
-	try
-	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
-	{
-		return C4VNull;
-	}
+	const Entry *entry = find(key, std::hash<C4Value>{}(key));
+	return entry ? entry->Value : C4VNull;
 }
 
 C4ValueHash::Iterator C4ValueHash::begin()
 {
-	return Iterator(this, keyOrder.begin(), keyOrder.end());
+	return Iterator(this, 0);
 }
 
 C4ValueHash::Iterator C4ValueHash::end()
 {
-	return Iterator(this, keyOrder.end(), keyOrder.end());
+	return Iterator(this, entries.size());
 }
 
-C4ValueHash::Iterator::Iterator(C4ValueHash *map, C4ValueHash::Iterator::iterator_type it, C4ValueHash::Iterator::iterator_type end) : it(it), end(end), map(map)
+C4ValueHash::Iterator::Iterator(C4ValueHash *map, const std::size_t index) : map(map), index(index), order(0), compactions(map->compactions), atEnd(false)
 {
 	update();
 }
 
+std::size_t C4ValueHash::Iterator::position() const
+{
+	if (atEnd) return map->entries.size();
+	std::size_t pos = index;
+	// entries were compacted since: find the entry again
+	if (compactions != map->compactions)
+		pos = std::ranges::lower_bound(map->entries, order, {}, &Entry::Order) - map->entries.begin();
+	while (pos < map->entries.size() && map->entries[pos].Removed) ++pos;
+	return pos;
+}
+
 void C4ValueHash::Iterator::update()
 {
-	if (it != end)
+	index = position();
+	compactions = map->compactions;
+	if (index < map->entries.size())
 	{
-		current.emplace(**it, (*map)[**it]);
+		Entry &entry = map->entries[index];
+		order = entry.Order;
+		current.emplace(entry.Key, entry.Value);
 	}
 	else
 	{
+		// stay at the end even if entries are added later
+		atEnd = true;
 		current.reset();
 	}
 }
 
 C4ValueHash::Iterator &C4ValueHash::Iterator::operator++()
 {
-	++it;
-	update();
+	if (!atEnd)
+	{
+		// the current entry may have been removed meanwhile; continue with the next one inserted after it
+		++index;
+		++order;
+		update();
+	}
 	return *this;
 }
 
 C4ValueHash::Iterator::pair_type &C4ValueHash::Iterator::operator*()
 {
+	update();
 	return *current;
 }
 
 bool C4ValueHash::Iterator::operator==(const C4ValueHash::Iterator &other) const
 {
-	return it == other.it;
+	return position() == other.position();
 }
@@ -18,10 +18,11 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
-#include <unordered_map>
-#include <forward_list>
-#include <list>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
 
 class C4ValueHash : public C4ValueStandardRefCountedContainer<C4ValueHash>
 {
@@ -30,37 +31,44 @@ public:
 	using mapped_type = C4Value;
 
 private:
-	struct MapEntry
+	// entries are kept in insertion order, which is needed for network sync
+	struct Entry
 	{
-		C4Value *value;
-		std::list<const C4Value *>::iterator keyOrderIterator;
-	};
+		C4Value Key;
+		C4Value Value;
+		std::size_t Hash;
+		std::uint64_t Order; // increasing with insertion; used by iterators to find their position after compaction
+		bool Removed{false}; // removed entries are kept until the next compaction, as their values may still be in use
 
-	struct KeyEqual
-	{
-		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		Entry(std::size_t hash, std::uint64_t order) : Hash{hash}, Order{order} {}
 	};
 
-	std::unordered_map<key_type, MapEntry, std::hash<key_type>, KeyEqual> map;
-	std::forward_list<C4Value *> emptyValues;
+	static constexpr std::int32_t EmptySlot = -1;
+	static constexpr std::size_t MinSlots = 8;
 
-	// we need a defined order for network sync
-	std::list<const C4Value *> keyOrder;
+	std::vector<Entry> entries; // never grows beyond its capacity, so references to values stay valid until compaction
+	std::vector<std::int32_t> slots; // open addressing index into entries; removed entries keep their slots until compaction
+	std::size_t count{0}; // number of entries not removed
+	std::uint64_t nextOrder{0};
+	std::size_t compactions{0};
 
 public:
 
 	class Iterator
 	{
 		using pair_type = std::pair<const C4Value &, C4Value &>;
-		using iterator_type = decltype(keyOrder.begin());
-		iterator_type it, end;
 		C4ValueHash *map;
+		std::size_t index; // position in map->entries
+		std::uint64_t order; // order of the entry at index or of the next entry to be visited
+		std::size_t compactions; // map->compactions at which index was valid
+		bool atEnd;
 		std::optional<pair_type> current;
 
+		std::size_t position() const;
 		void update();
 
 	public:
-		Iterator(C4ValueHash *map, iterator_type it, iterator_type end);
+		Iterator(C4ValueHash *map, std::size_t index);
 
 		Iterator &operator++();
 		pair_type &operator*();
@@ -85,6 +93,11 @@ public:
 
 	bool contains(const C4Value &key) const;
 	void removeValue(C4Value *value);
-	auto size() const { return map.size(); }
+	auto size() const { return count; }
 	void clear();
+
+private:
+	const Entry *find(const C4Value &key, std::size_t hash) const;
+	void rebuild(std::size_t slotCount); // drop removed entries and rebuild index with given number of slots
+	static bool keyEquals(const C4Value &lhs, const C4Value &rhs) { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
 };
@@ -21,25 +21,41 @@
 #include <C4Aul.h>
 #include <C4FindObject.h>
 
+#include <algorithm>
 #include <format>
-#include <compare>
-#include <ranges>
+#include <functional>
+#include <memory>
 
-C4ValueList::C4ValueList(const std::int32_t size)
+C4ValueList::C4ValueList(const std::int32_t initialSize)
 {
-	SetSize(size);
+	SetSize(initialSize);
 }
 
 C4ValueList::C4ValueList(const C4ValueList &other)
-	: values{other.values}
 {
+	Reserve(other.size);
+
+	for (; size < other.size; ++size)
+	{
+		new (values + size) C4Value{other.values[size]};
+	}
+}
+
+C4ValueList::~C4ValueList()
+{
+	Reset();
+
+	if (values != InlineValues())
+	{
+		std::allocator<C4Value>{}.deallocate(values, capacity);
+	}
 }
 
 C4ValueList &C4ValueList::operator=(const C4ValueList &other)
 {
-	values.resize(other.values.size());
+	SetSize(other.size);
 
-	for (std::size_t i{0}; i < values.size(); ++i)
+	for (std::int32_t i{0}; i < size; ++i)
 	{
 		values[i].Set(other.values[i]);
 	}
@@ -64,39 +80,110 @@ C4Value &C4ValueList::GetItem(std::int32_t index)
 	return values[index];
 }
 
-void C4ValueList::SetSize(const std::int32_t size)
+void C4ValueList::SetSize(std::int32_t newSize)
 {
-	const auto cmp = size <=> GetSize();
+	newSize = std::max(newSize, 0);
+
+	if (newSize < size)
+	{
+		std::destroy(values + newSize, values + size);
+		size = newSize;
+		return;
+	}
+
+	if (newSize == size || newSize > MaxSize)
+	{
+		return;
+	}
+
+	// grow geometrically, so arrays filled one element at a time do not reallocate on every step
+	if (newSize > capacity)
+	{
+		Reserve(std::max(newSize, std::min<std::int32_t>(2 * capacity, MaxSize)));
+	}
+
+	for (; size < newSize; ++size)
+	{
+		new (values + size) C4Value;
+	}
+}
 
-	if (cmp == std::strong_ordering::equal || (cmp == std::strong_ordering::greater && size > MaxSize))
+void C4ValueList::Reserve(const std::int32_t newCapacity)
+{
+	if (newCapacity <= capacity)
 	{
 		return;
 	}
 
-	else if (cmp == std::strong_ordering::less)
+	C4Value *const newValues{std::allocator<C4Value>{}.allocate(newCapacity)};
+
+	// move values without copying contained arrays and maps, references to them follow
+	for (std::int32_t i{0}; i < size; ++i)
+	{
+		new (newValues + i) C4Value;
+		values[i].Relocate(&newValues[i]);
+		values[i].~C4Value();
+	}
+
+	if (values != InlineValues())
+	{
+		std::allocator<C4Value>{}.deallocate(values, capacity);
+	}
+
+	values = newValues;
+	capacity = newCapacity;
+}
+
+void C4ValueList::Append(const C4Value &value)
+{
+	if (size < capacity)
 	{
-		values.resize(size);
+		new (values + size++) C4Value{value.GetRefVal()};
 		return;
 	}
 
-	std::vector<C4Value> newValues(size);
+	// value might be an element of this list
+	const C4Value copy{value.GetRefVal()};
+	Reserve(std::max(2 * capacity, InlineSize));
+	new (values + size++) C4Value{copy};
+}
 
-	for (std::size_t i{0}; i < values.size(); ++i)
+void C4ValueList::Append(std::span<const C4Value> newValues)
+{
+	const auto newSize = size + static_cast<std::int32_t>(newValues.size());
+	if (newSize > capacity)
 	{
-		values[i].Move(&newValues[i]);
+		const bool isElement{!newValues.empty() && newValues.data() >= values && newValues.data() < values + size};
+		const auto offset = isElement ? newValues.data() - values : 0;
+
+		Reserve(std::max(newSize, 2 * capacity));
+
+		if (isElement)
+		{
+			newValues = {values + offset, newValues.size()};
+		}
 	}
 
-	values = std::move(newValues);
+	for (const C4Value &value : newValues)
+	{
+		new (values + size++) C4Value{value.GetRefVal()};
+	}
 }
 
 void C4ValueList::Reset()
 {
-	values.clear();
+	std::destroy(values, values + size);
+	size = 0;
+}
+
+bool C4ValueList::operator==(const C4ValueList &other) const
+{
+	return std::equal(values, values + size, other.values, other.values + other.size);
 }
 
 void C4ValueList::DenumeratePointers()
 {
-	std::ranges::for_each(values, &C4Value::DenumeratePointer);
+	std::for_each(values, values + size, std::mem_fn(&C4Value::DenumeratePointer));
 }
 
 void C4ValueList::CompileFunc(class StdCompiler *pComp)
@@ -122,7 +209,7 @@ void C4ValueList::CompileFunc(class StdCompiler *pComp)
 		// First variable was misinterpreted as size
 		values[0] = C4Value{C4V_Data{size}, C4V_Any};
 		// Read remaining data
-		pComp->Value(mkArrayAdaptS(values.data() + 1, C4MaxVariable - 1, C4Value()));
+		pComp->Value(mkArrayAdaptS(values + 1, C4MaxVariable - 1, C4Value()));
 	}
 	else
 	{
@@ -131,11 +218,11 @@ void C4ValueList::CompileFunc(class StdCompiler *pComp)
 			// Allocate
 			this->SetSize(size);
 			// Values
-			pComp->Value(mkArrayAdaptS(values.data(), size, C4Value()));
+			pComp->Value(mkArrayAdaptS(values, size, C4Value()));
 		}
 		else
 		{
-			pComp->Value(mkArrayAdaptS(values.data(), size));
+			pComp->Value(mkArrayAdaptS(values, size));
 		}
 	}
 }
@@ -151,19 +238,19 @@ C4ValueArray::C4ValueArray(const C4ValueArray &Array2)
 
 C4ValueArray::~C4ValueArray() {}
 
-C4ValueArray *C4ValueArray::SetLength(int32_t size)
+C4ValueArray *C4ValueArray::SetLength(int32_t newSize)
 {
 	if (GetRefCount() > 1)
 	{
-		C4ValueArray *pNew = static_cast<C4ValueArray *>((new C4ValueArray(size))->IncRef());
-		for (std::int32_t i = 0; i < (std::min)(size, GetSize()); i++)
-			pNew->values[i].Set(values[i]);
+		C4ValueArray *pNew = static_cast<C4ValueArray *>((new C4ValueArray())->IncRef());
+		pNew->Append({values, static_cast<std::size_t>(std::clamp(newSize, 0, size))});
+		pNew->SetSize(newSize);
 		DecRef();
 		return pNew;
 	}
 	else
 	{
-		SetSize(size);
+		SetSize(newSize);
 		return this;
 	}
 }
@@ -21,13 +21,15 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
+#include <cstddef>
+#include <new>
 #include <span>
-#include <vector>
 
 class C4ValueList
 {
 public:
 	enum { MaxSize = 1000000, }; // ye shalt not create arrays larger than that!
+	static constexpr std::int32_t InlineSize{4}; // lists up to this size do not allocate
 
 	C4ValueList() = default;
 	C4ValueList(std::int32_t size);
@@ -36,35 +38,48 @@ public:
 	template<typename T>
 	C4ValueList(const std::span<T> data)
 	{
-		values.reserve(data.size());
+		Reserve(static_cast<std::int32_t>(data.size()));
 
 		for (const auto value : data)
 		{
-			values.emplace_back(value);
+			new (values + size++) C4Value{value};
 		}
 	}
 
+	~C4ValueList();
+
 	C4ValueList &operator=(const C4ValueList &ValueList2);
 
 protected:
-	std::vector<C4Value> values;
+	C4Value *values{InlineValues()};
+	std::int32_t size{0};
+	std::int32_t capacity{InlineSize};
+	alignas(C4Value) std::byte inlineStorage[InlineSize * sizeof(C4Value)];
+
+	C4Value *InlineValues() { return reinterpret_cast<C4Value *>(inlineStorage); }
 
 public:
-	std::int32_t GetSize() const { return static_cast<std::int32_t>(values.size()); }
+	std::int32_t GetSize() const { return size; }
 
 	const C4Value &GetItem(const std::int32_t index) const { return Inside(index, 0, GetSize() - 1) ? values[index] : C4VNull; }
 	C4Value &GetItem(std::int32_t index);
+	std::span<const C4Value> GetItems() const { return {values, static_cast<std::size_t>(size)}; }
 
 	C4Value operator[](const std::int32_t index) const { return GetItem(index); }
 	C4Value &operator[](const std::int32_t index) { return GetItem(index); }
 
 	void Reset();
 	void SetSize(std::int32_t size); // (enlarge only!)
+	void Reserve(std::int32_t size); // make room for size values without changing the size
+
+	// Add values at the end without going through Set for every element, for engine functions building result lists
+	void Append(const C4Value &value);
+	void Append(std::span<const C4Value> newValues); // newValues may be part of this list
 
 	void DenumeratePointers();
 
 	// comparison
-	bool operator==(const C4ValueList &other) const = default;
+	bool operator==(const C4ValueList &other) const;
 
 	// Compilation
 	void CompileFunc(class StdCompiler *pComp);
@@ -86,7 +101,7 @@ public:
 	~C4ValueArray();
 
 	// Change length, return self or new copy if necessary
-	C4ValueArray *SetLength(std::int32_t size);
+	C4ValueArray *SetLength(std::int32_t newSize);
 	virtual bool hasIndex(const C4Value &index) const override;
 	virtual C4Value &operator[](const C4Value &index) override;
 	using C4ValueList::operator[];
@@ -27,7 +27,7 @@
 #include <C4FullScreen.h>
 #include <C4Application.h>
 #include <C4ObjectCom.h>
-#include <C4Stat.h>
+#include <C4Trace.h>
 #include <C4Gui.h>
 #include <C4Network2Dialogs.h>
 #include <C4GameDialogs.h>
@@ -838,20 +838,22 @@ void C4Viewport::DrawOverlay(C4FacetEx &cgo)
 	if (!Game.C4S.Head.Film || !Game.C4S.Head.Replay)
 	{
 		// Player info
-		C4ST_STARTNEW(CInfoStat, "C4Viewport::DrawOverlay: Cursor Info")
-		DrawCursorInfo(cgo);
-		C4ST_STOP(CInfoStat)
-		C4ST_STARTNEW(PInfoStat, "C4Viewport::DrawOverlay: Player Info")
-		DrawPlayerInfo(cgo);
-		C4ST_STOP(PInfoStat)
-		C4ST_STARTNEW(MenuStat, "C4Viewport::DrawOverlay: Menu")
+		{
+			C4TRACE_ZONE("C4Viewport::DrawOverlay: Cursor Info");
+			DrawCursorInfo(cgo);
+		}
+		{
+			C4TRACE_ZONE("C4Viewport::DrawOverlay: Player Info");
+			DrawPlayerInfo(cgo);
+		}
+		C4TRACE_ZONE("C4Viewport::DrawOverlay: Menu");
 		DrawMenu(cgo);
-		C4ST_STOP(MenuStat)
 	}
 	// Game messages
-	C4ST_STARTNEW(MsgStat, "C4Viewport::DrawOverlay: Messages")
-	Game.Messages.Draw(cgo, Player);
-	C4ST_STOP(MsgStat)
+	{
+		C4TRACE_ZONE("C4Viewport::DrawOverlay: Messages");
+		Game.Messages.Draw(cgo, Player);
+	}
 
 	// Control overlays (if not film/replay)
 	if (!Game.C4S.Head.Film || !Game.C4S.Head.Replay)
@@ -859,13 +861,12 @@ void C4Viewport::DrawOverlay(C4FacetEx &cgo)
 		// Mouse control
 		if (Game.MouseControl.IsViewport(this))
 		{
-			C4ST_STARTNEW(MouseStat, "C4Viewport::DrawOverlay: Mouse")
+			C4TRACE_ZONE("C4Viewport::DrawOverlay: Mouse");
 			if (Config.Graphics.ShowCommands) // Now, ShowCommands is respected even for mouse control...
 				DrawMouseButtons(cgo);
 			Game.MouseControl.Draw(cgo);
 			// Draw GUI-mouse in EM if active
 			if (pWindow && Game.pGUI) Game.pGUI->RenderMouse(cgo);
-			C4ST_STOP(MouseStat)
 		}
 		// Keyboard/Gamepad
 		else
@@ -900,21 +901,19 @@ void C4Viewport::DrawCursorInfo(C4FacetEx &cgo)
 	if (Config.Graphics.ShowPlayerHUDAlways)
 		if (cursor->Info)
 		{
-			C4ST_STARTNEW(ObjInfStat, "C4Viewport::DrawCursorInfo: Object info")
+			C4TRACE_ZONE("C4Viewport::DrawCursorInfo: Object info");
 			ccgo.Set(cgo.Surface, cgo.X + C4SymbolBorder, cgo.Y + C4SymbolBorder, 3 * C4SymbolSize, C4SymbolSize);
 			cursor->Info->Draw(ccgo,
 				Config.Graphics.ShowPortraits,
 				(cursor == Game.Players.Get(Player)->Captain), cursor);
-			C4ST_STOP(ObjInfStat)
 		}
 
 	// Draw contents
 	if (!(cursor->Def->HideHUDElements & C4DefCore::HH_Inventory))
 	{
-		C4ST_STARTNEW(ContStat, "C4Viewport::DrawCursorInfo: Contents")
+		C4TRACE_ZONE("C4Viewport::DrawCursorInfo: Contents");
 		ccgo.Set(cgo.Surface, cgo.X + C4SymbolBorder, cgo.Y + cgo.Hgt - C4SymbolBorder - C4SymbolSize, 7 * C4SymbolSize, C4SymbolSize);
 		cursor->Contents.DrawIDList(ccgo, -1, Game.Defs, C4D_All, SetRegions, COM_Contents, false);
-		C4ST_STOP(ContStat)
 	}
 
 	// Draw energy levels
@@ -922,7 +921,7 @@ void C4Viewport::DrawCursorInfo(C4FacetEx &cgo)
 		if (cgo.Hgt > 2 * C4SymbolSize + 2 * C4SymbolBorder)
 		{
 			int32_t cx = C4SymbolBorder;
-			C4ST_STARTNEW(EnStat, "C4Viewport::DrawCursorInfo: Energy")
+			C4TRACE_ZONE("C4Viewport::DrawCursorInfo: Energy");
 			int32_t bar_wdt = Game.GraphicsResource.fctEnergyBars.Wdt;
 			int32_t iYOff = Config.Graphics.ShowPortraits ? 10 : 0;
 			// Energy
@@ -941,7 +940,6 @@ void C4Viewport::DrawCursorInfo(C4FacetEx &cgo)
 			{
 				cursor->DrawBreath(ccgo); ccgo.X += bar_wdt + 1;
 			}
-			C4ST_STOP(EnStat)
 		}
 
 	// Draw commands
@@ -949,7 +947,7 @@ void C4Viewport::DrawCursorInfo(C4FacetEx &cgo)
 		if (realCursor)
 			if (cgo.Hgt > C4SymbolSize)
 			{
-				C4ST_STARTNEW(CmdStat, "C4Viewport::DrawCursorInfo: Commands")
+				C4TRACE_ZONE("C4Viewport::DrawCursorInfo: Commands");
 				int32_t iSize = 2 * C4SymbolSize / 3;
 				int32_t iSize2 = 2 * iSize;
 				// Primary area (bottom)
@@ -958,7 +956,6 @@ void C4Viewport::DrawCursorInfo(C4FacetEx &cgo)
 				ccgo2.Set(cgo.Surface, cgo.X + cgo.Wdt - iSize2, cgo.Y, iSize2, cgo.Hgt - iSize - 5);
 				// Draw commands
 				realCursor->DrawCommands(ccgo, ccgo2, SetRegions);
-				C4ST_STOP(CmdStat)
 			}
 }
 
@@ -1053,30 +1050,35 @@ void C4Viewport::Draw(C4FacetEx &cgo, bool fDrawOverlay)
 	else
 		lpDDraw->SetClrModMapEnabled(false);
 
-	C4ST_STARTNEW(SkyStat, "C4Viewport::Draw: Sky")
-	Game.Landscape.Sky.Draw(cgo);
-	C4ST_STOP(SkyStat)
+	{
+		C4TRACE_ZONE("C4Viewport::Draw: Sky");
+		Game.Landscape.Sky.Draw(cgo);
+	}
 	Game.BackObjects.DrawAll(cgo, Player);
 
 	// Draw Landscape
-	C4ST_STARTNEW(LandStat, "C4Viewport::Draw: Landscape")
-	Game.Landscape.Draw(cgo, Player);
-	C4ST_STOP(LandStat)
+	{
+		C4TRACE_ZONE("C4Viewport::Draw: Landscape");
+		Game.Landscape.Draw(cgo, Player);
+	}
 
 	// draw PXS (unclipped!)
-	C4ST_STARTNEW(PXSStat, "C4Viewport::Draw: PXS")
-	Game.PXS.Draw(cgo);
-	C4ST_STOP(PXSStat)
+	{
+		C4TRACE_ZONE("C4Viewport::Draw: PXS");
+		Game.PXS.Draw(cgo);
+	}
 
 	// draw objects
-	C4ST_STARTNEW(ObjStat, "C4Viewport::Draw: Objects")
-	Game.Objects.Draw(cgo, Player);
-	C4ST_STOP(ObjStat)
+	{
+		C4TRACE_ZONE("C4Viewport::Draw: Objects");
+		Game.Objects.Draw(cgo, Player, &Game.Objects.StaticLayer);
+	}
 
 	// draw global particles
-	C4ST_STARTNEW(PartStat, "C4Viewport::Draw: Particles")
-	Game.Particles.GlobalParticles.Draw(cgo, nullptr);
-	C4ST_STOP(PartStat)
+	{
+		C4TRACE_ZONE("C4Viewport::Draw: Particles");
+		Game.Particles.GlobalParticles.Draw(cgo, nullptr);
+	}
 
 	// draw foreground objects
 	Game.ForeObjects.DrawIfCategory(cgo, Player, C4D_Parallax, true);
@@ -1102,17 +1104,16 @@ void C4Viewport::Draw(C4FacetEx &cgo, bool fDrawOverlay)
 	Game.ForeObjects.DrawIfCategory(cgo, Player, C4D_Parallax, false);
 
 	// Draw overlay
-	C4ST_STARTNEW(OvrStat, "C4Viewport::Draw: Overlay")
-
-	if (!Application.isFullScreen) Console.EditCursor.Draw(cgo);
-
-	if (fDrawOverlay) DrawOverlay(cgo);
+	{
+		C4TRACE_ZONE("C4Viewport::Draw: Overlay");
+		if (!Application.isFullScreen) Console.EditCursor.Draw(cgo);
 
-	// Netstats
-	if (Game.GraphicsSystem.ShowNetstatus)
-		Game.Network.DrawStatus(cgo);
+		if (fDrawOverlay) DrawOverlay(cgo);
 
-	C4ST_STOP(OvrStat)
+		// Netstats
+		if (Game.GraphicsSystem.ShowNetstatus)
+			Game.Network.DrawStatus(cgo);
+	}
 
 	// Remove clippers
 	if (fDrawOverlay) Application.DDraw->NoPrimaryClipper();
@@ -20,6 +20,21 @@ StdBitmap::StdBitmap(const std::uint32_t width, const std::uint32_t height, cons
 	: width(width), height(height), useAlpha(useAlpha),
 	bytes(new uint8_t[width * height * (useAlpha ? 4 : 3)]) {}
 
+std::uint32_t StdBitmap::GetWidth() const
+{
+	return width;
+}
+
+std::uint32_t StdBitmap::GetHeight() const
+{
+	return height;
+}
+
+bool StdBitmap::UsesAlpha() const
+{
+	return useAlpha;
+}
+
 const void *StdBitmap::GetBytes() const
 {
 	return bytes.get();
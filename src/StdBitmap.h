@@ -25,6 +25,12 @@ public:
 	// Creates a B8G8R8 bitmap if useAlpha is false or an B8G8R8A8 bitmap otherwise.
 	StdBitmap(std::uint32_t width, std::uint32_t height, bool useAlpha);
 
+	// Returns the size of the bitmap.
+	std::uint32_t GetWidth() const;
+	std::uint32_t GetHeight() const;
+	// Returns whether the bitmap is in B8G8R8A8 format.
+	bool UsesAlpha() const;
+
 	// Returns a pointer to the bitmap bytes.
 	const void *GetBytes() const;
 	void *GetBytes();
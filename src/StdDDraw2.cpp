@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <limits.h>
 #include <cmath>
+#include <limits>
 #include <numbers>
 
 // Global access pointer
@@ -229,6 +230,118 @@ bool CPattern::PatternClr(int iX, int iY, uint8_t &byClr, uint32_t &dwClr, CStdP
 	return true;
 }
 
+void CStdDrawList::AddQuad(const State &state, const CBltData &rBltData)
+{
+	Quad quad;
+	float x1{std::numeric_limits<float>::max()}, y1{x1};
+	float x2{-x1}, y2{-x1};
+	for (std::size_t i = 0; i < rBltData.vtVtx.size(); ++i)
+	{
+		const CBltVertex &src = rBltData.vtVtx[i];
+		Vertex &vtx = quad.Vtx[i];
+		// apply vertex transformation
+		if (rBltData.pTransform)
+		{
+			const float *const mat = rBltData.pTransform->mat;
+			vtx.x = mat[0] * src.ftx + mat[1] * src.fty + mat[2];
+			vtx.y = mat[3] * src.ftx + mat[4] * src.fty + mat[5];
+			vtx.w = mat[6] * src.ftx + mat[7] * src.fty + mat[8];
+		}
+		else
+		{
+			vtx.x = src.ftx; vtx.y = src.fty; vtx.w = 1;
+		}
+		vtx.z = 0;
+		// apply texture mapping
+		const float *const tex = rBltData.TexPos.mat;
+		vtx.s = tex[0] * src.ftx + tex[1] * src.fty + tex[2];
+		vtx.t = tex[3] * src.ftx + tex[4] * src.fty + tex[5];
+		vtx.q = tex[6] * src.ftx + tex[7] * src.fty + tex[8];
+		vtx.r = 0;
+		vtx.Clr = {
+			static_cast<uint8_t>(src.dwModClr >> 16),
+			static_cast<uint8_t>(src.dwModClr >> 8),
+			static_cast<uint8_t>(src.dwModClr),
+			static_cast<uint8_t>(src.dwModClr >> 24)};
+		// update bounds; projections behind the viewer make the quad unbounded
+		if (vtx.w > 0)
+		{
+			x1 = std::min(x1, vtx.x / vtx.w); x2 = std::max(x2, vtx.x / vtx.w);
+			y1 = std::min(y1, vtx.y / vtx.w); y2 = std::max(y2, vtx.y / vtx.w);
+		}
+		else
+		{
+			x1 = y1 = -std::numeric_limits<float>::max();
+			x2 = y2 = std::numeric_limits<float>::max();
+		}
+	}
+	// find a batch of equal state the quad can join without being drawn
+	// before any overlapping quad it has been recorded after
+	std::size_t batch = Batches.size();
+	for (std::size_t i = Batches.size(), checked = 0; i > 0 && checked < MaxLookBack; --i, ++checked)
+	{
+		Batch &other = Batches[i - 1];
+		if (other.BatchState == state)
+		{
+			batch = i - 1;
+			break;
+		}
+		// touching bounds count as overlap
+		if (x1 <= other.X2 && other.X1 <= x2 && y1 <= other.Y2 && other.Y1 <= y2) break;
+	}
+	if (batch == Batches.size())
+	{
+		Batches.push_back({state, x1, y1, x2, y2, 0, 0});
+	}
+	else
+	{
+		Batch &target = Batches[batch];
+		target.X1 = std::min(target.X1, x1); target.Y1 = std::min(target.Y1, y1);
+		target.X2 = std::max(target.X2, x2); target.Y2 = std::max(target.Y2, y2);
+	}
+	++Batches[batch].Count;
+	quad.Batch = batch;
+	Quads.push_back(quad);
+	++FrameStats.Quads;
+}
+
+void CStdDrawList::Finish()
+{
+	// assign vertex ranges
+	std::size_t start = 0;
+	for (Batch &batch : Batches)
+	{
+		batch.Start = start;
+		start += batch.Count * VerticesPerQuad;
+	}
+	Vertices.resize(start);
+	// scatter quads in recording order; each quad becomes two triangles
+	std::vector<std::size_t> cursors(Batches.size());
+	for (std::size_t i = 0; i < Batches.size(); ++i) cursors[i] = Batches[i].Start;
+	for (const Quad &quad : Quads)
+	{
+		Vertex *const dst = &Vertices[cursors[quad.Batch]];
+		dst[0] = quad.Vtx[0]; dst[1] = quad.Vtx[1]; dst[2] = quad.Vtx[2];
+		dst[3] = quad.Vtx[2]; dst[4] = quad.Vtx[1]; dst[5] = quad.Vtx[3];
+		cursors[quad.Batch] += VerticesPerQuad;
+	}
+	FrameStats.Batches += Batches.size();
+	++FrameStats.Flushes;
+}
+
+void CStdDrawList::Clear()
+{
+	Quads.clear();
+	Batches.clear();
+	Vertices.clear();
+}
+
+void CStdDrawList::EndFrame()
+{
+	LastFrameStats = FrameStats;
+	FrameStats = {};
+}
+
 CGammaControl::~CGammaControl()
 {
 	delete[] red;
@@ -516,6 +629,7 @@ void CStdDDraw::Default()
 
 void CStdDDraw::Clear()
 {
+	DrawList.Clear();
 	DisableGamma();
 	Active = BlitModulated = fUseClrModMap = false;
 	dwBlitMode = 0;
@@ -640,6 +754,9 @@ bool CStdDDraw::Blit(C4Surface *sfcSource, float fx, float fy, float fwdt, float
 {
 	// safety
 	if (!sfcSource || !sfcTarget || !twdt || !thgt || !fwdt || !fhgt) return false;
+	// the textures of images still decoded by a C4SurfaceDecodeBatch are not filled yet
+	sfcSource->WaitForDecode();
+	if (sfcSource->pMainSfc) sfcSource->pMainSfc->WaitForDecode();
 	// emulated blit?
 	if (!sfcTarget->IsRenderTarget())
 		return Blit8(sfcSource, static_cast<int>(fx), static_cast<int>(fy), static_cast<int>(fwdt), static_cast<int>(fhgt), sfcTarget, static_cast<int>(tx), static_cast<int>(ty), static_cast<int>(twdt), static_cast<int>(thgt), fSrcColKey, pTransform);
@@ -681,6 +798,8 @@ bool CStdDDraw::Blit(C4Surface *sfcSource, float fx, float fy, float fwdt, float
 		}
 		return false;
 	}
+	// upload pending changes of streamed textures
+	if (pTexMgr) pTexMgr->UploadChanges();
 	// create blitting struct
 	CBltData BltData;
 	// pass down pTransform
@@ -699,7 +818,13 @@ bool CStdDDraw::Blit(C4Surface *sfcSource, float fx, float fy, float fwdt, float
 	float scaleX2 = scaleX * (iTexSize + texIndent * 2);
 	float scaleY2 = scaleY * (iTexSize + texIndent * 2);
 	// blit from all these textures
-	SetTexture();
+	// recorded blits set their states when the draw list is flushed
+	const bool fBatch{Config.Graphics.BatchBlits};
+	if (!fBatch)
+	{
+		FlushDrawList();
+		SetTexture();
+	}
 
 	int chunkSize = iTexSize;
 	if (fUseClrModMap)
@@ -766,7 +891,11 @@ bool CStdDDraw::Blit(C4Surface *sfcSource, float fx, float fy, float fwdt, float
 						pBaseTex = *(sfcSource->pMainSfc->ppTex + iY * sfcSource->iTexX + iX);
 					}
 					// base blit
-					PerformBlt(BltData, pBaseTex, BlitModulated ? BlitModulateClr : 0xffffff, !!(dwBlitMode & C4GFXBLIT_MOD2), fExact);
+					const uint32_t dwBaseModClr{BlitModulated ? BlitModulateClr : 0xffffff};
+					if (fBatch)
+						DrawList.AddQuad(GetBltState(BltData, pBaseTex, dwBaseModClr, !!(dwBlitMode & C4GFXBLIT_MOD2), fExact), BltData);
+					else
+						PerformBlt(BltData, pBaseTex, dwBaseModClr, !!(dwBlitMode & C4GFXBLIT_MOD2), fExact);
 					// overlay
 					if (fBaseSfc)
 					{
@@ -774,18 +903,75 @@ bool CStdDDraw::Blit(C4Surface *sfcSource, float fx, float fy, float fwdt, float
 						// apply global modulation to overlay surfaces only if desired
 						if (BlitModulated && !(dwBlitMode & C4GFXBLIT_CLRSFC_OWNCLR))
 							ModulateClr(dwModClr, BlitModulateClr);
-						PerformBlt(BltData, pTex, dwModClr, !!(dwBlitMode & C4GFXBLIT_CLRSFC_MOD2), fExact);
+						if (fBatch)
+							DrawList.AddQuad(GetBltState(BltData, pTex, dwModClr, !!(dwBlitMode & C4GFXBLIT_CLRSFC_MOD2), fExact), BltData);
+						else
+							PerformBlt(BltData, pTex, dwModClr, !!(dwBlitMode & C4GFXBLIT_CLRSFC_MOD2), fExact);
 					}
 				}
 			}
 		}
 	}
 	// reset texture
-	ResetTexture();
+	if (!fBatch) ResetTexture();
 	// success
 	return true;
 }
 
+CStdDrawList::State CStdDDraw::GetBltState(CBltData &rBltData, C4TexRef *pTex, uint32_t dwModClr, bool fMod2, bool fExact)
+{
+	CStdDrawList::State state;
+	state.pTex = pTex;
+	state.fAdditive = !!(dwBlitMode & C4GFXBLIT_ADDITIVE);
+	state.fModClr = false;
+	state.fAlphaMod = !!(dwModClr >> 24);
+	// global modulation map
+	bool fAnyModNotBlack;
+	if (fUseClrModMap && dwModClr)
+	{
+		fAnyModNotBlack = false;
+		for (auto &vertex : rBltData.vtVtx)
+		{
+			float x{vertex.ftx};
+			float y{vertex.fty};
+			if (rBltData.pTransform)
+			{
+				rBltData.pTransform->TransformPoint(x, y);
+			}
+			vertex.dwModClr = pClrModMap->GetModAt(static_cast<int>(x), static_cast<int>(y));
+			if (vertex.dwModClr >> 24) state.fAlphaMod = true;
+			ModulateClr(vertex.dwModClr, dwModClr);
+			if (vertex.dwModClr) fAnyModNotBlack = true;
+			if (vertex.dwModClr != 0xffffff) state.fModClr = true;
+		}
+	}
+	else
+	{
+		fAnyModNotBlack = !!dwModClr;
+		for (auto &vertex : rBltData.vtVtx)
+		{
+			vertex.dwModClr = dwModClr;
+		}
+		if (dwModClr != 0xffffff) state.fModClr = true;
+	}
+	// reset MOD2 for completely black modulations
+	state.fMod2 = fMod2 && fAnyModNotBlack;
+	state.fSmooth = fUseClrModMap && state.fModClr && !Config.Graphics.NoBoxFades;
+	state.fFilter = pApp->GetScale() != 1.f || (!fExact && !Config.Graphics.PointFiltering);
+	state.fPremultiplied = pTex->IsRenderTarget();
+	return state;
+}
+
+void CStdDDraw::FlushDrawList()
+{
+	if (DrawList.IsEmpty()) return;
+	// blits are only recorded by the gfx thread
+	if (!pApp || !pApp->IsMainThread()) return;
+	DrawList.Finish();
+	PerformDrawList(DrawList);
+	DrawList.Clear();
+}
+
 bool CStdDDraw::Blit8(C4Surface *sfcSource, int fx, int fy, int fwdt, int fhgt,
 	C4Surface *sfcTarget, int tx, int ty, int twdt, int thgt,
 	bool fSrcColKey, CBltTransform *pTransform)
@@ -943,6 +1129,7 @@ bool CStdDDraw::AttachPrimaryPalette(C4Surface *sfcSurface)
 
 bool CStdDDraw::BlitSurface(C4Surface *sfcSurface, C4Surface *sfcTarget, int tx, int ty, bool fBlitBase)
 {
+	if (sfcSurface) sfcSurface->WaitForDecode();
 	if (fBlitBase)
 	{
 		Blit(sfcSurface, 0.0f, 0.0f, static_cast<float>(sfcSurface->Wdt), static_cast<float>(sfcSurface->Hgt), sfcTarget, tx, ty, sfcSurface->Wdt, sfcSurface->Hgt, false);
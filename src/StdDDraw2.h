@@ -157,6 +157,76 @@ struct CBltData
 	CBltTransform *pTransform; // Vertex transformation
 };
 
+// recorded blits, grouped into batches of equal render state
+class CStdDrawList
+{
+public:
+	// render state of a blit; consecutive blits of equal state are drawn in one call
+	struct State
+	{
+		C4TexRef *pTex;
+		bool fAdditive; // additive blending
+		bool fMod2; // mod2-modulation
+		bool fModClr; // any vertex color differs from plain white
+		bool fAlphaMod; // modulation adds alpha
+		bool fSmooth; // vertex colors are interpolated
+		bool fFilter; // linear texture filtering
+		bool fPremultiplied; // texture colors are premultiplied by opacity (offscreen render targets)
+
+		bool operator==(const State &) const = default;
+	};
+
+	// fully transformed vertex; no matrices are needed to draw it
+	struct Vertex
+	{
+		float x, y, z, w; // homogeneous target position
+		float s, t, r, q; // homogeneous texture position
+		std::array<uint8_t, 4> Clr; // modulation color as RGBA
+	};
+
+	struct Batch
+	{
+		State BatchState;
+		float X1, Y1, X2, Y2; // target bounds of all quads
+		std::size_t Start; // first vertex; valid after Finish
+		std::size_t Count; // number of quads
+	};
+
+	struct Stats
+	{
+		std::size_t Quads{0};
+		std::size_t Batches{0};
+		std::size_t Flushes{0};
+	};
+
+	static constexpr std::size_t VerticesPerQuad{6}; // two triangles
+	static constexpr std::size_t MaxLookBack{16}; // number of batches a quad may be moved to the front
+
+private:
+	struct Quad
+	{
+		std::size_t Batch;
+		std::array<Vertex, 4> Vtx; // triangle strip order
+	};
+
+	std::vector<Quad> Quads;
+	std::vector<Batch> Batches;
+	std::vector<Vertex> Vertices;
+	Stats FrameStats, LastFrameStats;
+
+public:
+	void AddQuad(const State &state, const CBltData &rBltData);
+	void Finish(); // sort quads into batch order and fill vertex array
+	void Clear(); // drop recorded quads
+	void EndFrame(); // publish stats of current frame
+
+	bool IsEmpty() const { return Quads.empty(); }
+	std::vector<Batch> &GetBatches() { return Batches; }
+	std::vector<Vertex> &GetVertices() { return Vertices; }
+	const Stats &GetFrameStats() const { return FrameStats; }
+	const Stats &GetLastFrameStats() const { return LastFrameStats; }
+};
+
 // gamma ramp control
 class CGammaControl
 {
@@ -299,6 +369,7 @@ protected:
 	bool fUseClrModMap; // if set, pClrModMap will be checked for color modulations
 	float texIndent;
 	float blitOffset;
+	CStdDrawList DrawList; // blits waiting to be submitted
 
 public:
 	// General
@@ -333,6 +404,8 @@ public:
 	void SurfaceAllowColor(C4Surface *sfcSfc, uint32_t *pdwColors, int iNumColors, bool fAllowZero = false);
 	void Grayscale(C4Surface *sfcSfc, int32_t iOffset = 0);
 	virtual bool PrepareRendering(C4Surface *sfcToSurface) = 0; // check if/make rendering possible to given surface
+	virtual bool CanRenderOffscreen() { return false; } // whether offscreen surfaces can be render targets that look the same when blitted
+	virtual bool ClearRenderTarget(C4Surface *sfcTarget) { return false; } // clear offscreen render target to transparent
 
 	// Blit
 	virtual void BlitLandscape(C4Surface *sfcSource, C4Surface *sfcSource2, C4Surface *sfcLiquidAnimation, int fx, int fy,
@@ -346,6 +419,8 @@ public:
 		C4Surface *sfcTarget, float tx, float ty, float twdt, float thgt,
 		bool fSrcColKey = false, CBltTransform *pTransform = nullptr, bool noScalingCorrection = false);
 	virtual void PerformBlt(CBltData &rBltData, C4TexRef *pTex, uint32_t dwModClr, bool fMod2, bool fExact) = 0;
+	void FlushDrawList(); // submit all recorded blits
+	const CStdDrawList &GetDrawList() const { return DrawList; }
 	bool Blit8(C4Surface *sfcSource, int fx, int fy, int fwdt, int fhgt, // force 8bit-blit (inline)
 		C4Surface *sfcTarget, int tx, int ty, int twdt, int thgt,
 		bool fSrcColKey = false, CBltTransform *pTransform = nullptr);
@@ -416,6 +491,8 @@ public:
 protected:
 	bool StringOut(const char *szText, C4Surface *sfcDest, int iTx, int iTy, uint32_t dwFCol, uint8_t byForm, bool fDoMarkup, CMarkup &Markup, CStdFont *pFont, float fZoom);
 	virtual void DrawPixInt(C4Surface *sfcDest, float tx, float ty, uint32_t dwCol) = 0; // without ClrModMap
+	virtual void PerformDrawList(CStdDrawList &rDrawList) = 0; // draw all batches of a finished draw list
+	CStdDrawList::State GetBltState(CBltData &rBltData, C4TexRef *pTex, uint32_t dwModClr, bool fMod2, bool fExact); // calc vertex modulation and render state
 	bool CreatePrimaryClipper();
 	virtual bool CreatePrimarySurfaces() = 0;
 	virtual bool CreateDirectDraw() = 0;
@@ -488,6 +488,7 @@ void CStdFont::Init(const char *szFontName, C4Surface *psfcFontSfc, int iIndent)
 	for (int c = ' '; c < 256; ++c)
 	{
 		// save character pos
+		fctAsciiTexCoords[c - ' '].Surface = sfcCurrent;
 		fctAsciiTexCoords[c - ' '].X = iX; // left
 		fctAsciiTexCoords[c - ' '].Y = iY; // top
 		bool IsLB = false;
@@ -552,6 +553,8 @@ void CStdFont::Clear()
 	iNumFontSfcs = 0;
 	for (int c = ' '; c < 256; ++c) fctAsciiTexCoords[c - ' '].Default();
 	fctUnicodeMap.clear();
+	// cached layouts refer to the font surfaces
+	ClearTextCaches();
 	// set default values
 	dwDefFontHeight = iLineHgt = 10;
 	iFontZoom = 1; // default: no internal font zooming - likely no antialiasing either...
@@ -577,6 +580,18 @@ bool CStdFont::GetTextExtent(const char *szText, int32_t &rsx, int32_t &rsy, boo
 	}
 	// safety
 	if (!szText) return false;
+	// cached?
+	CacheKey.assign(szText);
+	CacheKey.push_back('\0');
+	CacheKey.push_back(static_cast<char>(fCheckMarkup));
+	CacheKey.push_back(static_cast<char>(ignoreScale));
+	if (const auto *pExtent = TextExtents.Get(CacheKey))
+	{
+		rsx = pExtent->first; rsy = pExtent->second;
+		return true;
+	}
+	// images may change, so texts containing them are not cached
+	bool fCacheable = true;
 	// keep track of each row's size
 	int lineStepHeight = static_cast<int>(std::ceil(iLineHgt / realScale));
 	float iRowWdt = 0, iWdt = 0;
@@ -600,6 +615,7 @@ bool CStdFont::GetTextExtent(const char *szText, int32_t &rsx, int32_t &rsy, boo
 		int iImgLgt;
 		if (fCheckMarkup && c == '{' && szText[0] == '{' && szText[1] != '{' && (iImgLgt = SCharPos('}', szText + 1)) > 0 && szText[iImgLgt + 2] == '}')
 		{
+			fCacheable = false;
 			char imgbuf[101];
 			SCopy(szText + 1, imgbuf, (std::min)(iImgLgt, 100));
 			C4Facet fct;
@@ -633,6 +649,7 @@ bool CStdFont::GetTextExtent(const char *szText, int32_t &rsx, int32_t &rsy, boo
 	}
 	// store output
 	rsx = static_cast<int>(iWdt); rsy = iHgt;
+	if (fCacheable) TextExtents.Insert(CacheKey, {rsx, rsy});
 	// done, success
 	return true;
 }
@@ -811,6 +828,52 @@ int CStdFont::BreakMessage(const char *szMsg, int iWdt, StdStrBuf *pOut, bool fC
 
 /* Text drawing */
 
+CStdFont::ShapedRun &CStdFont::GetShapedRun(const char *szText, uint32_t dwFlags, float fZoom)
+{
+	// cached?
+	CacheKey.assign(szText);
+	CacheKey.push_back('\0');
+	CacheKey.append(reinterpret_cast<const char *>(&dwFlags), sizeof(dwFlags));
+	CacheKey.append(reinterpret_cast<const char *>(&fZoom), sizeof(fZoom));
+	if (ShapedRun *pRun = ShapedRuns.Get(CacheKey)) return *pRun;
+	// GetTextExtent reuses the key buffer
+	const std::string key{CacheKey};
+	// lay out glyphs the way DrawText does for clean markup
+	ShapedRun Run;
+	float x = 0;
+	if (dwFlags & (STDFONT_CENTERED | STDFONT_RIGHTALGN))
+	{
+		int32_t sx, sy;
+		GetTextExtent(szText, sx, sy, !(dwFlags & STDFONT_NOMARKUP));
+		x -= fZoom * ((dwFlags & STDFONT_CENTERED) ? sx / 2 : sx);
+	}
+	fZoom /= scale;
+	fZoom /= iFontZoom;
+	CMarkup ShapeMarkup(false);
+	uint32_t c;
+	while (c = GetNextCharacter(&szText))
+	{
+		// ignore system characters
+		if (c < _T(' ')) continue;
+		if (~dwFlags & STDFONT_NOMARKUP)
+		{
+			// tags transform all following glyphs and images may be reloaded at any time: leave those to DrawText
+			if (c == '<')
+			{
+				if (ShapeMarkup.Read(&--szText)) { Run.fCacheable = false; break; }
+				++szText;
+			}
+			else if (c == '{' && szText[0] == '{') { Run.fCacheable = false; break; }
+		}
+		const C4Facet &fctGlyph = GetCharacterFacet(c);
+		const float w2 = fctGlyph.Wdt * fZoom;
+		Run.Glyphs.push_back({fctGlyph, x, w2, fctGlyph.Hgt * fZoom});
+		x += w2 + iHSpace;
+	}
+	if (!Run.fCacheable) Run.Glyphs = {};
+	return ShapedRuns.Insert(key, std::move(Run));
+}
+
 void CStdFont::DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, const char *szText, uint32_t dwFlags, CMarkup &Markup, float fZoom)
 {
 	float x = static_cast<float>(iX), y = static_cast<float>(iY);
@@ -820,6 +883,27 @@ void CStdFont::DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, co
 	uint32_t dwOldModClr;
 	bool fWasModulated = lpDDraw->GetBlitModulation(dwOldModClr);
 	if (fWasModulated) ModulateClr(dwColor, dwOldModClr);
+	// plain text without markup state: blit cached glyph quads
+	if (Markup.Clean())
+	{
+		const ShapedRun &Run = GetShapedRun(szText, dwFlags, fZoom);
+		if (Run.fCacheable)
+		{
+			lpDDraw->ActivateBlitModulation(dwColor);
+			for (const ShapedGlyph &Glyph : Run.Glyphs)
+			{
+				const C4Facet &fct = Glyph.fctSource;
+				lpDDraw->Blit(fct.Surface, float(fct.X), float(fct.Y), float(fct.Wdt), float(fct.Hgt),
+					sfcDest, x + Glyph.fX, y, Glyph.fWdt, Glyph.fHgt,
+					true, nullptr, true);
+			}
+			if (fWasModulated)
+				lpDDraw->ActivateBlitModulation(dwOldModClr);
+			else
+				lpDDraw->DeactivateBlitModulation();
+			return;
+		}
+	}
 	// get alpha fade percentage
 	uint32_t dwAlphaMod = BoundBy<int>(((static_cast<int>(dwColor >> 0x18) - 0x50) * 0xff) / 0xaf, 0, 255) << 0x18 | 0xffffff;
 	// adjust text starting position (horizontal only)
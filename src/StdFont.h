@@ -24,7 +24,12 @@
 #include "C4Strings.h"
 
 #include <cstdint>
+#include <list>
 #include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 // Font rendering flags
 #define STDFONT_CENTERED  0x0001
@@ -109,6 +114,67 @@ protected:
 	int iLineHgt; // height of one line of font (in pixels)
 	float scale = 1.f;
 
+	// LRU cache for text layouts, keyed by text and layout parameters
+	template<typename T> class TextCache
+	{
+	public:
+		static constexpr size_t MaxEntries = 1024;
+
+	private:
+		using Entry = std::pair<std::string, T>;
+		std::list<Entry> Entries; // most recently used first
+		std::unordered_map<std::string_view, typename std::list<Entry>::iterator> Index; // keys point into Entries
+
+	public:
+		TextCache() = default;
+		TextCache(const TextCache &) = delete;
+		TextCache &operator=(const TextCache &) = delete;
+
+		T *Get(std::string_view key)
+		{
+			const auto it = Index.find(key);
+			if (it == Index.end()) return nullptr;
+			Entries.splice(Entries.begin(), Entries, it->second);
+			return &it->second->second;
+		}
+
+		// key must not be present yet
+		T &Insert(std::string_view key, T &&value)
+		{
+			if (Entries.size() >= MaxEntries)
+			{
+				Index.erase(Entries.back().first);
+				Entries.pop_back();
+			}
+			Entries.emplace_front(std::string{key}, std::move(value));
+			Index.emplace(Entries.front().first, Entries.begin());
+			return Entries.front().second;
+		}
+
+		void Clear() { Index.clear(); Entries.clear(); }
+	};
+
+	// one glyph of a shaped run
+	struct ShapedGlyph
+	{
+		C4Facet fctSource; // glyph in font texture
+		float fX, fWdt, fHgt; // target position relative to text origin and size
+	};
+
+	// glyph quads of one line of text
+	struct ShapedRun
+	{
+		std::vector<ShapedGlyph> Glyphs;
+		bool fCacheable{true}; // false if the text contains markup tags or images that must be evaluated at draw time
+	};
+
+	TextCache<ShapedRun> ShapedRuns; // DrawText layouts
+	TextCache<std::pair<int32_t, int32_t>> TextExtents; // GetTextExtent results
+	std::string CacheKey; // reused lookup key buffer
+
+	ShapedRun &GetShapedRun(const char *szText, uint32_t dwFlags, float fZoom);
+	void ClearTextCaches() { ShapedRuns.Clear(); TextExtents.Clear(); }
+
 public:
 	// draw ine line of text
 	void DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, const char *szText, uint32_t dwFlags, CMarkup &Markup, float fZoom);
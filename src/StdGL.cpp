@@ -375,6 +375,9 @@ void CStdGL::PageFlip()
 	if (!pApp || !pApp->AssertMainThread()) return;
 	// safety
 	if (!pCurrCtx) return;
+	// submit pending blits
+	FlushDrawList();
+	DrawList.EndFrame();
 	// end the scene and present it
 	pCurrCtx->PageFlip();
 }
@@ -382,6 +385,7 @@ void CStdGL::PageFlip()
 void CStdGL::FillBG(const uint32_t dwClr)
 {
 	if (!pCurrCtx && !MainCtx.Select()) return;
+	FlushDrawList();
 	glClearColor(
 		GetBValue(dwClr) / 255.0f,
 		GetGValue(dwClr) / 255.0f,
@@ -392,12 +396,25 @@ void CStdGL::FillBG(const uint32_t dwClr)
 
 bool CStdGL::UpdateClipper()
 {
+	// pending blits use the previous viewport
+	FlushDrawList();
 	int iX, iY, iWdt, iHgt;
 	// no render target or clip all? do nothing
 	if (!CalculateClipper(&iX, &iY, &iWdt, &iHgt)) return true;
 	const auto scale = pApp->GetScale();
 	glLineWidth(scale);
 	glPointSize(scale);
+	// offscreen targets are unscaled textures, stored top row first
+	if (!RenderTarget->fPrimary)
+	{
+		glViewport(iX, iY, iWdt, iHgt);
+		glMatrixMode(GL_PROJECTION);
+		glLoadIdentity();
+		gluOrtho2D(
+			static_cast<GLdouble>(iX), static_cast<GLdouble>(iX + iWdt),
+			static_cast<GLdouble>(iY), static_cast<GLdouble>(iY + iHgt));
+		return true;
+	}
 	// set it
 	glViewport(static_cast<int32_t>(floorf(iX * scale)), static_cast<int32_t>(floorf((RenderTarget->Hgt - iY - iHgt) * scale)), static_cast<int32_t>(ceilf(iWdt * scale)), static_cast<int32_t>(ceilf(iHgt * scale)));
 	glMatrixMode(GL_PROJECTION);
@@ -425,8 +442,11 @@ bool CStdGL::PrepareRendering(C4Surface *const sfcToSurface)
 	{
 		// target is a render-target?
 		if (!sfcToSurface->IsRenderTarget()) return false;
+		// pending blits go to the previous target
+		FlushDrawList();
 		// set target
 		RenderTarget = sfcToSurface;
+		glBindFramebuffer(GL_FRAMEBUFFER, sfcToSurface->fPrimary ? 0 : (*sfcToSurface->ppTex)->fboName);
 		// new target has different size; needs other clipping rect
 		UpdateClipper();
 	}
@@ -434,46 +454,34 @@ bool CStdGL::PrepareRendering(C4Surface *const sfcToSurface)
 	return true;
 }
 
-void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
-	const uint32_t dwModClr, bool fMod2, const bool fExact)
+bool CStdGL::CanRenderOffscreen()
+{
+	// shader gamma and scaling are applied per blit and would be applied twice
+	return (GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object) && !GammaRedTexture && pApp->GetScale() == 1.f;
+}
+
+bool CStdGL::ClearRenderTarget(C4Surface *const sfcTarget)
+{
+	if (sfcTarget->fPrimary || !PrepareRendering(sfcTarget)) return false;
+	FlushDrawList();
+	// alpha is inverted: fully transparent, premultiplied black
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+	return true;
+}
+
+uint32_t CStdGL::GetBltModMask(const CStdDrawList::State &state) const
+{
+	// plain texture modulation takes alpha from the texture only
+	if (BlitShader || !state.fModClr || state.fMod2 || (state.fAlphaMod && !Config.Graphics.NoAlphaAdd)) return 0;
+	return 0xff000000;
+}
+
+void CStdGL::SelectBltState(const CStdDrawList::State &state)
 {
-	// global modulation map
-	uint32_t dwModMask = 0;
-	bool fAnyModNotBlack;
-	bool fModClr = false;
-	if (fUseClrModMap && dwModClr)
-	{
-		fAnyModNotBlack = false;
-		for (auto &vertex : rBltData.vtVtx)
-		{
-			float x{vertex.ftx};
-			float y{vertex.fty};
-			if (rBltData.pTransform)
-			{
-				rBltData.pTransform->TransformPoint(x, y);
-			}
-			vertex.dwModClr = pClrModMap->GetModAt(static_cast<int>(x), static_cast<int>(y));
-			if (vertex.dwModClr >> 24) dwModMask = 0xff000000;
-			ModulateClr(vertex.dwModClr, dwModClr);
-			if (vertex.dwModClr) fAnyModNotBlack = true;
-			if (vertex.dwModClr != 0xffffff) fModClr = true;
-		}
-	}
-	else
-	{
-		fAnyModNotBlack = !!dwModClr;
-		for (auto &vertex : rBltData.vtVtx)
-		{
-			vertex.dwModClr = dwModClr;
-		}
-		if (dwModClr != 0xffffff) fModClr = true;
-	}
-	// reset MOD2 for completely black modulations
-	if (fMod2 && !fAnyModNotBlack) fMod2 = 0;
 	if (BlitShader)
 	{
-		dwModMask = 0;
-		if (fMod2 && BlitShaderMod2)
+		if (state.fMod2 && BlitShaderMod2)
 		{
 			BlitShaderMod2.Select();
 		}
@@ -481,17 +489,15 @@ void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
 		{
 			BlitShader.Select();
 		}
-
-		if (!fModClr) glColor4f(1.0f, 1.0f, 1.0f, 0.0f);
 	}
 	// modulated blit
-	else if (fModClr)
+	else if (state.fModClr)
 	{
-		if (fMod2 || ((dwModClr >> 24 || dwModMask) && !Config.Graphics.NoAlphaAdd))
+		if (state.fMod2 || (state.fAlphaMod && !Config.Graphics.NoAlphaAdd))
 		{
 			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-			glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB,      fMod2 ? GL_ADD_SIGNED : GL_MODULATE);
-			glTexEnvf(GL_TEXTURE_ENV, GL_RGB_SCALE,        fMod2 ? 2.0f : 1.0f);
+			glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB,      state.fMod2 ? GL_ADD_SIGNED : GL_MODULATE);
+			glTexEnvf(GL_TEXTURE_ENV, GL_RGB_SCALE,        state.fMod2 ? 2.0f : 1.0f);
 			glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_ALPHA,    GL_ADD);
 			glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB,      GL_TEXTURE);
 			glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB,      GL_PRIMARY_COLOR);
@@ -501,13 +507,11 @@ void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
 			glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_RGB,     GL_SRC_COLOR);
 			glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_ALPHA,   GL_SRC_ALPHA);
 			glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_ALPHA,   GL_SRC_ALPHA);
-			dwModMask = 0;
 		}
 		else
 		{
 			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 			glTexEnvf(GL_TEXTURE_ENV, GL_RGB_SCALE,        1.0f);
-			dwModMask = 0xff000000;
 		}
 	}
 	else
@@ -516,15 +520,39 @@ void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
 		glTexEnvf(GL_TEXTURE_ENV, GL_RGB_SCALE, 1.0f);
 	}
 	// set texture+modes
-	glShadeModel((fUseClrModMap && fModClr && !Config.Graphics.NoBoxFades) ? GL_SMOOTH : GL_FLAT);
-	glBindTexture(GL_TEXTURE_2D, pTex->texName);
+	const GLenum srcFactor{state.fPremultiplied ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA};
+	const GLenum dstFactor{state.fAdditive ? GL_ONE : GL_SRC_ALPHA};
+	if (RenderTarget && !RenderTarget->fPrimary)
+		// offscreen targets keep their transparency for compositing: it multiplies instead of blending like color
+		glBlendFuncSeparate(srcFactor, dstFactor, GL_ZERO, GL_SRC_ALPHA);
+	else
+		glBlendFunc(srcFactor, dstFactor);
+	glShadeModel(state.fSmooth ? GL_SMOOTH : GL_FLAT);
+	glBindTexture(GL_TEXTURE_2D, state.pTex->texName);
 
-	const auto enableTextureFiltering = (pApp->GetScale() != 1.f || (!fExact && !Config.Graphics.PointFiltering));
-	if (enableTextureFiltering)
+	if (state.fFilter)
 	{
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	}
+}
+
+void CStdGL::ResetBltState(const CStdDrawList::State &state)
+{
+	if (state.fFilter)
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	}
+}
+
+void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
+	const uint32_t dwModClr, const bool fMod2, const bool fExact)
+{
+	const CStdDrawList::State state{GetBltState(rBltData, pTex, dwModClr, fMod2, fExact)};
+	const uint32_t dwModMask{GetBltModMask(state)};
+	SelectBltState(state);
+	if (BlitShader && !state.fModClr) glColor4f(1.0f, 1.0f, 1.0f, 0.0f);
 
 	glMatrixMode(GL_TEXTURE);
 	float matrix[16];
@@ -552,7 +580,7 @@ void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
 	glBegin(GL_TRIANGLE_STRIP);
 	for (const auto vertex : rBltData.vtVtx)
 	{
-		if (fModClr) glColorDw(vertex.dwModClr | dwModMask);
+		if (state.fModClr) glColorDw(vertex.dwModClr | dwModMask);
 		glTexCoord2f(vertex.ftx, vertex.fty);
 		glVertex2f(vertex.ftx, vertex.fty);
 	}
@@ -563,11 +591,58 @@ void CStdGL::PerformBlt(CBltData &rBltData, C4TexRef *const pTex,
 		CStdShaderProgram::Deselect();
 	}
 
-	if (enableTextureFiltering)
+	ResetBltState(state);
+}
+
+void CStdGL::PerformDrawList(CStdDrawList &rDrawList)
+{
+	if (!pCurrCtx && !MainCtx.Select()) return;
+	auto &vertices = rDrawList.GetVertices();
+	const auto &batches = rDrawList.GetBatches();
+	// vertex positions and texture coordinates are final
+	glMatrixMode(GL_TEXTURE);
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+	// apply modulation masks before the vertices are uploaded
+	for (const auto &batch : batches)
 	{
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		if (GetBltModMask(batch.BatchState))
+		{
+			for (std::size_t i = 0; i < batch.Count * CStdDrawList::VerticesPerQuad; ++i)
+			{
+				vertices[batch.Start + i].Clr[3] = 0xff;
+			}
+		}
+	}
+	// upload vertices
+	if (!DrawListBuffer) glGenBuffers(1, &DrawListBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, DrawListBuffer);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(CStdDrawList::Vertex), vertices.data(), GL_STREAM_DRAW);
+	constexpr auto stride = static_cast<GLsizei>(sizeof(CStdDrawList::Vertex));
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(4, GL_FLOAT, stride, reinterpret_cast<const void *>(offsetof(CStdDrawList::Vertex, x)));
+	glTexCoordPointer(4, GL_FLOAT, stride, reinterpret_cast<const void *>(offsetof(CStdDrawList::Vertex, s)));
+	glColorPointer(4, GL_UNSIGNED_BYTE, stride, reinterpret_cast<const void *>(offsetof(CStdDrawList::Vertex, Clr)));
+	glEnable(GL_TEXTURE_2D);
+	// draw batches
+	for (const auto &batch : batches)
+	{
+		SelectBltState(batch.BatchState);
+		glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.Start), static_cast<GLsizei>(batch.Count * CStdDrawList::VerticesPerQuad));
+		ResetBltState(batch.BatchState);
 	}
+	if (BlitShader)
+	{
+		CStdShaderProgram::Deselect();
+	}
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glDisable(GL_TEXTURE_2D);
 }
 
 void CStdGL::BlitLandscape(C4Surface *const sfcSource, C4Surface *const sfcSource2,
@@ -577,6 +652,10 @@ void CStdGL::BlitLandscape(C4Surface *const sfcSource, C4Surface *const sfcSourc
 	// safety
 	if (!sfcSource || !sfcTarget || !wdt || !hgt) return;
 	assert(sfcTarget->IsRenderTarget());
+	// the textures of images still decoded by a C4SurfaceDecodeBatch are not filled yet
+	sfcSource->WaitForDecode();
+	if (sfcSource2) sfcSource2->WaitForDecode();
+	if (sfcLiquidAnimation) sfcLiquidAnimation->WaitForDecode();
 	assert(!(dwBlitMode & C4GFXBLIT_MOD2));
 	// bound
 	if (ClipAll) return;
@@ -586,6 +665,9 @@ void CStdGL::BlitLandscape(C4Surface *const sfcSource, C4Surface *const sfcSourc
 	if (!PrepareRendering(sfcTarget)) return;
 	// texture present?
 	if (!sfcSource->ppTex) return;
+	// upload pending landscape changes
+	if (pTexMgr) pTexMgr->UploadChanges();
+	FlushDrawList();
 	// blit with basesfc?
 	// get involved texture offsets
 	int iTexSize = sfcSource->iTexSize;
@@ -837,6 +919,7 @@ void CStdGL::DrawQuadDw(C4Surface *const sfcTarget, int *const ipVtx,
 {
 	// prepare rendering to target
 	if (!PrepareRendering(sfcTarget)) return;
+	FlushDrawList();
 
 	CStdGLShaderProgram::Deselect();
 
@@ -887,6 +970,7 @@ void CStdGL::DrawLineDw(C4Surface *const sfcTarget,
 	assert(sfcTarget->IsRenderTarget());
 	// prepare rendering to target
 	if (!PrepareRendering(sfcTarget)) return;
+	FlushDrawList();
 
 	CStdGLShaderProgram::Deselect();
 
@@ -927,6 +1011,7 @@ void CStdGL::DrawPixInt(C4Surface *const sfcTarget,
 	assert(sfcTarget->IsRenderTarget());
 
 	if (!PrepareRendering(sfcTarget)) return;
+	FlushDrawList();
 
 	CStdGLShaderProgram::Deselect();
 
@@ -972,6 +1057,8 @@ bool CStdGL::ApplyGammaRamp(CGammaControl &ramp, bool force)
 
 	else if (GammaRedTexture)
 	{
+		// pending blits use the previous ramp
+		FlushDrawList();
 		glActiveTexture(GL_TEXTURE3);
 		GammaRedTexture.UpdateData(ramp.red);
 		glActiveTexture(GL_TEXTURE4);
@@ -1265,6 +1352,8 @@ bool CStdGL::RestoreDeviceObjects()
 
 bool CStdGL::InvalidateDeviceObjects()
 {
+	// submit pending blits while textures are still valid
+	FlushDrawList();
 	// clear gamma
 #ifdef USE_SDL_MAINLOOP
 	if (GammaRedTexture)
@@ -1283,6 +1372,12 @@ bool CStdGL::InvalidateDeviceObjects()
 		DummyShader.Clear();
 	}
 
+	if (DrawListBuffer)
+	{
+		glDeleteBuffers(1, &DrawListBuffer);
+		DrawListBuffer = GL_NONE;
+	}
+
 	if (GammaRedTexture)
 	{
 		GammaRedTexture.Clear();
@@ -266,6 +266,7 @@ protected:
 	CStdGLShaderProgram BlitShaderMod2;
 	CStdGLShaderProgram LandscapeShader;
 	CStdGLShaderProgram DummyShader;
+	GLuint DrawListBuffer{GL_NONE}; // vertex buffer for draw list submission
 	CStdGLTexture<GL_TEXTURE_1D, 1> GammaRedTexture;
 	CStdGLTexture<GL_TEXTURE_1D, 1> GammaGreenTexture;
 	CStdGLTexture<GL_TEXTURE_1D, 1> GammaBlueTexture;
@@ -284,6 +285,8 @@ public:
 
 	// Surface
 	bool PrepareRendering(C4Surface *sfcToSurface) override; // check if/make rendering possible to given surface
+	bool CanRenderOffscreen() override;
+	bool ClearRenderTarget(C4Surface *sfcTarget) override;
 	CStdGLCtx &GetMainCtx() { return MainCtx; }
 	virtual CStdGLCtx *CreateContext(CStdWindow *pWindow, CStdApp *pApp) override;
 #ifdef _WIN32
@@ -292,6 +295,7 @@ public:
 
 	// Blit
 	void PerformBlt(CBltData &rBltData, C4TexRef *pTex, uint32_t dwModClr, bool fMod2, bool fExact) override;
+	void PerformDrawList(CStdDrawList &rDrawList) override;
 	virtual void BlitLandscape(C4Surface *sfcSource, C4Surface *sfcSource2, C4Surface *sfcLiquidAnimation, int fx, int fy,
 		C4Surface *sfcTarget, int tx, int ty, int wdt, int hgt) override;
 	void FillBG(uint32_t dwClr = 0) override;
@@ -330,6 +334,9 @@ protected:
 #endif
 
 private:
+	uint32_t GetBltModMask(const CStdDrawList::State &state) const; // alpha mask to apply to vertex colors
+	void SelectBltState(const CStdDrawList::State &state); // select shader, texture and modes of a blit
+	void ResetBltState(const CStdDrawList::State &state);
 	bool ApplyGammaRampToMonitor(CGammaControl &ramp, bool force);
 	bool SaveDefaultGammaRampToMonitor(CStdWindow *window);
 
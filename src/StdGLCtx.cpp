@@ -37,6 +37,7 @@ void CStdGLCtx::Deselect(bool secondary)
 {
 	if (pGL && pGL->pCurrCtx == this)
 	{
+		pGL->FlushDrawList();
 		DoDeselect();
 		pGL->pCurrCtx = nullptr;
 	}
@@ -151,6 +152,8 @@ bool CStdGLCtx::Select(bool verbose, bool selectOnly)
 {
 	// safety
 	if (!pGL || !hrc) return false; if (!pGL->lpPrimary) return false;
+	// pending blits belong to the previous context
+	if (pGL->pCurrCtx != this) pGL->FlushDrawList();
 	// make context current
 	if (!wglMakeCurrent(hDC, hrc)) return false;
 
@@ -302,6 +305,8 @@ bool CStdGLCtx::Select(bool verbose, bool selectOnly)
 		if (verbose) pGL->logger->error("lpPrimary is zero");
 		return false;
 	}
+	// pending blits belong to the previous context
+	if (pGL->pCurrCtx != this) pGL->FlushDrawList();
 	// make context current
 	if (!pWindow->renderwnd || !glXMakeCurrent(pWindow->dpy, pWindow->renderwnd, ctx))
 	{
@@ -469,6 +474,8 @@ bool CStdGLCtx::Init(CStdWindow *pWindow, CStdApp *)
 
 bool CStdGLCtx::Select(bool verbose, bool selectOnly)
 {
+	// pending blits belong to the previous context
+	if (pGL->pCurrCtx != this) pGL->FlushDrawList();
 	SDL_GL_MakeCurrent(this->pWindow->sdlWindow, ctx);
 	if (!selectOnly)
 	{
@@ -28,7 +28,7 @@ public:
 	virtual bool CreateDirectDraw() override;
 
 public:
-	void PageFlip() override {}
+	void PageFlip() override { FlushDrawList(); DrawList.EndFrame(); }
 	virtual int GetEngine() override { return GFXENGN_NOGFX; }
 	std::string_view GetEngineName() const override { return "CStdNoGfx"; }
 	virtual bool UpdateClipper() override { return true; }
@@ -36,6 +36,7 @@ public:
 	virtual bool PrepareRendering(C4Surface *) override { return true; }
 	virtual void FillBG(uint32_t dwClr = 0) override {}
 	virtual void PerformBlt(CBltData &, C4TexRef *, uint32_t, bool, bool) override {}
+	virtual void PerformDrawList(CStdDrawList &) override {} // recorded batches are only counted
 	virtual void DrawLineDw(C4Surface *, float, float, float, float, uint32_t) override {}
 	virtual void DrawQuadDw(C4Surface *, int *, uint32_t, uint32_t, uint32_t, uint32_t) override {}
 	virtual void DrawPixInt(C4Surface *, float, float, uint32_t) override {}
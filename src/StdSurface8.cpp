@@ -26,6 +26,7 @@
 #include <CStdFile.h>
 #include <Bitmap256.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "limits.h"
@@ -34,7 +35,8 @@ CSurface8::CSurface8()
 {
 	Wdt = Hgt = Pitch = 0;
 	ClipX = ClipY = ClipX2 = ClipY2 = 0;
-	Bits = nullptr;
+	Bits = Buffer = nullptr;
+	Guard = 0;
 	pPal = nullptr;
 }
 
@@ -42,7 +44,8 @@ CSurface8::CSurface8(int iWdt, int iHgt)
 {
 	Wdt = Hgt = Pitch = 0;
 	ClipX = ClipY = ClipX2 = ClipY2 = 0;
-	Bits = nullptr;
+	Bits = Buffer = nullptr;
+	Guard = 0;
 	pPal = nullptr;
 	Create(iWdt, iHgt);
 }
@@ -55,7 +58,8 @@ CSurface8::~CSurface8()
 void CSurface8::Clear()
 {
 	// clear bitmap-copy
-	delete[] Bits; Bits = nullptr;
+	delete[] Buffer; Bits = Buffer = nullptr;
+	Guard = 0;
 	// clear pal
 	if (HasOwnPal()) delete pPal;
 	pPal = nullptr;
@@ -103,13 +107,41 @@ bool CSurface8::Create(int iWdt, int iHgt, bool fOwnPal)
 	else
 		pPal = &lpDDraw->Pal;
 
-	Bits = new uint8_t[Wdt * Hgt]{};
+	Bits = Buffer = new uint8_t[Wdt * Hgt]{};
 	Pitch = Wdt;
 	// update clipping
 	NoClip();
 	return true;
 }
 
+bool CSurface8::SetGuard(int iGuard)
+{
+	if (!Bits || iGuard < 0) return false;
+	// copy the pixels into a buffer with the border around them
+	const int iNewPitch = Wdt + 2 * iGuard;
+	uint8_t *const pNewBuffer = new uint8_t[iNewPitch * (Hgt + 2 * iGuard)]{};
+	uint8_t *const pNewBits = pNewBuffer + iGuard * iNewPitch + iGuard;
+	for (int y = 0; y < Hgt; ++y)
+		std::copy_n(Bits + y * Pitch, Wdt, pNewBits + y * iNewPitch);
+	delete[] Buffer;
+	Buffer = pNewBuffer;
+	Bits = pNewBits;
+	Pitch = iNewPitch;
+	Guard = iGuard;
+	return true;
+}
+
+bool CSurface8::CreateCopy(const CSurface8 &rSrc)
+{
+	if (!rSrc.Bits || !Create(rSrc.Wdt, rSrc.Hgt)) return false;
+	// own pal, so the copy stays valid if the source changes
+	pPal = new CStdPalette;
+	memcpy(pPal, rSrc.pPal, sizeof(CStdPalette));
+	for (int y = 0; y < Hgt; ++y)
+		std::copy_n(rSrc.Bits + y * rSrc.Pitch, Wdt, Bits + y * Pitch);
+	return true;
+}
+
 bool CSurface8::Read(C4Group &hGroup, bool fOwnPal)
 {
 	int cnt, lcnt, iLineRest;
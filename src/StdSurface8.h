@@ -33,7 +33,9 @@ public:
 public:
 	int Wdt, Hgt, Pitch; // size of surface
 	int ClipX, ClipY, ClipX2, ClipY2;
-	uint8_t *Bits;
+	uint8_t *Bits; // pixel (0, 0)
+	uint8_t *Buffer; // allocation holding the pixels and the guard border
+	int Guard; // width of the border around the surface that can be read without bounds checks
 	CStdPalette *pPal; // pal for this surface (usually points to the main pal)
 	bool HasOwnPal(); // return whether the surface palette is owned
 	void HLine(int iX, int iX2, int iY, int iCol);
@@ -62,6 +64,8 @@ public:
 	}
 
 	bool Create(int iWdt, int iHgt, bool fOwnPal = false);
+	bool SetGuard(int iGuard); // reallocate with a border of iGuard pixels on each side; keeps the contents
+	bool CreateCopy(const CSurface8 &rSrc); // create with own copies of the pixels and palette of rSrc
 	void Clear();
 	void Clip(int iX, int iY, int iX2, int iY2);
 	void NoClip();
@@ -0,0 +1,37 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Engine globals for tests, which are otherwise defined next to the entry point */
+
+#include <C4Include.h>
+#include <C4Application.h>
+
+#include <C4Console.h>
+#include <C4FullScreen.h>
+
+C4Application Application;
+C4Console Console;
+C4FullScreen FullScreen;
+C4Game Game;
+C4Config Config;
+
+namespace
+{
+	// loggers created by engine classes write to the sinks of the opened log
+	const struct LogOpener
+	{
+		LogOpener() { Application.LogSystem.OpenLog(); }
+	} logOpener;
+}
@@ -0,0 +1,206 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Aul.h>
+#include <C4Config.h>
+#include <C4Def.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// byte code chunk with pointers replaced by what they point to
+	struct Chunk
+	{
+		C4AulBCCType Type;
+		std::string X;
+		std::ptrdiff_t SPos;
+
+		bool operator==(const Chunk &) const = default;
+	};
+
+	class TestScript : public C4AulScript
+	{
+	public:
+		TestScript(C4AulScriptEngine &engine, const std::string &name, const std::string &script)
+		{
+			ScriptName = name;
+			Script.Copy(script.c_str());
+			Reg2List(&engine, &engine);
+			REQUIRE(Preparse());
+		}
+
+		std::vector<Chunk> GetCode() const
+		{
+			std::vector<Chunk> code;
+			for (int i = 0; i < CodeSize; ++i)
+			{
+				const C4AulBCC &bcc{Code[i]};
+				Chunk &chunk{code.emplace_back(bcc.bccType, std::to_string(bcc.bccX), bcc.SPos ? bcc.SPos - Script.getData() : -1)};
+				switch (bcc.bccType)
+				{
+				case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+					if (const auto *const func = reinterpret_cast<const C4AulFunc *>(bcc.bccX))
+					{
+						chunk.X = func->Owner->ScriptName + "::" + func->Name;
+					}
+					break;
+				case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+					if (const auto *const string = reinterpret_cast<const C4String *>(bcc.bccX))
+					{
+						chunk.X = string->Data.getData();
+					}
+					break;
+				default:
+					break;
+				}
+			}
+			return code;
+		}
+
+		std::vector<std::string> GetVarNames()
+		{
+			std::vector<std::string> names;
+			for (int i = 0; C4AulScriptFunc *const func{GetSFunc(i)}; ++i)
+			{
+				names.emplace_back(func->Name);
+				for (int j = 0; j < func->VarNamed.iSize; ++j)
+				{
+					names.emplace_back(func->VarNamed.pNames[j]);
+				}
+			}
+			return names;
+		}
+
+		// restored code is allocated at its exact size, while parsed code grows in steps
+		bool IsExactlySized() const { return CodeBufSize == CodeSize; }
+	};
+
+	class TestEngine : public C4AulScriptEngine
+	{
+	public:
+		TestEngine()
+		{
+			Scripts.push_back(new TestScript{*this, "First",
+				"#strict 3\n"
+				"global func Helper(int value) { return value + 1; }\n"
+				"func Own(int value) { var doubled = value * 2; return doubled; }\n"
+				"func Main(object obj)\n"
+				"{\n"
+				"	var text = \"hello\";\n"
+				"	var map = [];\n"
+				"	map.foo = text;\n"
+				"	var sum = map.foo + map[\"bar\"];\n"
+				"	obj->Own(1);\n"
+				"	obj->~Own(2);\n"
+				"	global->Helper(sum);\n"
+				"	return Own(sum) + Helper(3);\n"
+				"}\n"});
+			Scripts.push_back(new TestScript{*this, "Second",
+				"#strict 2\n"
+				"func Initialize() { var other = \"world\"; return Helper(Own()); }\n"
+				"func Own() { return \"own\"; }\n"});
+		}
+
+		// the steps of Link that parse byte code
+		void ParseScripts()
+		{
+			C4DefList defs;
+			ResolveIncludes(&defs);
+			ParseDescs();
+			BytecodeCache.Begin(*this);
+			Parse();
+			BytecodeCache.End();
+		}
+
+		std::vector<TestScript *> Scripts;
+	};
+
+	// keeps the byte code cache in a directory of its own while the test runs
+	class CacheDirectory
+	{
+	public:
+		CacheDirectory() : Path{std::filesystem::temp_directory_path() / "LegacyClonkBytecodeCacheTest"}
+		{
+			std::filesystem::remove_all(Path);
+			std::filesystem::create_directories(Path);
+			SCopy(Path.string().c_str(), Config.General.UserPath, CFG_MaxString);
+			Config.Developer.ScriptBytecodeCache = true;
+		}
+
+		~CacheDirectory()
+		{
+			Config.Developer.ScriptBytecodeCache = false;
+			std::error_code error;
+			std::filesystem::remove_all(Path, error);
+		}
+
+		CacheDirectory(const CacheDirectory &) = delete;
+		CacheDirectory &operator=(const CacheDirectory &) = delete;
+
+		std::size_t GetEntryCount() const
+		{
+			const std::filesystem::path directory{Path / "ScriptCache"};
+			if (!std::filesystem::exists(directory)) return 0;
+			return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator{directory}, std::filesystem::directory_iterator{}));
+		}
+
+	private:
+		std::filesystem::path Path;
+	};
+}
+
+TEST_CASE("Restored byte code matches the parsed one", "[C4AulBytecodeCache]")
+{
+	CacheDirectory cache;
+
+	TestEngine parsed;
+	parsed.ParseScripts();
+	REQUIRE(parsed.errCnt == 0);
+	REQUIRE(cache.GetEntryCount() == parsed.Scripts.size());
+
+	// the same sources in a new engine, as on the next start
+	TestEngine restored;
+	restored.ParseScripts();
+	REQUIRE(restored.errCnt == 0);
+
+	for (std::size_t i = 0; i < parsed.Scripts.size(); ++i)
+	{
+		TestScript &original{*parsed.Scripts[i]};
+		TestScript &copy{*restored.Scripts[i]};
+		REQUIRE_FALSE(original.IsExactlySized());
+		CHECK(copy.IsExactlySized());
+
+		const std::vector<Chunk> code{original.GetCode()};
+		REQUIRE_FALSE(code.empty());
+		CHECK(copy.GetCode() == code);
+		CHECK(copy.GetVarNames() == original.GetVarNames());
+	}
+}
+
+TEST_CASE("Byte code is not cached unless enabled", "[C4AulBytecodeCache]")
+{
+	CacheDirectory cache;
+	Config.Developer.ScriptBytecodeCache = false;
+
+	TestEngine engine;
+	engine.ParseScripts();
+	CHECK(cache.GetEntryCount() == 0);
+}
@@ -0,0 +1,125 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Aul.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	// preparsed script with direct access to its functions
+	class TestScript : public C4AulScript
+	{
+	public:
+		TestScript(C4AulScriptEngine &engine, const std::string &name, const std::string &script)
+		{
+			ScriptName = name;
+			Script.Copy(script.c_str());
+			Reg2List(&engine, &engine);
+			REQUIRE(Preparse());
+			for (int i = 0; C4AulScriptFunc *const func{GetSFunc(i)}; ++i)
+			{
+				Funcs.push_back(func);
+			}
+		}
+
+		void ResetRings()
+		{
+			for (C4AulFunc *const func : Funcs)
+			{
+				func->NextSNFunc = nullptr;
+			}
+		}
+
+	private:
+		std::vector<C4AulFunc *> Funcs;
+	};
+
+	// scripts sharing the callback names of typical definitions, each with functions of its own
+	std::vector<TestScript *> AddScripts(C4AulScriptEngine &engine, const int count)
+	{
+		static constexpr const char *Callbacks[]{"Initialize", "Timer", "Damage", "Incineration", "Collection", "Hit", "Activate", "ContextMenu", "RejectEntrance", "Destruction"};
+		std::vector<TestScript *> scripts;
+		for (int i = 0; i < count; ++i)
+		{
+			std::string script{"#strict 2\n"};
+			for (const char *const callback : Callbacks)
+			{
+				script += std::string{"func "} + callback + "() { return " + std::to_string(i) + "; }\n";
+			}
+			for (int j = 0; j < 10; ++j)
+			{
+				script += "func Own" + std::to_string(i) + "_" + std::to_string(j) + "() { return 0; }\n";
+			}
+			scripts.push_back(new TestScript{engine, "Script" + std::to_string(i), script});
+		}
+		return scripts;
+	}
+
+	std::vector<C4AulFunc *> Ring(C4AulFunc *const start)
+	{
+		std::vector<C4AulFunc *> ring;
+		C4AulFunc *func{start};
+		do
+		{
+			ring.push_back(func);
+			func = func->NextSNFunc;
+		}
+		while (func && func != start && ring.size() <= 1000);
+		return ring;
+	}
+}
+
+TEST_CASE("Same-named functions are linked into one ring", "[C4AulLink]")
+{
+	C4AulScriptEngine engine;
+	const std::vector<TestScript *> scripts{AddScripts(engine, 4)};
+	engine.LinkSameNameFuncs();
+
+	// started by the first script, followed by the others in reverse order
+	C4AulFunc *const start{scripts[0]->GetSFunc("Timer")};
+	REQUIRE(start);
+	const std::vector<C4AulFunc *> expected{start, scripts[3]->GetSFunc("Timer"), scripts[2]->GetSFunc("Timer"), scripts[1]->GetSFunc("Timer")};
+	CHECK(Ring(start) == expected);
+
+	// functions of a single script link to themselves
+	C4AulFunc *const own{scripts[2]->GetSFunc("Own2_5")};
+	REQUIRE(own);
+	CHECK(own->NextSNFunc == own);
+}
+
+TEST_CASE("Same-named function linking performance", "[C4AulLink][benchmark]")
+{
+	// as many scripts as a large definition pack
+	C4AulScriptEngine engine;
+	const std::vector<TestScript *> scripts{AddScripts(engine, 5000)};
+
+	BENCHMARK_ADVANCED("Link 5000 scripts")(Catch::Benchmark::Chronometer meter)
+	{
+		meter.measure([&]
+		{
+			for (TestScript *const script : scripts)
+			{
+				script->ResetRings();
+			}
+			engine.LinkSameNameFuncs();
+		});
+	};
+}
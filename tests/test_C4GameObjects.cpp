@@ -0,0 +1,164 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Game.h>
+#include <C4Object.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace
+{
+	// objects of several definitions in the main object list, without definition data or scripts
+	class ObjectWorld
+	{
+	public:
+		static constexpr C4ID CommonID{C4Id("COMN")};
+		static constexpr C4ID RareID{C4Id("RARE")};
+
+		ObjectWorld(const int commonCount, const int rareCount)
+		{
+			Game.Objects.Init(1000, 1000);
+			Common = AddDef(CommonID, C4D_Object);
+			// static objects are sorted behind all others
+			Rare = AddDef(RareID, C4D_StaticBack);
+			for (int i = 0; i < commonCount; ++i)
+			{
+				AddObject(Common, i);
+			}
+			for (int i = 0; i < rareCount; ++i)
+			{
+				Rares.push_back(AddObject(Rare, i));
+			}
+		}
+
+		~ObjectWorld()
+		{
+			Game.Objects.Clear();
+			Game.Defs.Clear();
+		}
+
+		ObjectWorld(const ObjectWorld &) = delete;
+		ObjectWorld &operator=(const ObjectWorld &) = delete;
+
+		C4Def *Common;
+		C4Def *Rare;
+		std::vector<C4Object *> Rares;
+
+	private:
+		static C4Def *AddDef(const C4ID id, const int32_t category)
+		{
+			auto *const def = new C4Def;
+			def->id = id;
+			def->Category = category;
+			REQUIRE(Game.Defs.Add(def, false));
+			return def;
+		}
+
+		static C4Object *AddObject(C4Def *const def, const int index)
+		{
+			auto *const obj = new C4Object;
+			obj->Def = def;
+			obj->id = def->id;
+			obj->Category = def->Category;
+			obj->OCF = OCF_Normal;
+			obj->x = index % 1000;
+			obj->y = index / 1000;
+			def->AddInstance(obj);
+			REQUIRE(Game.Objects.Add(obj));
+			return obj;
+		}
+	};
+
+	// what FindObject did before objects were indexed by definition
+	C4Object *ScanMainList(const C4ID id)
+	{
+		for (C4Object *const obj : Game.Objects)
+		{
+			if (obj->Status && obj->Def->id == id) return obj;
+		}
+		return nullptr;
+	}
+}
+
+TEST_CASE("Indexed object queries match a scan of the main list", "[C4GameObjects]")
+{
+	ObjectWorld world{500, 10};
+	REQUIRE(world.Rares.size() == 10);
+
+	CHECK(Game.FindObject(ObjectWorld::RareID) == ScanMainList(ObjectWorld::RareID));
+	CHECK(Game.FindObject(ObjectWorld::CommonID) == ScanMainList(ObjectWorld::CommonID));
+	CHECK(Game.ObjectCount(ObjectWorld::RareID) == 10);
+	CHECK(Game.ObjectCount(ObjectWorld::CommonID) == 500);
+
+	// results stay in list order after the first match is gone
+	C4Object *const first{Game.FindObject(ObjectWorld::RareID)};
+	Game.Objects.Remove(first);
+	world.Rare->RemoveInstance(first);
+	CHECK(Game.FindObject(ObjectWorld::RareID) == ScanMainList(ObjectWorld::RareID));
+	CHECK(Game.ObjectCount(ObjectWorld::RareID) == 9);
+	delete first;
+}
+
+TEST_CASE("Instance lists follow the main list order", "[C4GameObjects]")
+{
+	ObjectWorld world{0, 10};
+
+	// reordering renumbers the whole list
+	C4Object *const last{world.Rares.back()};
+	REQUIRE(Game.Objects.OrderObjectBefore(last, world.Rares.front()));
+	CHECK(Game.FindObject(ObjectWorld::RareID) == last);
+	CHECK(Game.FindObject(ObjectWorld::RareID) == ScanMainList(ObjectWorld::RareID));
+
+	// objects added again are numbered between their neighbours
+	Game.Objects.Remove(last);
+	CHECK(Game.FindObject(ObjectWorld::RareID) == world.Rares.front());
+	REQUIRE(Game.Objects.Add(last));
+	CHECK(Game.FindObject(ObjectWorld::RareID) == ScanMainList(ObjectWorld::RareID));
+	CHECK(Game.ObjectCount(ObjectWorld::RareID) == 10);
+}
+
+TEST_CASE("Object query performance", "[C4GameObjects][benchmark]")
+{
+	ObjectWorld world{5000, 10};
+
+	BENCHMARK("Scan main list for rare definition")
+	{
+		return ScanMainList(ObjectWorld::RareID);
+	};
+
+	BENCHMARK("FindObject of rare definition")
+	{
+		return Game.FindObject(ObjectWorld::RareID);
+	};
+
+	BENCHMARK("FindObject of common definition")
+	{
+		return Game.FindObject(ObjectWorld::CommonID);
+	};
+
+	BENCHMARK("ObjectCount of rare definition")
+	{
+		return Game.ObjectCount(ObjectWorld::RareID);
+	};
+
+	BENCHMARK("ObjectCount of common definition")
+	{
+		return Game.ObjectCount(ObjectWorld::CommonID);
+	};
+}
@@ -0,0 +1,242 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Components.h>
+#include <C4Group.h>
+#include <C4Landscape.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace
+{
+	// landscape of random material runs without any material definitions
+	class TestLandscape : public C4Landscape
+	{
+	public:
+		TestLandscape(const int32_t width, const int32_t height)
+		{
+			Width = width;
+			Height = height;
+			Surface8 = new CSurface8{width, height};
+			// four materials; none is valid, so pixels are not counted
+			for (int32_t i = 0; i < 256; ++i)
+			{
+				Pix2Mat[i] = i % 4;
+				Pix2Dens[i] = 0;
+			}
+		}
+
+		void Fill(std::mt19937 &random)
+		{
+			std::uniform_int_distribution<int32_t> runLength{1, 80};
+			for (int32_t x = 0; x < Width; ++x)
+			{
+				for (int32_t y = 0; y < Height; )
+				{
+					const auto pix = RandomPix(random);
+					for (int32_t i = runLength(random); i > 0 && y < Height; --i)
+					{
+						Surface8->SetPix(x, y++, pix);
+					}
+				}
+			}
+		}
+
+		void CopyFrom(const TestLandscape &other)
+		{
+			for (int32_t y = 0; y < Height; ++y)
+			{
+				std::memcpy(Surface8->Bits + y * Surface8->Pitch, other.Surface8->Bits + y * other.Surface8->Pitch, Width);
+			}
+		}
+
+		bool operator==(const TestLandscape &other) const
+		{
+			for (int32_t y = 0; y < Height; ++y)
+			{
+				if (std::memcmp(Surface8->Bits + y * Surface8->Pitch, other.Surface8->Bits + y * other.Surface8->Pitch, Width)) return false;
+			}
+			return true;
+		}
+
+		// as done by InitMatRuns if any material has a MinHeightCount
+		void InitRuns()
+		{
+			MatRunBreaksPitch = Height / 64 + 1;
+			MatRunBreaks = new uint64_t[Width * MatRunBreaksPitch]{};
+			UpdateMatRuns(C4Rect{0, 0, Width, Height});
+		}
+
+		// changes the 8 bit surface only, as _SetPix does before updating the run breaks
+		void SetPixAndBreaks(const int32_t x, const int32_t y, const uint8_t pix)
+		{
+			const int32_t oldMat{_GetMat(x, y)};
+			Surface8->SetPix(x, y, pix);
+			if (oldMat != _GetMat(x, y)) UpdateMatRunBreaks(x, y);
+		}
+
+		void FillRectAndRuns(const C4Rect &rect, const uint8_t pix)
+		{
+			for (int32_t y = rect.y; y < rect.y + rect.Hgt; ++y)
+			{
+				for (int32_t x = rect.x; x < rect.x + rect.Wdt; ++x)
+				{
+					Surface8->SetPix(x, y, pix);
+				}
+			}
+			UpdateMatRuns(rect);
+		}
+
+		void CheckColumn(const int32_t x, std::mt19937 &random)
+		{
+			std::uniform_int_distribution<int32_t> max{1, 2 * Height};
+			for (int32_t y = -1; y <= Height; ++y)
+			{
+				const int32_t mat{y >= 0 && y < Height ? _GetMat(x, y) : 0};
+				for (const int32_t dir : {-1, +1})
+				{
+					// the rows next to the landscape are queried for the pixels at its border, away from it
+					if ((y < 0 && dir > 0) || (y >= Height && dir < 0)) continue;
+					const int32_t limit{max(random)};
+					INFO("x " << x << ", y " << y << ", direction " << dir << ", max " << limit);
+					CHECK(GetMatRunHeight(x, y, dir, mat, limit) == GetMatHeight(x, y, dir, mat, limit));
+				}
+			}
+		}
+
+		static uint8_t RandomPix(std::mt19937 &random)
+		{
+			// 0xff marks unchanged pixels in landscape diffs; setting sky would count materials, which there are none of
+			return static_cast<uint8_t>(std::uniform_int_distribution<int>{1, 0xfe}(random));
+		}
+	};
+
+	// keeps the group of a test in a file of its own
+	class TempGroup
+	{
+	public:
+		TempGroup() : Path{(std::filesystem::temp_directory_path() / "LegacyClonkLandscapeTest.c4s").string()}
+		{
+			std::filesystem::remove_all(Path);
+		}
+
+		~TempGroup()
+		{
+			Group.Close();
+			std::error_code error;
+			std::filesystem::remove_all(Path, error);
+		}
+
+		TempGroup(const TempGroup &) = delete;
+		TempGroup &operator=(const TempGroup &) = delete;
+
+		std::string Path;
+		C4Group Group;
+	};
+}
+
+TEST_CASE("Material run heights match the scanned heights", "[C4Landscape]")
+{
+	std::mt19937 random{4711};
+	// heights ending on, before and after a word of run breaks
+	for (const int32_t height : {1, 63, 64, 65, 128, 200})
+	{
+		TestLandscape landscape{40, height};
+		landscape.Fill(random);
+		landscape.InitRuns();
+
+		std::uniform_int_distribution<int32_t> column{0, landscape.Width - 1};
+		std::uniform_int_distribution<int32_t> row{0, height - 1};
+		for (int i = 0; i < 10; ++i)
+		{
+			landscape.CheckColumn(column(random), random);
+		}
+
+		// single pixels, as set by SetPix
+		for (int i = 0; i < 200; ++i)
+		{
+			landscape.SetPixAndBreaks(column(random), row(random), TestLandscape::RandomPix(random));
+		}
+		for (int i = 0; i < 10; ++i)
+		{
+			landscape.CheckColumn(column(random), random);
+		}
+
+		// rectangles, as changed by map drawing
+		for (int i = 0; i < 20; ++i)
+		{
+			const int32_t x{column(random)}, y{row(random)};
+			const C4Rect rect{x, y, std::min(std::uniform_int_distribution<int32_t>{1, 10}(random), landscape.Width - x), std::min(std::uniform_int_distribution<int32_t>{1, 70}(random), height - y)};
+			landscape.FillRectAndRuns(rect, TestLandscape::RandomPix(random));
+		}
+		for (int32_t x = 0; x < landscape.Width; ++x)
+		{
+			landscape.CheckColumn(x, random);
+		}
+	}
+}
+
+TEST_CASE("Landscape diffs restore the saved landscape", "[C4Landscape]")
+{
+	std::mt19937 random{815};
+	// tiles at the right and bottom border are cut off
+	TestLandscape saved{200, 150};
+	saved.Fill(random);
+	REQUIRE(saved.SaveInitial());
+
+	TestLandscape restored{200, 150}, initial{200, 150};
+	restored.CopyFrom(saved);
+	initial.CopyFrom(saved);
+
+	// changes in some tiles only
+	std::uniform_int_distribution<int32_t> column{0, 99}, row{0, 149};
+	for (int i = 0; i < 300; ++i)
+	{
+		REQUIRE(saved.SetPix(column(random), row(random), TestLandscape::RandomPix(random)));
+	}
+	REQUIRE_FALSE(saved == initial);
+
+	// sync saves contain all tiles
+	const bool syncSave{GENERATE(false, true)};
+
+	TempGroup temp;
+	REQUIRE(temp.Group.Open(temp.Path.c_str(), true));
+	REQUIRE(saved.SaveDiff(temp.Group, syncSave));
+	REQUIRE(temp.Group.Close());
+	REQUIRE(temp.Group.Open(temp.Path.c_str()));
+
+	SECTION("Complete diff")
+	{
+		REQUIRE(restored.ApplyDiff(temp.Group));
+		CHECK(restored == saved);
+	}
+
+	SECTION("Truncated diff")
+	{
+		StdBuf buf;
+		REQUIRE(temp.Group.LoadEntry(C4CFN_DiffLandscapeTiles, buf));
+		buf.Shrink(2);
+
+		// the last tile is corrupt, so none is applied
+		CHECK_FALSE(restored.ApplyDiffTiles(buf));
+		CHECK(restored == initial);
+	}
+}
@@ -0,0 +1,145 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Game.h>
+#include <C4PathFinder.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Point = C4PathFinderGraph::Point;
+
+	// C4PF_Graph_MaxStep: the height a walker steps up without jumping
+	constexpr int32_t MaxStep{2};
+
+	// floor with a low step and a plateau behind a sheer wall, higher than walkers step but in reach of jump links
+	class TestLandscape
+	{
+	public:
+		static constexpr int32_t Width{320}, Height{160};
+
+		TestLandscape()
+		{
+			Game.Landscape.Width = Width;
+			Game.Landscape.Height = Height;
+		}
+
+		~TestLandscape()
+		{
+			Game.Landscape.Width = 0;
+			Game.Landscape.Height = 0;
+		}
+
+		TestLandscape(const TestLandscape &) = delete;
+		TestLandscape &operator=(const TestLandscape &) = delete;
+
+		static bool PointFree(const int32_t x, const int32_t y)
+		{
+			if (x < 0 || y < 0 || x >= Width || y >= Height) return false;
+			if (x >= 200) return y < 100;
+			if (x >= 60) return y < 138;
+			return y < 140;
+		}
+	};
+
+	struct Path
+	{
+		bool Found{false};
+		std::vector<Point> Points; // from start to target
+
+		double GetLength() const
+		{
+			double length{0};
+			for (std::size_t i{1}; i < Points.size(); ++i)
+			{
+				length += std::hypot(Points[i].X - Points[i - 1].X, Points[i].Y - Points[i - 1].Y);
+			}
+			return length;
+		}
+
+		bool operator==(const Path &other) const
+		{
+			return Found == other.Found && std::equal(Points.begin(), Points.end(), other.Points.begin(), other.Points.end(),
+				[](const Point &a, const Point &b) { return a.X == b.X && a.Y == b.Y; });
+		}
+	};
+
+	bool AddWaypoint(const int32_t x, const int32_t y, intptr_t, const intptr_t path)
+	{
+		reinterpret_cast<Path *>(path)->Points.push_back({x, y});
+		return true;
+	}
+
+	Path FindPath(const bool graph, const Point from, const Point to)
+	{
+		C4PathFinder pathFinder;
+		pathFinder.Init(&TestLandscape::PointFree);
+		pathFinder.EnableGraph(graph);
+
+		Path path;
+		path.Points.push_back(to);
+		path.Found = pathFinder.Find(from.X, from.Y, to.X, to.Y, &AddWaypoint, reinterpret_cast<intptr_t>(&path));
+		// waypoints are set from target to start
+		path.Points.push_back(from);
+		std::reverse(path.Points.begin(), path.Points.end());
+		return path;
+	}
+}
+
+TEST_CASE("Graph paths agree with traced paths", "[C4PathFinder]")
+{
+	TestLandscape landscape;
+
+	const auto [name, from, to, byGraph] = GENERATE(table<std::string, Point, Point, bool>({
+		{"Walk over a step", {20, 130}, {180, 130}, true},
+		{"Drop from the plateau", {260, 90}, {40, 130}, true},
+		// jumping up the wall depends on the walker, so the ray tracer has to find a way
+		{"Climb onto the plateau", {40, 130}, {260, 90}, false}
+	}));
+	INFO(name);
+
+	C4PathFinderGraph graph;
+	graph.Init(&TestLandscape::PointFree);
+	std::vector<C4PathFinderGraph::Waypoint> waypoints;
+	CHECK(graph.Find(from.X, from.Y, to.X, to.Y, nullptr, 1, waypoints) == byGraph);
+
+	const Path traced{FindPath(false, from, to)};
+	REQUIRE(traced.Found);
+	const Path found{FindPath(true, from, to)};
+	REQUIRE(found.Found);
+
+	if (!byGraph)
+	{
+		CHECK(found == traced);
+		return;
+	}
+
+	// walkers only rise by stepping from column to column
+	for (std::size_t i{1}; i < found.Points.size(); ++i)
+	{
+		const Point &a{found.Points[i - 1]}, &b{found.Points[i]};
+		INFO("from " << a.X << "/" << a.Y << " to " << b.X << "/" << b.Y);
+		CHECK(a.Y - b.Y <= MaxStep * std::max(std::abs(b.X - a.X), 1));
+	}
+	CHECK(found.GetLength() <= traced.GetLength());
+}
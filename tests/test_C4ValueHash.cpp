@@ -0,0 +1,284 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4ValueHash.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	constexpr C4ValueInt EntryCount{10000};
+
+	void Fill(C4ValueHash &map)
+	{
+		for (C4ValueInt i{0}; i < EntryCount; ++i)
+		{
+			map[C4VInt(i)] = C4VInt(2 * i);
+		}
+	}
+
+	// the layout C4ValueHash had before its entries were stored densely:
+	// individually allocated values in an unordered map and a separate list for the key order
+	class ListOrderedHash
+	{
+	public:
+		C4Value &operator[](const C4Value &key)
+		{
+			try
+			{
+				return *map.at(key).value;
+			}
+			catch (const std::out_of_range &)
+			{
+				const auto inserted = map.emplace(key, Entry{std::make_unique<C4Value>(), {}}).first;
+				inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
+				return *inserted->second.value;
+			}
+		}
+
+		const C4Value &operator[](const C4Value &key) const
+		{
+			try
+			{
+				return *map.at(key).value;
+			}
+			catch (const std::out_of_range &)
+			{
+				return C4VNull;
+			}
+		}
+
+		// removing by value scanned the whole map, which is not done here
+		void erase(const C4Value &key)
+		{
+			const auto it = map.find(key);
+			keyOrder.erase(it->second.keyOrderIterator);
+			map.erase(it);
+		}
+
+		template<typename Func>
+		void ForEach(Func func)
+		{
+			for (const C4Value *const key : keyOrder)
+			{
+				func(*key, *map.at(*key).value);
+			}
+		}
+
+		std::size_t size() const { return map.size(); }
+
+	private:
+		struct Entry
+		{
+			std::unique_ptr<C4Value> value;
+			std::list<const C4Value *>::iterator keyOrderIterator;
+		};
+
+		struct KeyEqual
+		{
+			bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		};
+
+		std::unordered_map<C4Value, Entry, std::hash<C4Value>, KeyEqual> map;
+		std::list<const C4Value *> keyOrder;
+	};
+}
+
+TEST_CASE("Entries keep their insertion order", "[C4ValueHash]")
+{
+	C4ValueHash map;
+	for (C4ValueInt i{EntryCount}; i > 0; --i)
+	{
+		map[C4VInt(i)] = C4VInt(-i);
+	}
+	// removed entries stay in place until the map grows
+	for (C4ValueInt i{1}; i <= EntryCount; i += 3)
+	{
+		map[C4VInt(i)].Set0();
+	}
+	for (C4ValueInt i{EntryCount + 1}; i <= EntryCount + 100; ++i)
+	{
+		map[C4VInt(i)] = C4VInt(-i);
+	}
+
+	std::vector<C4ValueInt> keys;
+	for (auto &[key, value] : map)
+	{
+		CHECK(value._getInt() == -key._getInt());
+		keys.push_back(key._getInt());
+	}
+
+	std::vector<C4ValueInt> expected;
+	for (C4ValueInt i{EntryCount}; i > 0; --i)
+	{
+		if ((i - 1) % 3) expected.push_back(i);
+	}
+	for (C4ValueInt i{EntryCount + 1}; i <= EntryCount + 100; ++i)
+	{
+		expected.push_back(i);
+	}
+	CHECK(keys == expected);
+	CHECK(map.size() == expected.size());
+	CHECK(!map.contains(C4VInt(1)));
+	CHECK(map.contains(C4VInt(2)));
+}
+
+TEST_CASE("C4ValueHash performance", "[C4ValueHash][benchmark]")
+{
+	std::vector<C4Value> names;
+	for (C4ValueInt i{0}; i < EntryCount; ++i)
+	{
+		names.push_back(C4VString(("Key" + std::to_string(i)).c_str()));
+	}
+
+	BENCHMARK("Insert integer keys")
+	{
+		C4ValueHash map;
+		Fill(map);
+		return map.size();
+	};
+
+	C4ValueHash map;
+	Fill(map);
+	const C4ValueHash &constMap{map};
+
+	BENCHMARK("Look up integer keys")
+	{
+		C4ValueInt sum{0};
+		for (C4ValueInt i{0}; i < EntryCount; ++i)
+		{
+			sum += constMap[C4VInt(i)]._getInt();
+		}
+		return sum;
+	};
+
+	BENCHMARK("Iterate")
+	{
+		C4ValueInt sum{0};
+		for (auto &[key, value] : map)
+		{
+			sum += value._getInt();
+		}
+		return sum;
+	};
+
+	BENCHMARK("Insert and remove")
+	{
+		C4ValueHash churn;
+		for (C4ValueInt i{0}; i < EntryCount; ++i)
+		{
+			churn[C4VInt(i)] = C4VInt(i);
+			if (i >= 16) churn[C4VInt(i - 16)].Set0();
+		}
+		return churn.size();
+	};
+
+	BENCHMARK("Insert and look up string keys")
+	{
+		C4ValueHash strings;
+		for (const C4Value &name : names)
+		{
+			strings[name] = C4VInt(1);
+		}
+		C4ValueInt sum{0};
+		for (const C4Value &name : names)
+		{
+			sum += std::as_const(strings)[name]._getInt();
+		}
+		return sum;
+	};
+}
+
+TEST_CASE("List-ordered hash performance", "[C4ValueHash][benchmark]")
+{
+	std::vector<C4Value> names;
+	for (C4ValueInt i{0}; i < EntryCount; ++i)
+	{
+		names.push_back(C4VString(("Key" + std::to_string(i)).c_str()));
+	}
+
+	// the same workloads as above on the previous layout
+	BENCHMARK("Insert integer keys")
+	{
+		ListOrderedHash map;
+		for (C4ValueInt i{0}; i < EntryCount; ++i)
+		{
+			map[C4VInt(i)] = C4VInt(2 * i);
+		}
+		return map.size();
+	};
+
+	ListOrderedHash map;
+	for (C4ValueInt i{0}; i < EntryCount; ++i)
+	{
+		map[C4VInt(i)] = C4VInt(2 * i);
+	}
+	const ListOrderedHash &constMap{map};
+
+	BENCHMARK("Look up integer keys")
+	{
+		C4ValueInt sum{0};
+		for (C4ValueInt i{0}; i < EntryCount; ++i)
+		{
+			sum += constMap[C4VInt(i)]._getInt();
+		}
+		return sum;
+	};
+
+	BENCHMARK("Iterate")
+	{
+		C4ValueInt sum{0};
+		map.ForEach([&sum](const C4Value &, C4Value &value)
+		{
+			sum += value._getInt();
+		});
+		return sum;
+	};
+
+	BENCHMARK("Insert and remove")
+	{
+		ListOrderedHash churn;
+		for (C4ValueInt i{0}; i < EntryCount; ++i)
+		{
+			churn[C4VInt(i)] = C4VInt(i);
+			if (i >= 16) churn.erase(C4VInt(i - 16));
+		}
+		return churn.size();
+	};
+
+	BENCHMARK("Insert and look up string keys")
+	{
+		ListOrderedHash strings;
+		for (const C4Value &name : names)
+		{
+			strings[name] = C4VInt(1);
+		}
+		C4ValueInt sum{0};
+		for (const C4Value &name : names)
+		{
+			sum += std::as_const(strings)[name]._getInt();
+		}
+		return sum;
+	};
+}
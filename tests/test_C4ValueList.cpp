@@ -0,0 +1,160 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Aul.h>
+#include <C4ValueList.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace
+{
+	constexpr std::int32_t GrownSize{4 * C4ValueList::InlineSize};
+
+	// references to every element, as held by script variables
+	std::vector<C4Value> RefsTo(C4ValueList &list)
+	{
+		std::vector<C4Value> refs;
+		refs.reserve(list.GetSize());
+		for (std::int32_t i{0}; i < list.GetSize(); ++i)
+		{
+			refs.emplace_back(&list.GetItem(i));
+		}
+		return refs;
+	}
+
+	void CheckRefs(C4ValueList &list, std::vector<C4Value> &refs)
+	{
+		for (std::size_t i{0}; i < refs.size(); ++i)
+		{
+			REQUIRE(refs[i].IsRef());
+			CHECK(refs[i]._getRef() == &list.GetItem(static_cast<std::int32_t>(i)));
+			CHECK(refs[i].GetRefVal() == C4VInt(static_cast<C4ValueInt>(i)));
+		}
+
+		// writes through a reference end up in the list
+		refs.front().GetRefVal().Set(C4VInt(42));
+		CHECK(list.GetItem(0) == C4VInt(42));
+	}
+
+	// element reference as taken by the script engine for array[index]
+	void TakeElementRef(C4Value &array, const std::int32_t index, C4Value &ref)
+	{
+		C4AulContext context{};
+		C4Value indexValue{C4VInt(index)};
+		array.GetContainerElement(&indexValue, ref, &context);
+	}
+}
+
+TEST_CASE("References follow elements from inline to heap storage", "[C4ValueList]")
+{
+	C4ValueList list{C4ValueList::InlineSize};
+	for (std::int32_t i{0}; i < list.GetSize(); ++i)
+	{
+		list[i] = C4VInt(i);
+	}
+
+	// contained arrays are moved, not copied
+	const auto inner = new C4ValueArray{1};
+	C4ValueList containers{1};
+	containers[0] = C4VArray(inner);
+
+	std::vector<C4Value> refs{RefsTo(list)};
+
+	SECTION("SetSize")
+	{
+		list.SetSize(GrownSize);
+		containers.SetSize(GrownSize);
+	}
+
+	SECTION("Reserve")
+	{
+		list.Reserve(GrownSize);
+		containers.Reserve(GrownSize);
+	}
+
+	SECTION("Append")
+	{
+		for (std::int32_t i{C4ValueList::InlineSize}; i < GrownSize; ++i)
+		{
+			list.Append(C4VInt(i));
+			containers.Append(C4VInt(i));
+		}
+		CHECK(list.GetItem(GrownSize - 1) == C4VInt(GrownSize - 1));
+	}
+
+	SECTION("Append own elements")
+	{
+		list.Append(list.GetItems());
+		containers.Append(containers.GetItems());
+		REQUIRE(list.GetSize() == 2 * C4ValueList::InlineSize);
+		for (std::int32_t i{0}; i < C4ValueList::InlineSize; ++i)
+		{
+			CHECK(list.GetItem(C4ValueList::InlineSize + i) == C4VInt(i));
+		}
+		CHECK(containers.GetItem(1)._getArray() == inner);
+	}
+
+	CHECK(containers.GetItem(0)._getArray() == inner);
+	CheckRefs(list, refs);
+}
+
+TEST_CASE("Element references of copy-on-write arrays follow growth", "[C4ValueList]")
+{
+	C4Value array{C4VArray(new C4ValueArray{C4ValueList::InlineSize})};
+	for (std::int32_t i{0}; i < C4ValueList::InlineSize; ++i)
+	{
+		array._getArray()->GetItem(i) = C4VInt(i);
+	}
+	C4AulContext context{};
+
+	SECTION("Copied while referenced")
+	{
+		C4Value ref;
+		TakeElementRef(array, 1, ref);
+		REQUIRE(ref.IsRef());
+
+		// arrays with referenced elements are copied on copy
+		const C4Value copy{array};
+		REQUIRE(copy._getArray() != array._getArray());
+
+		array.SetArrayLength(GrownSize, &context);
+		CHECK(ref._getRef() == &array._getArray()->GetItem(1));
+		ref.GetRefVal().Set(C4VInt(42));
+		CHECK(array._getArray()->GetItem(1) == C4VInt(42));
+		CHECK(copy._getArray()->GetItem(1) == C4VInt(1));
+	}
+
+	SECTION("Referenced while shared")
+	{
+		const C4Value copy{array};
+		REQUIRE(copy._getArray() == array._getArray());
+
+		// taking an element reference of a shared array detaches it
+		C4Value ref;
+		TakeElementRef(array, 1, ref);
+		REQUIRE(ref.IsRef());
+		REQUIRE(copy._getArray() != array._getArray());
+
+		array.SetArrayLength(GrownSize, &context);
+		CHECK(ref._getRef() == &array._getArray()->GetItem(1));
+		ref.GetRefVal().Set(C4VInt(42));
+		CHECK(array._getArray()->GetItem(1) == C4VInt(42));
+		CHECK(copy._getArray()->GetItem(1) == C4VInt(1));
+		CHECK(copy._getArray()->GetSize() == C4ValueList::InlineSize);
+	}
+}
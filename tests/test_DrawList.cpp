@@ -0,0 +1,131 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Application.h>
+#include <C4Surface.h>
+#include <StdDDraw2.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// blits through CStdNoGfx, which records the draw list like the other engines but submits nothing
+	class NoGfxDraw
+	{
+	public:
+		NoGfxDraw()
+		{
+			// batching is opt-in
+			Config.Graphics.BatchBlits = true;
+			REQUIRE(DDrawInit(&Application, GFXENGN_NOGFX));
+			Target.AttachSfc(nullptr);
+			REQUIRE(Source1.Create(64, 64));
+			REQUIRE(Source2.Create(64, 64));
+			REQUIRE(Wide.Create(128, 64));
+		}
+
+		~NoGfxDraw()
+		{
+			Source1.Clear();
+			Source2.Clear();
+			Wide.Clear();
+			Target.Clear();
+			delete lpDDraw;
+			lpDDraw = nullptr;
+		}
+
+		NoGfxDraw(const NoGfxDraw &) = delete;
+		NoGfxDraw &operator=(const NoGfxDraw &) = delete;
+
+		C4Surface Source1, Source2, Wide, Target;
+
+		void Blit(C4Surface &source, const float x, const float y)
+		{
+			REQUIRE(lpDDraw->Blit(&source, 0.0f, 0.0f, 16.0f, 16.0f, &Target, x, y, 16.0f, 16.0f));
+		}
+
+		const CStdDrawList::Stats &Flush()
+		{
+			lpDDraw->FlushDrawList();
+			return lpDDraw->GetDrawList().GetFrameStats();
+		}
+	};
+}
+
+TEST_CASE("Blits of one texture are drawn in one batch", "[DrawList]")
+{
+	NoGfxDraw draw;
+	for (int i = 0; i < 10; ++i)
+	{
+		draw.Blit(draw.Source1, i * 20.0f, 0.0f);
+	}
+
+	const auto &stats = draw.Flush();
+	CHECK(stats.Quads == 10);
+	CHECK(stats.Batches == 1);
+	CHECK(stats.Flushes == 1);
+	CHECK(draw.Flush().Flushes == 1); // nothing left to submit
+}
+
+TEST_CASE("Separate blits of alternating textures are grouped by texture", "[DrawList]")
+{
+	NoGfxDraw draw;
+	for (int i = 0; i < 10; ++i)
+	{
+		draw.Blit(i % 2 ? draw.Source2 : draw.Source1, i * 20.0f, 0.0f);
+	}
+
+	const auto &stats = draw.Flush();
+	CHECK(stats.Quads == 10);
+	CHECK(stats.Batches == 2);
+}
+
+TEST_CASE("Overlapping blits of alternating textures keep their order", "[DrawList]")
+{
+	NoGfxDraw draw;
+	for (int i = 0; i < 10; ++i)
+	{
+		draw.Blit(i % 2 ? draw.Source2 : draw.Source1, 0.0f, 0.0f);
+	}
+
+	const auto &stats = draw.Flush();
+	CHECK(stats.Quads == 10);
+	CHECK(stats.Batches == 10);
+}
+
+TEST_CASE("Blits spanning several textures record a quad per texture", "[DrawList]")
+{
+	NoGfxDraw draw;
+	REQUIRE(lpDDraw->Blit(&draw.Wide, 0.0f, 0.0f, 128.0f, 64.0f, &draw.Target, 0.0f, 0.0f, 128.0f, 64.0f));
+
+	const auto &stats = draw.Flush();
+	CHECK(stats.Quads == 2);
+	CHECK(stats.Batches == 2);
+}
+
+TEST_CASE("Page flips publish the frame stats", "[DrawList]")
+{
+	NoGfxDraw draw;
+	draw.Blit(draw.Source1, 0.0f, 0.0f);
+	draw.Blit(draw.Source1, 20.0f, 0.0f);
+	lpDDraw->PageFlip();
+
+	const auto &drawList = lpDDraw->GetDrawList();
+	CHECK(drawList.GetLastFrameStats().Quads == 2);
+	CHECK(drawList.GetLastFrameStats().Batches == 1);
+	CHECK(drawList.GetLastFrameStats().Flushes == 1);
+	CHECK(drawList.GetFrameStats().Quads == 0);
+}
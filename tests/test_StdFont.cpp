@@ -0,0 +1,210 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Application.h>
+#include <C4GuiListBox.h>
+#include <C4Surface.h>
+#include <StdDDraw2.h>
+#include <StdFont.h>
+#include <StdMarkup.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr int GlyphWdt{7};
+	constexpr int GlyphHgt{10};
+	constexpr int GlyphsPerRow{16};
+
+	// prerendered font of blank glyphs between delimiter lines, drawn through CStdNoGfx
+	class FontDraw
+	{
+	public:
+		FontDraw()
+		{
+			// batching is opt-in
+			Config.Graphics.BatchBlits = true;
+			REQUIRE(DDrawInit(&Application, GFXENGN_NOGFX));
+			Target.AttachSfc(nullptr);
+
+			C4Surface glyphs;
+			REQUIRE(glyphs.Create(GlyphsPerRow * (GlyphWdt + 1), 256));
+			REQUIRE(glyphs.Lock());
+			for (int y = 0; y < glyphs.Hgt; ++y)
+			{
+				for (int x = 0; x < glyphs.Wdt; ++x)
+				{
+					const bool delimiter{x % (GlyphWdt + 1) == GlyphWdt || y % (GlyphHgt + 1) == GlyphHgt};
+					glyphs.SetPixDw(x, y, delimiter ? 0xff0000 : 0xff000000);
+				}
+			}
+			// the font takes the locked surface
+			Font.Init("TestFont", &glyphs, 0);
+		}
+
+		~FontDraw()
+		{
+			Font.Clear();
+			Target.Clear();
+			delete lpDDraw;
+			lpDDraw = nullptr;
+		}
+
+		FontDraw(const FontDraw &) = delete;
+		FontDraw &operator=(const FontDraw &) = delete;
+
+		CStdFont Font;
+		C4Surface Target;
+
+		std::size_t Draw(const char *text, const uint32_t flags = 0)
+		{
+			CMarkup markup{true};
+			Font.DrawText(&Target, 10, 10, 0xffffffff, text, flags, markup, 1.0f);
+			lpDDraw->FlushDrawList();
+			const std::size_t quads{lpDDraw->GetDrawList().GetFrameStats().Quads};
+			lpDDraw->PageFlip();
+			return quads;
+		}
+	};
+
+	// list box drawn without a screen, which only draws with loaded GUI resources
+	class ListBox : public C4GUI::ListBox
+	{
+	public:
+		ListBox(const C4Rect &bounds) : C4GUI::ListBox{bounds}
+		{
+			// the scroll bar needs the GUI graphics
+			pClientWindow->SetScrollBarEnabled(false);
+		}
+
+		using C4GUI::ListBox::Draw;
+	};
+
+	std::vector<std::string> Labels(const std::size_t count)
+	{
+		std::vector<std::string> labels;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			labels.push_back("Label number " + std::to_string(i));
+		}
+		return labels;
+	}
+}
+
+TEST_CASE("Cached text extents match the measured ones", "[StdFont]")
+{
+	FontDraw draw;
+	int32_t wdt, hgt;
+	REQUIRE(draw.Font.GetTextExtent("Hello", wdt, hgt));
+	CHECK(wdt == 5 * GlyphWdt);
+	CHECK(hgt == GlyphHgt);
+	// second lookup is served from the cache
+	REQUIRE(draw.Font.GetTextExtent("Hello", wdt, hgt));
+	CHECK(wdt == 5 * GlyphWdt);
+	CHECK(hgt == GlyphHgt);
+	// markup tags take no space
+	REQUIRE(draw.Font.GetTextExtent("<i>Hello</i>", wdt, hgt));
+	CHECK(wdt == 5 * GlyphWdt);
+	REQUIRE(draw.Font.GetTextExtent("<i>Hello</i>", wdt, hgt, false));
+	CHECK(wdt == 12 * GlyphWdt);
+}
+
+TEST_CASE("Cached and per-character text drawing blit the same glyphs", "[StdFont]")
+{
+	FontDraw draw;
+	CHECK(draw.Draw("Hello") == 5);
+	CHECK(draw.Draw("Hello") == 5);
+	CHECK(draw.Draw("Hello", STDFONT_CENTERED) == 5);
+	// tags are applied per character
+	CHECK(draw.Draw("<i>Hello</i>") == 5);
+	CHECK(draw.Draw("<i>Hello</i>", STDFONT_NOMARKUP) == 12);
+}
+
+TEST_CASE("StdFont text performance", "[StdFont][benchmark]")
+{
+	FontDraw draw;
+	// labels of a crowded screen, drawn every frame
+	const std::vector<std::string> labels{Labels(100)};
+	// twice as many labels as cache entries, cycled through so that every lookup misses
+	const std::vector<std::string> uncachedLabels{Labels(2048)};
+	std::size_t next{0};
+	const auto nextUncached = [&]() -> const char *
+	{
+		next = (next + 1) % uncachedLabels.size();
+		return uncachedLabels[next].c_str();
+	};
+
+	BENCHMARK("Measure repeated labels")
+	{
+		int32_t sum{0}, wdt, hgt;
+		for (const std::string &label : labels)
+		{
+			draw.Font.GetTextExtent(label.c_str(), wdt, hgt);
+			sum += wdt;
+		}
+		return sum;
+	};
+
+	BENCHMARK("Measure distinct labels")
+	{
+		int32_t sum{0}, wdt, hgt;
+		for (std::size_t i = 0; i < labels.size(); ++i)
+		{
+			draw.Font.GetTextExtent(nextUncached(), wdt, hgt);
+			sum += wdt;
+		}
+		return sum;
+	};
+
+	CMarkup markup{true};
+
+	BENCHMARK("Draw repeated labels")
+	{
+		for (const std::string &label : labels)
+		{
+			draw.Font.DrawText(&draw.Target, 10, 10, 0xffffffff, label.c_str(), 0, markup, 1.0f);
+		}
+		lpDDraw->PageFlip();
+	};
+
+	BENCHMARK("Draw distinct labels")
+	{
+		for (std::size_t i = 0; i < labels.size(); ++i)
+		{
+			draw.Font.DrawText(&draw.Target, 10, 10, 0xffffffff, nextUncached(), 0, markup, 1.0f);
+		}
+		lpDDraw->PageFlip();
+	};
+
+	// a crowded list box, as in the player or definition selection
+	ListBox list{C4Rect{0, 0, 300, 400}};
+	for (const std::string &label : Labels(500))
+	{
+		list.AddElement(new C4GUI::Label{label, 0, 0, ALeft, 0xffffffff, &draw.Font, false});
+	}
+	C4FacetEx cgo;
+	cgo.Set(&draw.Target, 0, 0, 640, 480);
+
+	BENCHMARK("Draw list box of 500 labels")
+	{
+		list.Draw(cgo);
+		lpDDraw->PageFlip();
+	};
+}